@@ -0,0 +1,21 @@
+// Runs tiger::benchLogging on the host. "-v" also prints every benchmark's histogram.
+// The host is much faster than the brain, so compare these numbers with earlier host runs, not with the brain's.
+#include <chrono>
+#include <cstring>
+#include "tiger/bench/bench.hpp"
+
+/**
+ * @brief The host's monotonic clock, in nanoseconds
+ */
+static uint64_t steadyClock() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+int main(int argc, char** argv) {
+    tiger::BenchSettings settings;
+    settings.samples = 10000;
+    for (int i = 1; i < argc; i++)
+        if (std::strcmp(argv[i], "-v") == 0) settings.histograms = true;
+    tiger::benchLogging(steadyClock, settings);
+}
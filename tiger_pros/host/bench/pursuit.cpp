@@ -0,0 +1,106 @@
+// Compares the full scan pure pursuit search with tiger::PathCursor on long paths.
+// For every path length, a simulated robot drives along a wavy path, slightly off of it, and the closest point and
+// lookahead point are found every cycle the way tiger::Chassis::follow used to, and with the cursor.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "tiger/motion/path.hpp"
+#include "tiger/motion/pursuit.hpp"
+
+// distance between path points, about what jerryio generates
+static constexpr float SPACING = 0.5;
+static constexpr float LOOKAHEAD = 15;
+// distance the robot moves each cycle, 50 in/s at 10ms
+static constexpr float STEP = 0.5;
+
+/**
+ * @brief build a binary path the same way path2bin.py does
+ */
+static std::vector<uint8_t> makePath(size_t count, bool arcLength) {
+    const uint16_t pointSize = sizeof(tiger::PathPoint) + (arcLength ? sizeof(tiger::PathPointExtra) : 0);
+    std::vector<uint8_t> data(sizeof(tiger::PathHeader) + count * pointSize);
+    const tiger::PathHeader header {tiger::PATH_MAGIC, tiger::PATH_VERSION, pointSize, uint32_t(count), 0};
+    std::memcpy(data.data(), &header, sizeof(header));
+    float distance = 0;
+    float lastX = 0;
+    float lastY = 0;
+    for (size_t i = 0; i < count; i++) {
+        const float y = i * SPACING;
+        const float x = 24 * std::sin(y / 40);
+        if (i > 0) distance += std::hypot(x - lastX, y - lastY);
+        lastX = x;
+        lastY = y;
+        const tiger::PathPoint point {x, y, i + 1 == count ? 0.0f : 100.0f, 0};
+        uint8_t* out = data.data() + sizeof(header) + i * pointSize;
+        std::memcpy(out, &point, sizeof(point));
+        if (arcLength) std::memcpy(out + sizeof(point), &distance, sizeof(distance));
+    }
+    return data;
+}
+
+/**
+ * @brief where the simulated robot is on a given cycle. Beside the path and wobbling, like a real robot
+ */
+static lemlib::Pose robotPose(const tiger::PathView& path, size_t cycle) {
+    const float index = cycle * STEP / SPACING;
+    const size_t i = std::min(size_t(index), path.size() - 2);
+    const lemlib::Pose pose = path.getPose(i).lerp(path.getPose(i + 1), index - i);
+    return lemlib::Pose(pose.x + 2 * std::sin(cycle * 0.05f), pose.y, 0);
+}
+
+struct Result {
+        double nsPerCycle;
+        size_t checksum;
+};
+
+static Result runFullScan(const tiger::PathView& path, size_t cycles) {
+    size_t checksum = 0;
+    lemlib::Pose lastLookahead = path.getPose(0);
+    lastLookahead.theta = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t cycle = 0; cycle < cycles; cycle++) {
+        const lemlib::Pose pose = robotPose(path, cycle);
+        const size_t closest = tiger::findClosest(pose, path);
+        lastLookahead = tiger::findLookahead(lastLookahead, pose, path, closest, LOOKAHEAD);
+        checksum += closest + size_t(lastLookahead.theta);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return {std::chrono::duration<double, std::nano>(end - start).count() / cycles, checksum};
+}
+
+static Result runCursor(const tiger::PathView& path, size_t cycles) {
+    size_t checksum = 0;
+    tiger::PathCursor cursor(path, LOOKAHEAD);
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t cycle = 0; cycle < cycles; cycle++) {
+        const lemlib::Pose pose = robotPose(path, cycle);
+        const size_t closest = cursor.findClosest(pose);
+        checksum += closest + size_t(cursor.findLookahead(pose).theta);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return {std::chrono::duration<double, std::nano>(end - start).count() / cycles, checksum};
+}
+
+int main() {
+    std::printf("%8s %16s %16s %16s %10s\n", "points", "full scan ns", "cursor ns", "cursor+arc ns", "speedup");
+    for (size_t count : {100, 1000, 10000}) {
+        const std::vector<uint8_t> plain = makePath(count, false);
+        const std::vector<uint8_t> indexed = makePath(count, true);
+        const asset plainAsset {const_cast<uint8_t*>(plain.data()), plain.size()};
+        const asset indexedAsset {const_cast<uint8_t*>(indexed.data()), indexed.size()};
+        const tiger::PathView plainPath(plainAsset);
+        const tiger::PathView indexedPath(indexedAsset);
+
+        // drive the whole path once
+        const size_t cycles = size_t((count - 1) * SPACING / STEP);
+        const Result fullScan = runFullScan(plainPath, cycles);
+        const Result cursor = runCursor(plainPath, cycles);
+        const Result arc = runCursor(indexedPath, cycles);
+        std::printf("%8zu %16.0f %16.0f %16.0f %9.1fx\n", count, fullScan.nsPerCycle, cursor.nsPerCycle,
+                    arc.nsPerCycle, fullScan.nsPerCycle / arc.nsPerCycle);
+        if (cursor.checksum != fullScan.checksum || arc.checksum != fullScan.checksum)
+            std::printf("%8s results differ from the full scan\n", "");
+    }
+}
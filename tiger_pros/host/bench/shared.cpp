@@ -0,0 +1,96 @@
+// Stress tests tiger::SeqLockVar and tiger::LatestVar with a writer and several readers on threads of their own, then
+// runs tiger::benchSharedState. Exits with 1 if a reader ever saw a torn or out of order value. "-v" also prints
+// every benchmark's histogram.
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "tiger/bench/bench.hpp"
+#include "tiger/task/shared.hpp"
+
+// how long each stress test runs
+static constexpr std::chrono::milliseconds STRESS_TIME {500};
+// reader threads per stress test
+static constexpr int READERS = 3;
+
+/**
+ * @brief A value that's only consistent if every field was written by the same store
+ */
+struct Stamped {
+        std::array<uint32_t, 12> fields;
+};
+
+/**
+ * @brief The host's monotonic clock, in nanoseconds
+ */
+static uint64_t steadyClock() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Store an increasing stamp from one thread while others load and check it
+ *
+ * @return bool whether every load was a whole value, never older than one loaded before it
+ */
+template <typename Var> static bool stress(const char* name, Var& var) {
+    std::atomic<bool> done = false;
+    std::atomic<uint64_t> loads = 0;
+    std::atomic<uint64_t> torn = 0;
+    std::atomic<uint64_t> backwards = 0;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < READERS; i++) {
+        readers.emplace_back([&] {
+            uint32_t last = 0;
+            uint64_t count = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                const Stamped value = var.load();
+                count++;
+                for (uint32_t field : value.fields) {
+                    if (field != value.fields[0]) {
+                        torn++;
+                        break;
+                    }
+                }
+                if (value.fields[0] < last) backwards++;
+                last = value.fields[0];
+            }
+            loads += count;
+        });
+    }
+
+    uint32_t stores = 0;
+    const auto end = std::chrono::steady_clock::now() + STRESS_TIME;
+    while (std::chrono::steady_clock::now() < end) {
+        Stamped value;
+        value.fields.fill(++stores);
+        var.store(value);
+    }
+    done = true;
+    for (std::thread& reader : readers) reader.join();
+
+    const bool passed = torn == 0 && backwards == 0;
+    std::printf("%-24s %10lu stores %10lu loads %6lu torn %6lu out of order  %s\n", name, (unsigned long)stores,
+                (unsigned long)loads.load(), (unsigned long)torn.load(), (unsigned long)backwards.load(),
+                passed ? "ok" : "FAILED");
+    return passed;
+}
+
+int main(int argc, char** argv) {
+    tiger::BenchSettings settings;
+    settings.samples = 10000;
+    for (int i = 1; i < argc; i++)
+        if (std::strcmp(argv[i], "-v") == 0) settings.histograms = true;
+
+    tiger::SeqLockVar<Stamped> seqLock;
+    tiger::LatestVar<Stamped, READERS> latest;
+    bool passed = stress("SeqLockVar", seqLock);
+    passed = stress("LatestVar", latest) && passed;
+    std::printf("\n");
+
+    tiger::benchSharedState(steadyClock, settings);
+    return passed ? 0 : 1;
+}
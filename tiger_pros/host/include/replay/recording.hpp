@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tiger::replay {
+/**
+ * @brief A tiger::Recorder recording, read into memory
+ *
+ * Blocks cut short by the robot turning off, and everything after a corrupt block, are left out.
+ */
+class Recording {
+    public:
+        /**
+         * @brief Read a recording
+         *
+         * @param path the .rec file, copied off the SD card
+         * @param error set to what went wrong, if it couldn't be read
+         * @return whether it was read
+         */
+        bool load(const std::string& path, std::string& error);
+        /**
+         * @brief Get the index of a column
+         *
+         * @return int the index, or -1 if there's no such column
+         */
+        int find(const std::string& name) const;
+        /**
+         * @brief Get the number of samples
+         */
+        size_t size() const { return times.size(); }
+        /**
+         * @brief Get the time of a sample, in milliseconds since the program started
+         */
+        uint32_t time(size_t row) const { return times[row]; }
+        /**
+         * @brief Get a value of a sample
+         *
+         * @param row the sample
+         * @param column the column's index, from find()
+         */
+        float value(size_t row, int column) const { return values[row * names.size() + column]; }
+        /**
+         * @brief Get the names of the columns
+         */
+        const std::vector<std::string>& getNames() const { return names; }
+        /**
+         * @brief Get the milliseconds between samples the recording was made with
+         */
+        uint32_t getPeriod() const { return period; }
+        /**
+         * @brief Get how many samples the brain dropped because the SD card fell behind
+         */
+        uint32_t getDropped() const { return dropped; }
+    private:
+        std::vector<std::string> names;
+        std::vector<uint32_t> times;
+        /** a row of every column per sample */
+        std::vector<float> values;
+        uint32_t period = 0;
+        uint32_t dropped = 0;
+};
+} // namespace tiger::replay
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+
+namespace tiger::sim {
+/**
+ * @brief Tell the simulation a tracking wheel measures sideways movement
+ *
+ * A rotation sensor's tracking wheel is vertical unless it's passed to lemlib::OdomSensors as a horizontal wheel,
+ * which the lemlib::TrackingWheel constructor can't know yet. Does nothing for wheels that aren't rotation sensors.
+ */
+void setHorizontal(lemlib::TrackingWheel* wheel);
+/**
+ * @brief Get the chassis the program created last, or nullptr if it didn't create one
+ *
+ * Robot programs keep their chassis in a global, so it lives as long as the simulation.
+ */
+lemlib::Chassis* getChassis();
+} // namespace tiger::sim
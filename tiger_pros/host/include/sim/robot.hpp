@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace tiger::sim {
+/**
+ * @brief Run the robot program's initialize() and competition_initialize(), like a robot plugged into a field
+ *
+ * @param timeout how much simulated time they get to return, in milliseconds
+ * @return whether they returned in time
+ */
+bool runInitialize(uint32_t timeout);
+/**
+ * @brief Run a routine like the autonomous period
+ *
+ * The routine and every task it starts run in their own group, so the simulation knows when all of them are done.
+ * The world has to be stepped by the scheduler's tick hook.
+ *
+ * @param routine the routine, like the robot program's autonomous()
+ * @param duration how long it can run, in milliseconds
+ * @param name name of the routine's task
+ * @param waitForTasks false to stop as soon as the routine returns, for routines that leave a task waiting for more
+ * work, like a tiger::MotionQueue's
+ * @return whether the routine returned and every task it started finished in time
+ */
+bool runRoutine(std::function<void()> routine, uint32_t duration, const char* name, bool waitForTasks = true);
+} // namespace tiger::sim
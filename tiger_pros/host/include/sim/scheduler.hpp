@@ -0,0 +1,179 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace tiger::sim {
+/**
+ * @brief A task of the simulated RTOS
+ */
+struct Task {
+        enum class State { READY, DELAYED, BLOCKED, SUSPENDED, DELETED };
+
+        std::string name;
+        uint32_t priority;
+        void (*function)(void*);
+        void* parameters;
+        State state = State::READY;
+        /** when a delayed or blocked task wakes up, in microseconds. UINT64_MAX if it waits forever */
+        uint64_t wakeTime = 0;
+        /** the order tasks became ready in, so tasks with the same priority take turns */
+        uint64_t readyOrder = 0;
+        /** the mutex the task is blocked on, if any */
+        struct Mutex* mutex = nullptr;
+        /** whether the task is blocked waiting for a notification */
+        bool waitingForNotify = false;
+        /** whether the last blocking call ran out of time */
+        bool timedOut = false;
+        uint32_t notifyValue = 0;
+        bool notifyPending = false;
+        /** tasks inherit the group of the task that created them, see Scheduler::setGroup() */
+        int group = 0;
+        std::condition_variable resume;
+};
+
+/**
+ * @brief A mutex of the simulated RTOS
+ */
+struct Mutex {
+        bool recursive = false;
+        /** how many times the owner has taken the mutex, 0 if it is free */
+        uint32_t count = 0;
+        /** nullptr while free, or if it was taken outside of a task, like during static initialization */
+        Task* owner = nullptr;
+};
+
+/**
+ * @brief A deterministic, single core scheduler that runs in virtual time
+ *
+ * Every task gets its own thread, but only one of them runs at a time, like on the brain. A task runs until it
+ * blocks, by delaying, waiting for a mutex or waiting for a notification, and then the highest priority task that is
+ * ready runs next. Tasks with the same priority take turns. When every task is blocked, the clock jumps to the next
+ * time one of them wakes up, calling the tick hook once for every millisecond it skips. Code takes no time to run, so
+ * a simulation produces the same result every time and runs as fast as the host can go.
+ *
+ * The PROS RTOS functions in src/pros/rtos.cpp are implemented on top of this.
+ */
+class Scheduler {
+    public:
+        /**
+         * @brief Create a task. It starts running the next time the scheduler picks it
+         *
+         * @param function the function to run
+         * @param parameters passed to the function
+         * @param priority from TASK_PRIORITY_MIN to TASK_PRIORITY_MAX
+         * @param name the name of the task
+         * @return Task*
+         */
+        Task* create(void (*function)(void*), void* parameters, uint32_t priority, const char* name);
+        /**
+         * @brief Delete a task. If it is the current task, this doesn't return
+         */
+        void remove(Task* task);
+        /**
+         * @brief Get the task that is running, or nullptr outside of a task
+         */
+        Task* current();
+        /**
+         * @brief Get the virtual time, in microseconds since the simulation started
+         */
+        uint64_t now();
+        /**
+         * @brief Block the current task until a point in time
+         *
+         * @param time microseconds since the simulation started. The task still lets other tasks run if the time has
+         * already passed, like pros::delay(0) does
+         */
+        void sleepUntil(uint64_t time);
+        /**
+         * @brief Take a mutex, blocking for up to timeout milliseconds
+         */
+        bool take(Mutex* mutex, uint32_t timeout);
+        /**
+         * @brief Give a mutex back. The highest priority task waiting for it gets it next
+         */
+        bool give(Mutex* mutex);
+        /**
+         * @brief Notify a task, with the semantics of pros::c::task_notify_ext
+         */
+        uint32_t notify(Task* task, uint32_t value, int action, uint32_t* previous);
+        /**
+         * @brief Wait for a notification, with the semantics of pros::c::task_notify_take
+         */
+        uint32_t notifyTake(bool clear, uint32_t timeout);
+        /**
+         * @brief Clear a task's pending notification
+         *
+         * @return whether a notification was pending
+         */
+        bool notifyClear(Task* task);
+        void suspend(Task* task);
+        void resume(Task* task);
+        void setPriority(Task* task, uint32_t priority);
+        /**
+         * @brief Block until a task has been deleted or returns
+         */
+        void join(Task* task);
+        uint32_t getTaskCount();
+        Task* find(const char* name);
+        /**
+         * @brief Set the group of the tasks the simulation creates from now on
+         *
+         * Tasks created by tasks inherit the group of their creator, so the simulation can tell when everything
+         * autonomous started has finished.
+         */
+        void setGroup(int group);
+        /**
+         * @brief Check if any task of a group hasn't finished yet
+         */
+        bool isRunning(int group);
+        /**
+         * @brief Set the function to call for every millisecond of virtual time
+         *
+         * @param hook called with the virtual time, in microseconds, after it advances
+         */
+        void setTickHook(std::function<void(uint64_t)> hook);
+        /**
+         * @brief Slow the simulation down to a multiple of real time. 0 runs it as fast as possible
+         */
+        void setRealTimeFactor(double factor);
+        /**
+         * @brief Run tasks until a condition is met
+         *
+         * @param done checked whenever the scheduler is about to pick a task
+         * @param endTime stop once the virtual time reaches this, in microseconds
+         * @return true if the condition was met, false if time ran out or every task is blocked forever
+         */
+        bool run(std::function<bool()> done, uint64_t endTime);
+    private:
+        /**
+         * @brief Stop running the current task and wait until the scheduler picks it again
+         */
+        void yield(std::unique_lock<std::mutex>& lock, Task* task);
+        void makeReady(Task* task);
+        Task* pick();
+        /**
+         * @brief Move the clock forwards to a time, one millisecond at a time
+         */
+        void advance(std::unique_lock<std::mutex>& lock, uint64_t time);
+
+        std::mutex lock;
+        std::condition_variable idle;
+        std::vector<Task*> tasks;
+        Task* running = nullptr;
+        uint64_t time = 0;
+        uint64_t readyCounter = 0;
+        int group = 0;
+        std::function<void(uint64_t)> tickHook;
+        double realTimeFactor = 0;
+};
+
+/**
+ * @brief Get the scheduler of the simulation
+ */
+Scheduler& scheduler();
+} // namespace tiger::sim
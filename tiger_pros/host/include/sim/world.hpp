@@ -0,0 +1,254 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "pros/motors.h"
+#include "lemlib/pose.hpp"
+
+namespace tiger::sim {
+/**
+ * @brief The simulated state of a V5 smart motor
+ *
+ * Everything is in the motor's own direction. The sign of the port a program uses only decides which way the PROS
+ * functions read and command it.
+ */
+struct MotorState {
+        enum class Mode { VOLTAGE, VELOCITY, POSITION, BRAKE };
+
+        pros::motor_gearset_e_t gearset = pros::E_MOTOR_GEARSET_18;
+        pros::motor_encoder_units_e_t units = pros::E_MOTOR_ENCODER_DEGREES;
+        pros::motor_brake_mode_e_t brakeMode = pros::E_MOTOR_BRAKE_COAST;
+        Mode mode = Mode::VOLTAGE;
+        /** millivolts, rpm or rotations, depending on the mode */
+        double target = 0;
+        /** the velocity cap of position moves, in rpm */
+        double maxVelocity = 0;
+        /** where the motor holds itself in the hold brake mode, in rotations */
+        double holdPosition = 0;
+        /** millivolts, 0 for no limit */
+        int32_t voltageLimit = 0;
+        /** milliamps */
+        int32_t currentLimit = 2500;
+        /** position of the output shaft in rotations, not counting the zero position */
+        double position = 0;
+        /** what get_position() reads as 0, in rotations */
+        double zero = 0;
+        /** rpm of the output shaft */
+        double velocity = 0;
+        /** applied volts */
+        double voltage = 0;
+        /** newton meters at the output shaft */
+        double torque = 0;
+        /** whether the motor drives the robot, instead of spinning freely */
+        bool drivetrain = false;
+
+        /**
+         * @brief Free speed of the cartridge at 12V, in rpm
+         */
+        double getFreeSpeed() const;
+        /**
+         * @brief Stall torque of the cartridge at the default current limit, in newton meters
+         */
+        double getStallTorque() const;
+        /**
+         * @brief Encoder ticks in one rotation of the output shaft
+         */
+        double getTicksPerRotation() const;
+        /**
+         * @brief Convert a position in rotations to the motor's encoder units
+         */
+        double toUnits(double rotations) const;
+        /**
+         * @brief Convert a position in the motor's encoder units to rotations
+         */
+        double fromUnits(double units) const;
+};
+
+/**
+ * @brief A tracking wheel measured by a rotation sensor
+ */
+struct TrackingWheelGeometry {
+        float diameter = 0;
+        /** LemLib's offset from the tracking center, in inches */
+        float offset = 0;
+        float gearRatio = 1;
+        /** vertical wheels measure forwards movement, horizontal ones sideways movement */
+        bool vertical = true;
+};
+
+/**
+ * @brief Physical properties of the simulated robot
+ *
+ * The drivetrain's geometry comes from the lemlib::Drivetrain the program creates. The defaults are a typical 15 lb
+ * competition robot.
+ */
+struct RobotSettings {
+        /** kilograms */
+        double mass = 6.8;
+        /** kilogram square meters around the tracking center. 0 for a uniform 18" square */
+        double inertia = 0;
+        /** friction coefficient between the wheels and the tiles, which caps how hard the robot can accelerate */
+        double traction = 0.9;
+        /** rolling resistance, as a fraction of the robot's weight */
+        double rollingResistance = 0.03;
+        /** friction torque of the wheels scrubbing sideways when turning, in newton meters */
+        double turnScrub = 1.5;
+        /** how long the IMU takes to calibrate, in milliseconds */
+        uint32_t imuCalibrationTime = 2000;
+};
+
+/**
+ * @brief The physics of the simulated robot and the devices plugged into it
+ *
+ * The robot is a differential drive on rigid, non-slipping wheels: every drivetrain motor pushes on its side of the
+ * robot through the drivetrain's gear ratio, and the robot's forward and angular accelerations come from the sum of
+ * those forces. A motor's torque falls linearly from its stall torque at 0 rpm to 0 at its free speed, scaled by its
+ * voltage, which is what gives real drivetrains their acceleration curve and top speed. Motors that aren't part of the
+ * drivetrain spin a small load.
+ *
+ * Positions are in LemLib's convention: inches, and radians clockwise from the +y axis.
+ */
+class World {
+    public:
+        /**
+         * @brief Get the state of the motor on a port, from 1 to 21
+         */
+        MotorState& motor(uint8_t port);
+        /**
+         * @brief Set which motors drive the robot, and how
+         *
+         * @param left the ports of the left side. Negative ports are reversed, so positive voltage drives forwards
+         * @param right the ports of the right side
+         * @param trackWidth inches
+         * @param wheelDiameter inches
+         * @param rpm rpm of the wheels at the cartridge's free speed
+         */
+        void setDrivetrain(const std::vector<int8_t>& left, const std::vector<int8_t>& right, float trackWidth,
+                           float wheelDiameter, float rpm);
+        /**
+         * @brief Set how a rotation sensor is mounted as a tracking wheel
+         */
+        void setTrackingWheel(uint8_t port, TrackingWheelGeometry geometry);
+        /**
+         * @brief Get the position of a rotation sensor, in centidegrees, before reversing and resetting
+         */
+        double getRotation(uint8_t port);
+        /**
+         * @brief Get the velocity of a rotation sensor, in centidegrees per second
+         */
+        double getRotationVelocity(uint8_t port);
+        /**
+         * @brief Get the heading of the robot as the IMU measures it, in degrees clockwise, without wrapping
+         */
+        double getImuRotation() const;
+        /**
+         * @brief Get the angular velocity of the robot, in degrees per second clockwise
+         */
+        double getImuRate() const;
+        /**
+         * @brief Get the acceleration of the robot, in g
+         *
+         * @param forward set to the forwards acceleration
+         * @param right set to the acceleration to the right
+         */
+        void getImuAccel(double& forward, double& right) const;
+        /**
+         * @brief Record a change to a three wire port, like a piston firing
+         *
+         * @param smartPort the smart port of the expander, or INTERNAL_ADI_PORT for the brain's own ports
+         * @param adiPort the three wire port, from 1 to 8
+         * @param value the value written to the port
+         */
+        void setAdi(uint8_t smartPort, uint8_t adiPort, int32_t value);
+        int32_t getAdi(uint8_t smartPort, uint8_t adiPort);
+        /**
+         * @brief Move the robot, if it hasn't driven anywhere yet
+         *
+         * Autonomous routines usually start by telling odometry where the robot starts on the field, so the first
+         * setPose() before the robot moves places the simulated robot there too. That keeps the simulated pose and
+         * the odometry pose in the same frame.
+         */
+        void place(lemlib::Pose pose);
+        /**
+         * @brief Get the robot's actual pose
+         */
+        lemlib::Pose getPose() const;
+        /**
+         * @brief Get the speed of each side of the drivetrain, in inches per second
+         */
+        void getSideSpeeds(double& left, double& right) const;
+        /**
+         * @brief Get the average voltage of each side of the drivetrain
+         */
+        void getSideVoltages(double& left, double& right);
+        /**
+         * @brief Set a function to call when a three wire port changes
+         */
+        void setAdiHook(std::function<void(uint8_t smartPort, uint8_t adiPort, int32_t value)> hook);
+        /**
+         * @brief Simulate a step of time
+         *
+         * @param dt seconds
+         */
+        void step(double dt);
+
+        RobotSettings settings;
+    private:
+        /**
+         * @brief Torque of a motor at its current velocity
+         *
+         * @param motor the motor, updated with its voltage and torque
+         * @return newton meters at the output shaft
+         */
+        double getTorque(MotorState& motor);
+        /**
+         * @brief Get the force a drivetrain side pushes the robot with, in newtons
+         */
+        double getSideForce(const std::vector<int8_t>& ports);
+        /**
+         * @brief Turn the drivetrain motors at the speed of their side of the robot
+         *
+         * @param ports the ports of the side
+         * @param speed meters per second
+         * @param dt seconds
+         */
+        void moveSide(const std::vector<int8_t>& ports, double speed, double dt);
+
+        MotorState motors[21];
+        std::vector<int8_t> leftPorts;
+        std::vector<int8_t> rightPorts;
+        /** meters */
+        double trackWidth = 0.3;
+        double wheelRadius = 0.041;
+        /** rpm of the wheels at the cartridge's free speed */
+        double rpm = 200;
+        std::map<uint8_t, TrackingWheelGeometry> trackingWheels;
+        /** inches each rotation sensor's wheel has rolled */
+        std::map<uint8_t, double> wheelTravel;
+        std::map<uint8_t, double> wheelSpeed;
+        /** values of the three wire ports, by smart port and three wire port */
+        std::map<std::pair<uint8_t, uint8_t>, int32_t> adi;
+        std::function<void(uint8_t, uint8_t, int32_t)> adiHook;
+        /** inches, and radians clockwise without wrapping */
+        double x = 0;
+        double y = 0;
+        double theta = 0;
+        /** meters per second forwards, and radians per second clockwise */
+        double velocity = 0;
+        double angularVelocity = 0;
+        /** meters per second squared, for the IMU */
+        double acceleration = 0;
+        /** radians clockwise the IMU has turned. Unlike theta, place() doesn't change it */
+        double imuAngle = 0;
+        bool moved = false;
+};
+
+/**
+ * @brief Get the world of the simulation
+ */
+World& world();
+} // namespace tiger::sim
@@ -0,0 +1,219 @@
+// Host copy of LemLib's chassis.cpp. The drivetrain and horizontal tracking wheels are also handed to the simulation
+#include <cmath>
+#include "pros/misc.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/util.hpp"
+#include "sim/lemlib.hpp"
+#include "sim/world.hpp"
+
+lemlib::ExpoDriveCurve lemlib::defaultDriveCurve(0, 0, 1);
+
+/**
+ * @brief The chassis the program created last
+ */
+static lemlib::Chassis*& lastChassis() {
+    static lemlib::Chassis* chassis = nullptr;
+    return chassis;
+}
+
+lemlib::Chassis* tiger::sim::getChassis() { return lastChassis(); }
+
+lemlib::OdomSensors::OdomSensors(TrackingWheel* vertical1, TrackingWheel* vertical2, TrackingWheel* horizontal1,
+                                 TrackingWheel* horizontal2, pros::Imu* imu)
+    : vertical1(vertical1),
+      vertical2(vertical2),
+      horizontal1(horizontal1),
+      horizontal2(horizontal2),
+      imu(imu) {
+    if (horizontal1 != nullptr) tiger::sim::setHorizontal(horizontal1);
+    if (horizontal2 != nullptr) tiger::sim::setHorizontal(horizontal2);
+}
+
+lemlib::Drivetrain::Drivetrain(pros::MotorGroup* leftMotors, pros::MotorGroup* rightMotors, float trackWidth,
+                               float wheelDiameter, float rpm, float horizontalDrift)
+    : leftMotors(leftMotors),
+      rightMotors(rightMotors),
+      trackWidth(trackWidth),
+      wheelDiameter(wheelDiameter),
+      rpm(rpm),
+      horizontalDrift(horizontalDrift) {
+    if (leftMotors == nullptr || rightMotors == nullptr) return;
+    std::vector<int8_t> left = leftMotors->get_port_all();
+    std::vector<int8_t> right = rightMotors->get_port_all();
+    tiger::sim::world().setDrivetrain(left, right, trackWidth, wheelDiameter, rpm);
+}
+
+lemlib::Chassis::Chassis(Drivetrain drivetrain, ControllerSettings linearSettings, ControllerSettings angularSettings,
+                         OdomSensors sensors, DriveCurve* throttleCurve, DriveCurve* steerCurve)
+    : lateralPID(linearSettings.kP, linearSettings.kI, linearSettings.kD, linearSettings.windupRange, true),
+      angularPID(angularSettings.kP, angularSettings.kI, angularSettings.kD, angularSettings.windupRange, true),
+      lateralSettings(linearSettings),
+      angularSettings(angularSettings),
+      drivetrain(drivetrain),
+      sensors(sensors),
+      throttleCurve(throttleCurve),
+      steerCurve(steerCurve),
+      lateralLargeExit(lateralSettings.largeError, lateralSettings.largeErrorTimeout),
+      lateralSmallExit(lateralSettings.smallError, lateralSettings.smallErrorTimeout),
+      angularLargeExit(angularSettings.largeError, angularSettings.largeErrorTimeout),
+      angularSmallExit(angularSettings.smallError, angularSettings.smallErrorTimeout) {
+    lastChassis() = this;
+}
+
+void lemlib::Chassis::calibrate(bool calibrateImu) {
+    // calibrate the IMU if it exists and the user doesn't specify otherwise
+    if (sensors.imu != nullptr && calibrateImu) {
+        int attempt = 1;
+        // calibrate inertial, and if calibration fails, then repeat 5 times or until successful
+        while (attempt <= 5) {
+            sensors.imu->reset();
+            // wait until IMU is calibrated
+            do pros::delay(10);
+            while (sensors.imu->get_status() != pros::ImuStatus::error && sensors.imu->is_calibrating());
+            // exit if imu has been calibrated
+            if (!std::isnan(sensors.imu->get_heading()) && !std::isinf(sensors.imu->get_heading())) break;
+            // indicate error
+            pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, "---");
+            infoSink()->warn("IMU failed to calibrate! Attempt #{}", attempt);
+            attempt++;
+        }
+        // check if calibration attempts were successful
+        if (attempt > 5) {
+            sensors.imu = nullptr;
+            infoSink()->error("IMU calibration failed, defaulting to tracking wheels / motor encoders");
+        }
+    }
+    // initialize odom
+    if (sensors.vertical1 == nullptr)
+        sensors.vertical1 = new lemlib::TrackingWheel(drivetrain.leftMotors, drivetrain.wheelDiameter,
+                                                      -(drivetrain.trackWidth / 2), drivetrain.rpm);
+    if (sensors.vertical2 == nullptr)
+        sensors.vertical2 = new lemlib::TrackingWheel(drivetrain.rightMotors, drivetrain.wheelDiameter,
+                                                      drivetrain.trackWidth / 2, drivetrain.rpm);
+    sensors.vertical1->reset();
+    sensors.vertical2->reset();
+    if (sensors.horizontal1 != nullptr) sensors.horizontal1->reset();
+    if (sensors.horizontal2 != nullptr) sensors.horizontal2->reset();
+    setSensors(sensors, drivetrain);
+    init();
+    // rumble to controller to indicate success
+    pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, ".");
+}
+
+void lemlib::Chassis::setPose(float x, float y, float theta, bool radians) {
+    lemlib::setPose(lemlib::Pose(x, y, theta), radians);
+}
+
+void lemlib::Chassis::setPose(Pose pose, bool radians) { lemlib::setPose(pose, radians); }
+
+lemlib::Pose lemlib::Chassis::getPose(bool radians, bool standardPos) {
+    Pose pose = lemlib::getPose(true);
+    if (standardPos) pose.theta = M_PI_2 - pose.theta;
+    if (!radians) pose.theta = radToDeg(pose.theta);
+    return pose;
+}
+
+void lemlib::Chassis::resetLocalPosition() {
+    float theta = this->getPose().theta;
+    lemlib::setPose(lemlib::Pose(0, 0, theta), false);
+}
+
+void lemlib::Chassis::setBrakeMode(pros::motor_brake_mode_e mode) {
+    drivetrain.leftMotors->set_brake_mode_all(mode);
+    drivetrain.rightMotors->set_brake_mode_all(mode);
+}
+
+void lemlib::Chassis::waitUntil(float dist) {
+    // give the movement time to start
+    pros::delay(10);
+    // wait until the robot has travelled a certain distance
+    while (distTraveled < dist && distTraveled != -1) pros::delay(10);
+}
+
+void lemlib::Chassis::waitUntilDone() {
+    do pros::delay(10);
+    while (distTraveled != -1);
+}
+
+void lemlib::Chassis::requestMotionStart() {
+    if (this->isInMotion()) this->motionQueued = true; // indicate a motion is queued
+    else this->motionRunning = true; // indicate a motion is running
+
+    // wait until this motion is at front of "queue"
+    this->mutex.take(TIMEOUT_MAX);
+
+    // this->motionRunning should be true
+    // and this->motionQueued should be false
+    // indicating this motion is running
+}
+
+void lemlib::Chassis::endMotion() {
+    // move the "queue" forward 1
+    this->motionRunning = this->motionQueued;
+    this->motionQueued = false;
+
+    // permit queued motion to run
+    this->mutex.give();
+}
+
+void lemlib::Chassis::cancelMotion() {
+    this->motionRunning = false;
+    pros::delay(10); // give time for motion to stop
+}
+
+void lemlib::Chassis::cancelAllMotions() {
+    this->motionRunning = false;
+    this->motionQueued = false;
+    pros::delay(10); // give time for motion to stop
+}
+
+bool lemlib::Chassis::isInMotion() const { return this->motionRunning; }
+
+void lemlib::Chassis::tank(int left, int right, bool disableDriveCurve) {
+    if (disableDriveCurve) {
+        drivetrain.leftMotors->move(left);
+        drivetrain.rightMotors->move(right);
+    } else {
+        drivetrain.leftMotors->move(throttleCurve->curve(left));
+        drivetrain.rightMotors->move(throttleCurve->curve(right));
+    }
+}
+
+void lemlib::Chassis::arcade(int throttle, int turn, bool disableDriveCurve, float desaturateBias) {
+    if (!disableDriveCurve) {
+        throttle = throttleCurve->curve(throttle);
+        turn = steerCurve->curve(turn);
+    }
+    // desaturate motors based on joyBias
+    if (std::abs(throttle) + std::abs(turn) > 127) {
+        int oldThrottle = throttle;
+        int oldTurn = turn;
+        throttle *= (1 - desaturateBias * std::abs(oldTurn / 127.0));
+        turn *= (1 - (1 - desaturateBias) * std::abs(oldThrottle / 127.0));
+    }
+    drivetrain.leftMotors->move(throttle + turn);
+    drivetrain.rightMotors->move(throttle - turn);
+}
+
+void lemlib::Chassis::curvature(int throttle, int turn, bool disableDriveCurve) {
+    // If we're not moving forwards change to arcade drive
+    if (throttle == 0) {
+        arcade(throttle, turn, disableDriveCurve);
+        return;
+    }
+    if (!disableDriveCurve) {
+        throttle = throttleCurve->curve(throttle);
+        turn = steerCurve->curve(turn);
+    }
+    float leftPower = throttle + (std::abs(throttle) * turn) / 127.0;
+    float rightPower = throttle - (std::abs(throttle) * turn) / 127.0;
+    // ratio the speeds to respect the max speed
+    const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / 127.0;
+    if (ratio > 1) {
+        leftPower /= ratio;
+        rightPower /= ratio;
+    }
+    drivetrain.leftMotors->move(leftPower);
+    drivetrain.rightMotors->move(rightPower);
+}
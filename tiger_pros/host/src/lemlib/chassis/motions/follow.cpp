@@ -0,0 +1,234 @@
+// Host copy of LemLib's pure pursuit, which follows text paths from path.jerryio.com
+#include <cmath>
+#include <string>
+#include <vector>
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/util.hpp"
+
+/**
+ * @brief Split a string by a delimiter
+ */
+static std::vector<std::string> splitString(const std::string& input, const std::string& delimiter) {
+    std::vector<std::string> output;
+    size_t start = 0;
+    size_t end = input.find(delimiter);
+    while (end != std::string::npos) {
+        output.push_back(input.substr(start, end - start));
+        start = end + delimiter.size();
+        end = input.find(delimiter, start);
+    }
+    output.push_back(input.substr(start));
+    return output;
+}
+
+/**
+ * @brief Convert a path asset to a vector of poses, where theta is the speed
+ */
+static std::vector<lemlib::Pose> getData(const asset& path) {
+    std::vector<lemlib::Pose> robotPath;
+    // format data from the asset
+    const std::string data(reinterpret_cast<char*>(path.buf), path.size);
+    const std::vector<std::string> dataLines = splitString(data, "\n");
+
+    // loop through each line
+    for (std::string line : dataLines) {
+        lemlib::Pose pathPoint(0, 0);
+        // check if this is the last line
+        if (line == "endData" || line == "endData\r") break;
+        // split the line by commas
+        const std::vector<std::string> pointInput = splitString(line, ", ");
+        // check if the line is valid
+        if (pointInput.size() != 3) {
+            lemlib::infoSink()->error("Failed to read path file! Are you using the right format? Raw line: {}", line);
+            break;
+        }
+        pathPoint.x = std::stof(pointInput.at(0));
+        pathPoint.y = std::stof(pointInput.at(1));
+        pathPoint.theta = std::stof(pointInput.at(2)); // theta is speed
+        robotPath.push_back(pathPoint);
+    }
+
+    return robotPath;
+}
+
+/**
+ * @brief Find the index of the point on the path closest to the robot
+ */
+static int findClosest(lemlib::Pose pose, std::vector<lemlib::Pose> path) {
+    int closestPoint = 0;
+    float closestDist = INFINITY;
+
+    // loop through all path points
+    for (int i = 0; i < int(path.size()); i++) {
+        const float dist = pose.distance(path.at(i));
+        if (dist < closestDist) { // new closest point
+            closestDist = dist;
+            closestPoint = i;
+        }
+    }
+
+    return closestPoint;
+}
+
+/**
+ * @brief Find where a segment of the path intersects the lookahead circle
+ *
+ * @return float how far along the segment the intersection is, from 0 to 1, or -1 if there isn't one
+ */
+static float circleIntersect(lemlib::Pose p1, lemlib::Pose p2, lemlib::Pose pose, float lookaheadDist) {
+    // calculations
+    // uses the quadratic formula to calculate intersection points
+    lemlib::Pose d = p2 - p1;
+    lemlib::Pose f = p1 - pose;
+    float a = d * d;
+    float b = 2 * (f * d);
+    float c = (f * f) - lookaheadDist * lookaheadDist;
+    float discriminant = b * b - 4 * a * c;
+
+    // if a possible intersection was found
+    if (discriminant >= 0) {
+        discriminant = std::sqrt(discriminant);
+        float t1 = (-b - discriminant) / (2 * a);
+        float t2 = (-b + discriminant) / (2 * a);
+
+        // prioritize further down the path
+        if (t2 >= 0 && t2 <= 1) return t2;
+        else if (t1 >= 0 && t1 <= 1) return t1;
+    }
+
+    // no intersection found
+    return -1;
+}
+
+/**
+ * @brief Find the lookahead point. Its theta is the index of the path segment it's on
+ */
+static lemlib::Pose lookaheadPoint(lemlib::Pose lastLookahead, lemlib::Pose pose, std::vector<lemlib::Pose> path,
+                                   int closest, float lookaheadDist) {
+    // optimizations applied:
+    // only consider intersections that have an index greater than or equal to the point closest
+    // to the robot
+    // and intersections that have an index greater than or equal to the index of the last
+    // lookahead point
+    const int start = std::max(closest, int(lastLookahead.theta));
+    for (int i = start; i < int(path.size()) - 1; i++) {
+        lemlib::Pose lastPathPose = path.at(i);
+        lemlib::Pose currentPathPose = path.at(i + 1);
+
+        float t = circleIntersect(lastPathPose, currentPathPose, pose, lookaheadDist);
+
+        if (t != -1) {
+            lemlib::Pose lookahead = lastPathPose.lerp(currentPathPose, t);
+            lookahead.theta = i;
+            return lookahead;
+        }
+    }
+
+    // robot deviated from path, use last lookahead point
+    return lastLookahead;
+}
+
+/**
+ * @brief Get the curvature of the arc from the robot to the lookahead point
+ *
+ * @param heading the robot's heading in standard form
+ */
+static float findLookaheadCurvature(lemlib::Pose pose, float heading, lemlib::Pose lookahead) {
+    // calculate whether the robot is on the left or right side of the circle
+    float side = lemlib::sgn(std::sin(heading) * (lookahead.x - pose.x) - std::cos(heading) * (lookahead.y - pose.y));
+    // calculate center point and radius
+    float a = -std::tan(heading);
+    float c = std::tan(heading) * pose.x - pose.y;
+    float x = std::fabs(a * lookahead.x + lookahead.y + c) / std::sqrt((a * a) + 1);
+    float d = std::hypot(lookahead.x - pose.x, lookahead.y - pose.y);
+
+    // return curvature
+    return side * ((2 * x) / (d * d));
+}
+
+void lemlib::Chassis::follow(const asset& path, float lookahead, int timeout, bool forwards, bool async) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([&]() { follow(path, lookahead, timeout, forwards, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    std::vector<lemlib::Pose> pathPoints = getData(path); // get list of path points
+    if (pathPoints.size() == 0) {
+        infoSink()->error("No points in path! Do you have the right format? Skipping motion");
+        // set distTraveled to -1 to indicate that the function has finished
+        distTraveled = -1;
+        this->endMotion();
+        return;
+    }
+    Pose pose = this->getPose(true);
+    Pose lastPose = pose;
+    Pose lookaheadPose(0, 0, 0);
+    Pose lastLookahead = pathPoints.at(0);
+    lastLookahead.theta = 0;
+    float curvature;
+    float targetVel;
+    int closestPoint;
+    distTraveled = 0;
+
+    // loop until the robot is within the end tolerance
+    for (int i = 0; i < timeout / 10 && this->motionRunning; i++) {
+        // get the current position of the robot
+        pose = this->getPose(true);
+        if (!forwards) pose.theta -= M_PI;
+
+        // update completion vars
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        // find the closest point on the path to the robot
+        closestPoint = findClosest(pose, pathPoints);
+        // if the robot is at the end of the path, then stop
+        if (pathPoints.at(closestPoint).theta == 0) break;
+
+        // find the lookahead point
+        lookaheadPose = lookaheadPoint(lastLookahead, pose, pathPoints, closestPoint, lookahead);
+        lastLookahead = lookaheadPose; // update last lookahead position
+
+        // get the curvature of the arc between the robot and the lookahead point
+        float curvatureHeading = M_PI / 2 - pose.theta;
+        curvature = findLookaheadCurvature(pose, curvatureHeading, lookaheadPose);
+
+        // get the target velocity of the robot
+        targetVel = pathPoints.at(closestPoint).theta;
+
+        // calculate target left and right velocities
+        float targetLeftVel = targetVel * (2 + curvature * drivetrain.trackWidth) / 2;
+        float targetRightVel = targetVel * (2 - curvature * drivetrain.trackWidth) / 2;
+
+        // ratio the speeds to respect the max speed
+        float ratio = std::max(std::fabs(targetLeftVel), std::fabs(targetRightVel)) / 127;
+        if (ratio > 1) {
+            targetLeftVel /= ratio;
+            targetRightVel /= ratio;
+        }
+
+        // move the drivetrain
+        if (forwards) {
+            drivetrain.leftMotors->move(targetLeftVel);
+            drivetrain.rightMotors->move(targetRightVel);
+        } else {
+            drivetrain.leftMotors->move(-targetRightVel);
+            drivetrain.rightMotors->move(-targetLeftVel);
+        }
+
+        pros::delay(10);
+    }
+
+    // stop the robot
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
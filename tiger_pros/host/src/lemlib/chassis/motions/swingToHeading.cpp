@@ -0,0 +1,95 @@
+// Host copy of LemLib's swingToHeading.cpp
+#include <cmath>
+#include <optional>
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+
+void lemlib::Chassis::swingToHeading(float theta, DriveSide lockedSide, int timeout, SwingToHeadingParams params,
+                                     bool async) {
+    params.minSpeed = std::fabs(params.minSpeed);
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([&]() { swingToHeading(theta, lockedSide, timeout, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+    float deltaTheta;
+    float motorPower;
+    float prevMotorPower = 0;
+    float startTheta = getPose().theta;
+    bool settling = false;
+    std::optional<float> prevRawDeltaTheta = std::nullopt;
+    std::optional<float> prevDeltaTheta = std::nullopt;
+    distTraveled = 0;
+    Timer timer(timeout);
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    angularPID.reset();
+    // the locked side holds its position
+    pros::MotorGroup* lockedMotors = lockedSide == DriveSide::LEFT ? drivetrain.leftMotors : drivetrain.rightMotors;
+    const pros::MotorBrake brakeMode = lockedMotors->get_brake_mode();
+    lockedMotors->set_brake_mode_all(pros::E_MOTOR_BRAKE_HOLD);
+
+    // main loop
+    while (!timer.isDone() && !angularLargeExit.getExit() && !angularSmallExit.getExit() && this->motionRunning) {
+        // update variables
+        Pose pose = getPose();
+
+        // update completion vars
+        distTraveled = std::fabs(angleError(pose.theta, startTheta, false));
+
+        // calculate deltaTheta
+        const float rawDeltaTheta = angleError(theta, pose.theta, false);
+        if (prevRawDeltaTheta == std::nullopt) prevRawDeltaTheta = rawDeltaTheta;
+        // once the robot has crossed the target, it settles the shortest way, whatever the requested direction
+        if (sgn(rawDeltaTheta) != sgn(prevRawDeltaTheta.value())) settling = true;
+        prevRawDeltaTheta = rawDeltaTheta;
+        if (settling) deltaTheta = rawDeltaTheta;
+        else deltaTheta = angleError(theta, pose.theta, false, params.direction);
+        if (prevDeltaTheta == std::nullopt) prevDeltaTheta = deltaTheta;
+
+        // motion chaining
+        if (params.minSpeed != 0 && std::fabs(deltaTheta) < params.earlyExitRange) break;
+        if (params.minSpeed != 0 && sgn(deltaTheta) != sgn(prevDeltaTheta.value())) break;
+        prevDeltaTheta = deltaTheta;
+
+        // calculate the speed
+        motorPower = angularPID.update(deltaTheta);
+        angularLargeExit.update(deltaTheta);
+        angularSmallExit.update(deltaTheta);
+
+        // cap the speed
+        if (motorPower > params.maxSpeed) motorPower = params.maxSpeed;
+        else if (motorPower < -params.maxSpeed) motorPower = -params.maxSpeed;
+        if (std::fabs(deltaTheta) > 20) motorPower = slew(motorPower, prevMotorPower, angularSettings.slew);
+        if (motorPower < 0 && motorPower > -params.minSpeed) motorPower = -params.minSpeed;
+        else if (motorPower > 0 && motorPower < params.minSpeed) motorPower = params.minSpeed;
+        prevMotorPower = motorPower;
+
+        infoSink()->debug("Swing Motor Power: {} ", motorPower);
+
+        // move the drivetrain
+        if (lockedSide == DriveSide::LEFT) {
+            drivetrain.rightMotors->move(-motorPower);
+            drivetrain.leftMotors->brake();
+        } else {
+            drivetrain.leftMotors->move(motorPower);
+            drivetrain.rightMotors->brake();
+        }
+
+        pros::delay(10);
+    }
+
+    // restore the brake mode of the locked side and stop the drivetrain
+    lockedMotors->set_brake_mode_all(brakeMode);
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
@@ -0,0 +1,23 @@
+// Host copy of LemLib's exitcondition.cpp
+#include <cmath>
+#include "pros/rtos.hpp"
+#include "lemlib/exitcondition.hpp"
+
+lemlib::ExitCondition::ExitCondition(const float range, const int time)
+    : range(range),
+      time(time) {}
+
+bool lemlib::ExitCondition::getExit() { return done; }
+
+bool lemlib::ExitCondition::update(const float input) {
+    const int curTime = pros::millis();
+    if (std::fabs(input) > range) startTime = -1;
+    else if (startTime == -1) startTime = curTime;
+    else if (curTime >= startTime + time) done = true;
+    return done;
+}
+
+void lemlib::ExitCondition::reset() {
+    startTime = -1;
+    done = false;
+}
@@ -0,0 +1,20 @@
+// Host copy of LemLib's baseSink.cpp
+#include "lemlib/logger/baseSink.hpp"
+
+lemlib::BaseSink::BaseSink(std::initializer_list<std::shared_ptr<BaseSink>> sinks)
+    : sinks(sinks) {}
+
+void lemlib::BaseSink::setLowestLevel(Level level) {
+    // set the lowest level of the sinks this sink sends to, if any
+    for (std::shared_ptr<BaseSink> sink : sinks) sink->setLowestLevel(level);
+    lowestLevel = level;
+}
+
+void lemlib::BaseSink::setFormat(const std::string& format) { logFormat = format; }
+
+fmt::dynamic_format_arg_store<fmt::format_context>
+lemlib::BaseSink::getExtraFormattingArgs(const Message& messageInfo) {
+    return {};
+}
+
+void lemlib::BaseSink::sendMessage(const Message& message) {}
@@ -0,0 +1,7 @@
+// Host copy of LemLib's infoSink.cpp. Messages go straight to stdout, there's no serial port to buffer for
+#include <cstdio>
+#include "lemlib/logger/infoSink.hpp"
+
+lemlib::InfoSink::InfoSink() { setFormat("[LemLib] {level}: {message}"); }
+
+void lemlib::InfoSink::sendMessage(const Message& message) { std::printf("%s\n", message.message.c_str()); }
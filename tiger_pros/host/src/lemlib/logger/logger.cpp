@@ -0,0 +1,12 @@
+// Host copy of LemLib's logger.cpp
+#include "lemlib/logger/logger.hpp"
+
+std::shared_ptr<lemlib::InfoSink> lemlib::infoSink() {
+    static std::shared_ptr<InfoSink> sink = std::make_shared<InfoSink>();
+    return sink;
+}
+
+std::shared_ptr<lemlib::TelemetrySink> lemlib::telemetrySink() {
+    static std::shared_ptr<TelemetrySink> sink = std::make_shared<TelemetrySink>();
+    return sink;
+}
@@ -0,0 +1,13 @@
+// Host copy of LemLib's message.cpp
+#include "lemlib/logger/message.hpp"
+
+std::string lemlib::format_as(Level level) {
+    switch (level) {
+        case Level::DEBUG: return "DEBUG";
+        case Level::INFO: return "INFO";
+        case Level::WARN: return "WARN";
+        case Level::ERROR: return "ERROR";
+        case Level::FATAL: return "FATAL";
+        default: return "UNKNOWN";
+    }
+}
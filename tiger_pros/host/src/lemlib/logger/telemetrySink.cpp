@@ -0,0 +1,7 @@
+// Host copy of LemLib's telemetrySink.cpp. Telemetry is meant for the PROS terminal's hidden channel, so the host
+// drops it, the simulator's trace is the host's telemetry
+#include "lemlib/logger/telemetrySink.hpp"
+
+lemlib::TelemetrySink::TelemetrySink() { setFormat("{message}"); }
+
+void lemlib::TelemetrySink::sendMessage(const Message& message) {}
@@ -0,0 +1,29 @@
+// Host copy of LemLib's pid.cpp
+#include "lemlib/pid.hpp"
+#include "lemlib/util.hpp"
+
+lemlib::PID::PID(float kP, float kI, float kD, float windupRange, bool signFlipReset)
+    : kP(kP),
+      kI(kI),
+      kD(kD),
+      windupRange(windupRange),
+      signFlipReset(signFlipReset) {}
+
+float lemlib::PID::update(const float error) {
+    // calculate integral
+    integral += error;
+    if (sgn(error) != sgn((prevError)) && signFlipReset) integral = 0;
+    if (std::fabs(error) > windupRange && windupRange != 0) integral = 0;
+
+    // calculate derivative
+    const float derivative = error - prevError;
+    prevError = error;
+
+    // calculate output
+    return error * kP + integral * kI + derivative * kD;
+}
+
+void lemlib::PID::reset() {
+    integral = 0;
+    prevError = 0;
+}
@@ -0,0 +1,412 @@
+// Sensors, three wire ports, the controller and the brain, backed by tiger::sim::World
+#include <cerrno>
+#include <cmath>
+#include <cstdarg>
+#include <map>
+#include "pros/adi.hpp"
+#include "pros/error.h"
+#include "pros/imu.hpp"
+#include "pros/llemu.h"
+#include "pros/llemu.hpp"
+#include "pros/misc.hpp"
+#include "pros/rotation.hpp"
+#include "pros/rtos.hpp"
+#include "sim/world.hpp"
+
+using tiger::sim::world;
+
+namespace {
+/**
+ * @brief What an IMU reads, relative to the angle the simulation measures
+ */
+struct ImuState {
+        uint32_t calibratedTime = 0;
+        double rotationOffset = 0;
+        double headingOffset = 0;
+        double yawOffset = 0;
+        double pitch = 0;
+        double roll = 0;
+};
+
+/**
+ * @brief What a rotation sensor reads, relative to the distance its wheel has rolled
+ */
+struct RotationState {
+        bool reversed = false;
+        /** raw centidegrees that read as 0 */
+        double zero = 0;
+};
+
+// devices are usually globals, so their state can't be a global that might be constructed after them
+
+ImuState& getImu(uint8_t port) {
+    static std::map<uint8_t, ImuState> imus;
+    return imus[port];
+}
+
+RotationState& getRotation(uint8_t port) {
+    static std::map<uint8_t, RotationState> rotations;
+    return rotations[port];
+}
+} // namespace
+
+/**
+ * @brief Wrap an angle to [0, 360)
+ */
+static double wrapDegrees(double angle) { return angle - 360 * std::floor(angle / 360); }
+
+namespace pros {
+inline namespace v5 {
+Device::Device(const std::uint8_t port) : _port(port) {}
+
+std::uint8_t Device::get_port(void) const { return _port; }
+
+bool Device::is_installed() { return true; }
+
+/**
+ * @brief Check if an IMU is still calibrating, setting errno like PROS does if it is
+ */
+static bool isCalibrating(uint8_t port) {
+    if (c::millis() >= getImu(port).calibratedTime) return false;
+    errno = EAGAIN;
+    return true;
+}
+
+std::int32_t Imu::reset(bool blocking) const {
+    ImuState& imu = getImu(_port);
+    imu.calibratedTime = c::millis() + world().settings.imuCalibrationTime;
+    // the robot sits still while calibrating, so the IMU starts at 0 wherever it is now
+    imu.rotationOffset = -world().getImuRotation();
+    imu.headingOffset = -world().getImuRotation();
+    imu.yawOffset = -world().getImuRotation();
+    imu.pitch = 0;
+    imu.roll = 0;
+    if (blocking) c::delay(world().settings.imuCalibrationTime);
+    return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_data_rate(std::uint32_t) const { return PROS_SUCCESS; }
+
+double Imu::get_rotation() const {
+    if (isCalibrating(_port)) return PROS_ERR_F;
+    return world().getImuRotation() + getImu(_port).rotationOffset;
+}
+
+double Imu::get_heading() const {
+    if (isCalibrating(_port)) return PROS_ERR_F;
+    return wrapDegrees(world().getImuRotation() + getImu(_port).headingOffset);
+}
+
+pros::quaternion_s_t Imu::get_quaternion() const {
+    if (isCalibrating(_port)) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    // the robot only ever rotates around the vertical axis, counterclockwise for a right handed z
+    const double yaw = -get_yaw() * M_PI / 180;
+    return {0, 0, std::sin(yaw / 2), std::cos(yaw / 2)};
+}
+
+pros::euler_s_t Imu::get_euler() const {
+    if (isCalibrating(_port)) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    return {get_pitch(), get_roll(), get_yaw()};
+}
+
+double Imu::get_pitch() const {
+    if (isCalibrating(_port)) return PROS_ERR_F;
+    return getImu(_port).pitch;
+}
+
+double Imu::get_roll() const {
+    if (isCalibrating(_port)) return PROS_ERR_F;
+    return getImu(_port).roll;
+}
+
+double Imu::get_yaw() const {
+    if (isCalibrating(_port)) return PROS_ERR_F;
+    return wrapDegrees(world().getImuRotation() + getImu(_port).yawOffset + 180) - 180;
+}
+
+pros::imu_gyro_s_t Imu::get_gyro_rate() const {
+    if (isCalibrating(_port)) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    // z points up, so turning clockwise is a negative rate
+    return {0, 0, -world().getImuRate()};
+}
+
+pros::imu_accel_s_t Imu::get_accel() const {
+    if (isCalibrating(_port)) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    double forward = 0;
+    double right = 0;
+    world().getImuAccel(forward, right);
+    // mounted flat with y forwards and x to the right
+    return {right, forward, 1};
+}
+
+std::int32_t Imu::tare_rotation() const { return set_rotation(0); }
+
+std::int32_t Imu::tare_heading() const { return set_heading(0); }
+
+std::int32_t Imu::tare_pitch() const { return set_pitch(0); }
+
+std::int32_t Imu::tare_yaw() const { return set_yaw(0); }
+
+std::int32_t Imu::tare_roll() const { return set_roll(0); }
+
+std::int32_t Imu::tare() const {
+    tare_rotation();
+    tare_heading();
+    return tare_euler();
+}
+
+std::int32_t Imu::tare_euler() const { return set_euler({0, 0, 0}); }
+
+std::int32_t Imu::set_heading(const double target) const {
+    if (isCalibrating(_port)) return PROS_ERR;
+    getImu(_port).headingOffset = target - world().getImuRotation();
+    return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_rotation(const double target) const {
+    if (isCalibrating(_port)) return PROS_ERR;
+    getImu(_port).rotationOffset = target - world().getImuRotation();
+    return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_yaw(const double target) const {
+    if (isCalibrating(_port)) return PROS_ERR;
+    getImu(_port).yawOffset = target - world().getImuRotation();
+    return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_pitch(const double target) const {
+    if (isCalibrating(_port)) return PROS_ERR;
+    getImu(_port).pitch = target;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_roll(const double target) const {
+    if (isCalibrating(_port)) return PROS_ERR;
+    getImu(_port).roll = target;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Imu::set_euler(const pros::euler_s_t target) const {
+    if (isCalibrating(_port)) return PROS_ERR;
+    set_pitch(target.pitch);
+    set_roll(target.roll);
+    return set_yaw(target.yaw);
+}
+
+pros::ImuStatus Imu::get_status() const {
+    return c::millis() < getImu(_port).calibratedTime ? ImuStatus::calibrating : ImuStatus::ready;
+}
+
+bool Imu::is_calibrating() const { return c::millis() < getImu(_port).calibratedTime; }
+
+imu_orientation_e_t Imu::get_physical_orientation() const { return E_IMU_Z_UP; }
+
+Rotation::Rotation(const std::int8_t port) : Device(std::abs(port), DeviceType::rotation) {
+    getRotation(_port).reversed = port < 0;
+}
+
+/**
+ * @brief Read a rotation sensor, reversed and relative to its zero
+ */
+static double readRotation(uint8_t port) {
+    const RotationState& rotation = getRotation(port);
+    return (rotation.reversed ? -1 : 1) * (world().getRotation(port) - rotation.zero);
+}
+
+std::int32_t Rotation::reset() { return reset_position(); }
+
+std::int32_t Rotation::set_data_rate(std::uint32_t) const { return PROS_SUCCESS; }
+
+std::int32_t Rotation::set_position(std::int32_t position) const {
+    RotationState& rotation = getRotation(_port);
+    rotation.zero = world().getRotation(_port) - (rotation.reversed ? -1 : 1) * position;
+    return PROS_SUCCESS;
+}
+
+std::int32_t Rotation::reset_position(void) const { return set_position(0); }
+
+std::int32_t Rotation::get_position() const { return std::lround(readRotation(_port)); }
+
+std::int32_t Rotation::get_velocity() const {
+    return std::lround((getRotation(_port).reversed ? -1 : 1) * world().getRotationVelocity(_port));
+}
+
+std::int32_t Rotation::get_angle() const { return (std::lround(readRotation(_port)) % 36000 + 36000) % 36000; }
+
+std::int32_t Rotation::set_reversed(bool value) const {
+    RotationState& rotation = getRotation(_port);
+    // keep the position the same, only the direction changes
+    const std::int32_t position = get_position();
+    rotation.reversed = value;
+    return set_position(position);
+}
+
+std::int32_t Rotation::reverse() const { return set_reversed(!getRotation(_port).reversed); }
+
+std::int32_t Rotation::get_reversed() const { return getRotation(_port).reversed; }
+
+Controller::Controller(controller_id_e_t id) : _id(id) {}
+
+std::int32_t Controller::is_connected(void) { return c::controller_is_connected(_id); }
+
+std::int32_t Controller::get_analog(controller_analog_e_t channel) { return c::controller_get_analog(_id, channel); }
+
+std::int32_t Controller::get_battery_capacity(void) { return c::controller_get_battery_capacity(_id); }
+
+std::int32_t Controller::get_battery_level(void) { return c::controller_get_battery_level(_id); }
+
+std::int32_t Controller::get_digital(controller_digital_e_t button) { return c::controller_get_digital(_id, button); }
+
+std::int32_t Controller::get_digital_new_press(controller_digital_e_t button) {
+    return c::controller_get_digital_new_press(_id, button);
+}
+
+std::int32_t Controller::get_digital_new_release(controller_digital_e_t button) {
+    return c::controller_get_digital_new_release(_id, button);
+}
+
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const char* str) {
+    return c::controller_set_text(_id, line, col, str);
+}
+
+std::int32_t Controller::set_text(std::uint8_t line, std::uint8_t col, const std::string& str) {
+    return c::controller_set_text(_id, line, col, str.c_str());
+}
+
+std::int32_t Controller::clear_line(std::uint8_t line) { return c::controller_clear_line(_id, line); }
+
+std::int32_t Controller::rumble(const char* rumble_pattern) { return c::controller_rumble(_id, rumble_pattern); }
+
+std::int32_t Controller::clear(void) { return c::controller_clear(_id); }
+} // namespace v5
+
+namespace adi {
+/**
+ * @brief Convert a three wire port from 'A' to 'H', 'a' to 'h' or 1 to 8 to 1 to 8
+ */
+static std::uint8_t normalize(std::uint8_t port) {
+    if (port >= 'a' && port <= 'h') return port - 'a' + 1;
+    if (port >= 'A' && port <= 'H') return port - 'A' + 1;
+    return port;
+}
+
+Port::Port(std::uint8_t adi_port, adi_port_config_e_t type)
+    : _smart_port(INTERNAL_ADI_PORT),
+      _adi_port(normalize(adi_port)) {
+    set_config(type);
+}
+
+Port::Port(ext_adi_port_pair_t port_pair, adi_port_config_e_t type)
+    : _smart_port(port_pair.first),
+      _adi_port(normalize(port_pair.second)) {
+    set_config(type);
+}
+
+std::int32_t Port::get_config() const { return E_ADI_TYPE_UNDEFINED; }
+
+std::int32_t Port::get_value() const { return world().getAdi(_smart_port, _adi_port); }
+
+std::int32_t Port::set_config(adi_port_config_e_t) const { return PROS_SUCCESS; }
+
+std::int32_t Port::set_value(std::int32_t value) const {
+    world().setAdi(_smart_port, _adi_port, value);
+    return PROS_SUCCESS;
+}
+
+ext_adi_port_tuple_t Port::get_port() const { return {_smart_port, _adi_port, 0}; }
+
+DigitalOut::DigitalOut(std::uint8_t adi_port, bool init_state) : Port(adi_port, E_ADI_DIGITAL_OUT) {
+    set_value(init_state);
+}
+
+DigitalOut::DigitalOut(ext_adi_port_pair_t port_pair, bool init_state) : Port(port_pair, E_ADI_DIGITAL_OUT) {
+    set_value(init_state);
+}
+
+// quadrature encoders aren't simulated, so they never move
+Encoder::Encoder(std::uint8_t adi_port_top, std::uint8_t, bool)
+    : Port(adi_port_top, E_ADI_LEGACY_ENCODER),
+      _port_pair(INTERNAL_ADI_PORT, normalize(adi_port_top)) {}
+
+Encoder::Encoder(ext_adi_port_tuple_t port_tuple, bool)
+    : Port({std::get<0>(port_tuple), std::get<1>(port_tuple)}, E_ADI_LEGACY_ENCODER),
+      _port_pair(std::get<0>(port_tuple), normalize(std::get<1>(port_tuple))) {}
+
+std::int32_t Encoder::reset() const { return PROS_SUCCESS; }
+
+std::int32_t Encoder::get_value() const { return 0; }
+
+ext_adi_port_tuple_t Encoder::get_port() const { return {_port_pair.first, _port_pair.second, 0}; }
+} // namespace adi
+
+namespace lcd {
+bool is_initialized(void) { return true; }
+
+bool initialize(void) { return true; }
+
+bool shutdown(void) { return true; }
+
+bool set_text(std::int16_t, std::string) { return true; }
+
+bool clear(void) { return true; }
+
+bool clear_line(std::int16_t) { return true; }
+
+void register_btn0_cb(lcd_btn_cb_fn_t) {}
+
+void register_btn1_cb(lcd_btn_cb_fn_t) {}
+
+void register_btn2_cb(lcd_btn_cb_fn_t) {}
+
+std::uint8_t read_buttons(void) { return 0; }
+} // namespace lcd
+
+namespace c {
+// nobody drives during a simulated autonomous period, so the controller is connected but idle
+int32_t controller_is_connected(controller_id_e_t) { return 1; }
+
+int32_t controller_get_analog(controller_id_e_t, controller_analog_e_t) { return 0; }
+
+int32_t controller_get_battery_capacity(controller_id_e_t) { return 100; }
+
+int32_t controller_get_battery_level(controller_id_e_t) { return 100; }
+
+int32_t controller_get_digital(controller_id_e_t, controller_digital_e_t) { return 0; }
+
+int32_t controller_get_digital_new_press(controller_id_e_t, controller_digital_e_t) { return 0; }
+
+int32_t controller_get_digital_new_release(controller_id_e_t, controller_digital_e_t) { return 0; }
+
+int32_t controller_print(controller_id_e_t, uint8_t, uint8_t, const char*, ...) { return PROS_SUCCESS; }
+
+int32_t controller_set_text(controller_id_e_t, uint8_t, uint8_t, const char*) { return PROS_SUCCESS; }
+
+int32_t controller_clear_line(controller_id_e_t, uint8_t) { return PROS_SUCCESS; }
+
+int32_t controller_clear(controller_id_e_t) { return PROS_SUCCESS; }
+
+int32_t controller_rumble(controller_id_e_t, const char*) { return PROS_SUCCESS; }
+
+// the simulation only runs the autonomous period, enabled and connected to a field
+uint8_t competition_get_status(void) { return COMPETITION_AUTONOMOUS | COMPETITION_CONNECTED; }
+
+uint8_t competition_is_disabled(void) { return 0; }
+
+uint8_t competition_is_connected(void) { return 1; }
+
+uint8_t competition_is_autonomous(void) { return 1; }
+
+uint8_t competition_is_field(void) { return 1; }
+
+uint8_t competition_is_switch(void) { return 0; }
+
+int32_t battery_get_voltage(void) { return 12800; }
+
+int32_t battery_get_current(void) { return 0; }
+
+double battery_get_temperature(void) { return 25; }
+
+double battery_get_capacity(void) { return 100; }
+} // namespace c
+} // namespace pros
@@ -0,0 +1,1053 @@
+// V5 smart motors, commanding and reading the simulated motors in tiger::sim::World
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include "pros/error.h"
+#include "pros/motor_group.hpp"
+#include "pros/motors.hpp"
+#include "pros/rtos.h"
+#include "sim/world.hpp"
+
+using tiger::sim::MotorState;
+
+/**
+ * @brief Check a port, setting errno like PROS does if it's invalid
+ */
+static bool isValid(std::int8_t port) {
+    if (port != 0 && std::abs(port) <= 21) return true;
+    errno = ENXIO;
+    return false;
+}
+
+static MotorState& getMotor(std::int8_t port) { return tiger::sim::world().motor(std::abs(port)); }
+
+/**
+ * @brief The direction a port reads and commands its motor in
+ */
+static double getSign(std::int8_t port) { return port < 0 ? -1 : 1; }
+
+/**
+ * @brief Stop a motor, remembering where it stopped for the hold brake mode
+ */
+static void stop(MotorState& motor, MotorState::Mode mode) {
+    if (motor.mode != mode || motor.target != 0) motor.holdPosition = motor.position;
+    motor.mode = mode;
+    motor.target = 0;
+}
+
+namespace pros::c {
+int32_t motor_move(int8_t port, int32_t voltage) {
+    return motor_move_voltage(port, std::clamp(voltage, -127, 127) * 12000 / 127);
+}
+
+int32_t motor_brake(int8_t port) {
+    if (!isValid(port)) return PROS_ERR;
+    stop(getMotor(port), MotorState::Mode::BRAKE);
+    return PROS_SUCCESS;
+}
+
+int32_t motor_move_absolute(int8_t port, double position, const int32_t velocity) {
+    if (!isValid(port)) return PROS_ERR;
+    MotorState& motor = getMotor(port);
+    motor.mode = MotorState::Mode::POSITION;
+    motor.target = motor.zero + getSign(port) * motor.fromUnits(position);
+    motor.maxVelocity = std::min<double>(std::abs(velocity), motor.getFreeSpeed());
+    return PROS_SUCCESS;
+}
+
+int32_t motor_move_relative(int8_t port, double position, const int32_t velocity) {
+    if (!isValid(port)) return PROS_ERR;
+    MotorState& motor = getMotor(port);
+    // relative moves are relative to the last target, so they don't accumulate error
+    const double start = motor.mode == MotorState::Mode::POSITION ? motor.target : motor.position;
+    motor.mode = MotorState::Mode::POSITION;
+    motor.target = start + getSign(port) * motor.fromUnits(position);
+    motor.maxVelocity = std::min<double>(std::abs(velocity), motor.getFreeSpeed());
+    return PROS_SUCCESS;
+}
+
+int32_t motor_move_velocity(int8_t port, const int32_t velocity) {
+    if (!isValid(port)) return PROS_ERR;
+    MotorState& motor = getMotor(port);
+    if (velocity == 0) {
+        stop(motor, MotorState::Mode::VELOCITY);
+        return PROS_SUCCESS;
+    }
+    motor.mode = MotorState::Mode::VELOCITY;
+    motor.target = getSign(port) * std::clamp<double>(velocity, -motor.getFreeSpeed(), motor.getFreeSpeed());
+    return PROS_SUCCESS;
+}
+
+int32_t motor_move_voltage(int8_t port, const int32_t voltage) {
+    if (!isValid(port)) return PROS_ERR;
+    MotorState& motor = getMotor(port);
+    if (voltage == 0) {
+        stop(motor, MotorState::Mode::VOLTAGE);
+        return PROS_SUCCESS;
+    }
+    motor.mode = MotorState::Mode::VOLTAGE;
+    motor.target = getSign(port) * std::clamp(voltage, -12000, 12000);
+    return PROS_SUCCESS;
+}
+
+int32_t motor_modify_profiled_velocity(int8_t port, const int32_t velocity) {
+    if (!isValid(port)) return PROS_ERR;
+    MotorState& motor = getMotor(port);
+    if (motor.mode == MotorState::Mode::POSITION) motor.maxVelocity = std::abs(velocity);
+    return PROS_SUCCESS;
+}
+
+double motor_get_target_position(int8_t port) {
+    if (!isValid(port)) return PROS_ERR_F;
+    const MotorState& motor = getMotor(port);
+    if (motor.mode != MotorState::Mode::POSITION) return 0;
+    return getSign(port) * motor.toUnits(motor.target - motor.zero);
+}
+
+int32_t motor_get_target_velocity(int8_t port) {
+    if (!isValid(port)) return PROS_ERR;
+    const MotorState& motor = getMotor(port);
+    if (motor.mode != MotorState::Mode::VELOCITY) return 0;
+    return getSign(port) * motor.target;
+}
+
+double motor_get_actual_velocity(int8_t port) {
+    if (!isValid(port)) return PROS_ERR_F;
+    return getSign(port) * getMotor(port).velocity;
+}
+
+int32_t motor_get_current_draw(int8_t port) {
+    if (!isValid(port)) return PROS_ERR;
+    const MotorState& motor = getMotor(port);
+    // current is proportional to torque, with the stall torque at 2.5A
+    return std::abs(motor.torque) / motor.getStallTorque() * 2500;
+}
+
+int32_t motor_get_direction(int8_t port) {
+    if (!isValid(port)) return PROS_ERR;
+    return getSign(port) * getMotor(port).velocity < 0 ? -1 : 1;
+}
+
+double motor_get_efficiency(int8_t port) {
+    if (!isValid(port)) return PROS_ERR_F;
+    const MotorState& motor = getMotor(port);
+    const double current = std::abs(motor.torque) / motor.getStallTorque() * 2.5;
+    const double electrical = std::abs(motor.voltage) * current;
+    if (electrical == 0) return 0;
+    const double mechanical = std::abs(motor.torque * motor.velocity * 2 * M_PI / 60);
+    return std::min(100.0, 100 * mechanical / electrical);
+}
+
+int32_t motor_is_over_current(int8_t port) {
+    if (!isValid(port)) return PROS_ERR;
+    return motor_get_current_draw(port) >= getMotor(port).currentLimit;
+}
+
+int32_t motor_is_over_temp(int8_t port) {
+    if (!isValid(port)) return PROS_ERR;
+    // temperature isn't simulated
+    return 0;
+}
+
+uint32_t motor_get_faults(int8_t port) {
+    if (!isValid(port)) return PROS_ERR;
+    return E_MOTOR_FAULT_NO_FAULTS;
+}
+
+uint32_t motor_get_flags(int8_t port) {
+    if (!isValid(port)) return PROS_ERR;
+    return std::abs(getMotor(port).velocity) < 1 ? E_MOTOR_FLAGS_ZERO_VELOCITY : E_MOTOR_FLAGS_NONE;
+}
+
+int32_t motor_get_raw_position(int8_t port, uint32_t* const timestamp) {
+    if (!isValid(port)) return PROS_ERR;
+    const MotorState& motor = getMotor(port);
+    if (timestamp != nullptr) *timestamp = millis();
+    return getSign(port) * motor.position * motor.getTicksPerRotation();
+}
+
+double motor_get_position(int8_t port) {
+    if (!isValid(port)) return PROS_ERR_F;
+    const MotorState& motor = getMotor(port);
+    return getSign(port) * motor.toUnits(motor.position - motor.zero);
+}
+
+double motor_get_power(int8_t port) {
+    if (!isValid(port)) return PROS_ERR_F;
+    const MotorState& motor = getMotor(port);
+    return std::abs(motor.torque * motor.velocity * 2 * M_PI / 60);
+}
+
+double motor_get_temperature(int8_t port) {
+    if (!isValid(port)) return PROS_ERR_F;
+    // temperature isn't simulated, motors stay at room temperature
+    return 25;
+}
+
+double motor_get_torque(int8_t port) {
+    if (!isValid(port)) return PROS_ERR_F;
+    return getSign(port) * getMotor(port).torque;
+}
+
+int32_t motor_get_voltage(int8_t port) {
+    if (!isValid(port)) return PROS_ERR;
+    return getSign(port) * getMotor(port).voltage * 1000;
+}
+
+int32_t motor_set_zero_position(int8_t port, const double position) {
+    if (!isValid(port)) return PROS_ERR;
+    MotorState& motor = getMotor(port);
+    motor.zero = getSign(port) * motor.fromUnits(position);
+    return PROS_SUCCESS;
+}
+
+int32_t motor_tare_position(int8_t port) {
+    if (!isValid(port)) return PROS_ERR;
+    MotorState& motor = getMotor(port);
+    motor.zero = motor.position;
+    return PROS_SUCCESS;
+}
+
+int32_t motor_set_brake_mode(int8_t port, const motor_brake_mode_e_t mode) {
+    if (!isValid(port)) return PROS_ERR;
+    MotorState& motor = getMotor(port);
+    if (mode == E_MOTOR_BRAKE_HOLD && motor.brakeMode != E_MOTOR_BRAKE_HOLD) motor.holdPosition = motor.position;
+    motor.brakeMode = mode;
+    return PROS_SUCCESS;
+}
+
+int32_t motor_set_current_limit(int8_t port, const int32_t limit) {
+    if (!isValid(port)) return PROS_ERR;
+    getMotor(port).currentLimit = limit;
+    return PROS_SUCCESS;
+}
+
+int32_t motor_set_encoder_units(int8_t port, const motor_encoder_units_e_t units) {
+    if (!isValid(port)) return PROS_ERR;
+    getMotor(port).units = units;
+    return PROS_SUCCESS;
+}
+
+int32_t motor_set_gearing(int8_t port, const motor_gearset_e_t gearset) {
+    if (!isValid(port)) return PROS_ERR;
+    getMotor(port).gearset = gearset;
+    return PROS_SUCCESS;
+}
+
+int32_t motor_set_voltage_limit(int8_t port, const int32_t limit) {
+    if (!isValid(port)) return PROS_ERR;
+    getMotor(port).voltageLimit = limit;
+    return PROS_SUCCESS;
+}
+
+motor_brake_mode_e_t motor_get_brake_mode(int8_t port) {
+    if (!isValid(port)) return E_MOTOR_BRAKE_INVALID;
+    return getMotor(port).brakeMode;
+}
+
+int32_t motor_get_current_limit(int8_t port) {
+    if (!isValid(port)) return PROS_ERR;
+    return getMotor(port).currentLimit;
+}
+
+motor_encoder_units_e_t motor_get_encoder_units(int8_t port) {
+    if (!isValid(port)) return E_MOTOR_ENCODER_INVALID;
+    return getMotor(port).units;
+}
+
+motor_gearset_e_t motor_get_gearing(int8_t port) {
+    if (!isValid(port)) return E_MOTOR_GEARSET_INVALID;
+    return getMotor(port).gearset;
+}
+
+int32_t motor_get_voltage_limit(int8_t port) {
+    if (!isValid(port)) return PROS_ERR;
+    return getMotor(port).voltageLimit;
+}
+
+motor_type_e_t motor_get_type(int8_t port) {
+    if (!isValid(port)) return E_MOTOR_TYPE_INVALID;
+    return E_MOTOR_TYPE_V5;
+}
+} // namespace pros::c
+
+/**
+ * @brief Get the port a motor group index refers to, or 0 if it's out of range
+ */
+static std::int8_t portAt(const std::vector<std::int8_t>& ports, std::uint8_t index) {
+    return index < ports.size() ? ports[index] : 0;
+}
+
+/**
+ * @brief Get the port a motor index refers to. A motor only has index 0
+ */
+static std::int8_t portAt(std::int8_t port, std::uint8_t index) { return index == 0 ? port : 0; }
+
+namespace pros::inline v5 {
+Motor::Motor(const std::int8_t port, const MotorGears gearset, const MotorUnits encoder_units)
+    : Device(std::abs(port), DeviceType::motor),
+      _port(port) {
+    if (gearset != MotorGears::invalid) set_gearing(gearset);
+    if (encoder_units != MotorUnits::invalid) set_encoder_units(encoder_units);
+}
+
+std::int32_t Motor::is_reversed(const std::uint8_t index) const {
+    if (index != 0) return PROS_ERR;
+    return _port < 0;
+}
+
+std::vector<std::int32_t> Motor::is_reversed_all(void) const { return {_port < 0}; }
+
+std::int32_t Motor::set_reversed(const bool reverse, const std::uint8_t index) {
+    if (index != 0) return PROS_ERR;
+    _port = reverse ? -std::abs(_port) : std::abs(_port);
+    return PROS_SUCCESS;
+}
+
+std::int32_t Motor::set_reversed_all(const bool reverse) { return set_reversed(reverse, 0); }
+
+std::int8_t Motor::get_port(const std::uint8_t index) const { return portAt(_port, index); }
+
+std::vector<std::int8_t> Motor::get_port_all(void) const { return {_port}; }
+
+std::int8_t Motor::size(void) const { return 1; }
+
+MotorGroup::MotorGroup(const std::initializer_list<std::int8_t> ports, const MotorGears gearset,
+                       const MotorUnits encoder_units)
+    : MotorGroup(std::vector<std::int8_t>(ports), gearset, encoder_units) {}
+
+MotorGroup::MotorGroup(const std::vector<std::int8_t>& ports, const MotorGears gearset,
+                       const MotorUnits encoder_units)
+    : _ports(ports) {
+    if (gearset != MotorGears::invalid) set_gearing_all(gearset);
+    if (encoder_units != MotorUnits::invalid) set_encoder_units_all(encoder_units);
+}
+
+MotorGroup::MotorGroup(AbstractMotor& motor_group) : _ports(motor_group.get_port_all()) {}
+
+void MotorGroup::operator+=(AbstractMotor& other) { append(other); }
+
+void MotorGroup::append(AbstractMotor& other) {
+    for (std::int8_t port : other.get_port_all()) _ports.push_back(port);
+}
+
+void MotorGroup::erase_port(std::int8_t port) {
+    std::erase_if(_ports, [port](std::int8_t other) { return std::abs(other) == std::abs(port); });
+}
+
+std::int32_t MotorGroup::set_gearing(std::vector<pros::motor_gearset_e_t> gearsets) const {
+    for (size_t i = 0; i < std::min(gearsets.size(), _ports.size()); i++) c::motor_set_gearing(_ports[i], gearsets[i]);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_gearing(std::vector<MotorGears> gearsets) const {
+    for (size_t i = 0; i < std::min(gearsets.size(), _ports.size()); i++)
+        c::motor_set_gearing(_ports[i], static_cast<motor_gearset_e_t>(gearsets[i]));
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::is_reversed(const std::uint8_t index) const {
+    if (index >= _ports.size()) return PROS_ERR;
+    return _ports[index] < 0;
+}
+
+std::vector<std::int32_t> MotorGroup::is_reversed_all(void) const {
+    std::vector<std::int32_t> values;
+    for (std::int8_t port : _ports) values.push_back(port < 0);
+    return values;
+}
+
+std::int32_t MotorGroup::set_reversed(const bool reverse, const std::uint8_t index) {
+    if (index >= _ports.size()) return PROS_ERR;
+    _ports[index] = reverse ? -std::abs(_ports[index]) : std::abs(_ports[index]);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_reversed_all(const bool reverse) {
+    for (std::int8_t& port : _ports) port = reverse ? -std::abs(port) : std::abs(port);
+    return PROS_SUCCESS;
+}
+
+std::int8_t MotorGroup::get_port(const std::uint8_t index) const { return portAt(_ports, index); }
+
+std::vector<std::int8_t> MotorGroup::get_port_all(void) const { return _ports; }
+
+std::int8_t MotorGroup::size(void) const { return _ports.size(); }
+
+// Motor
+
+std::int32_t Motor::move(std::int32_t voltage) const {
+    return c::motor_move(_port, voltage);
+}
+
+std::int32_t Motor::move_absolute(const double position, const std::int32_t velocity) const {
+    return c::motor_move_absolute(_port, position, velocity);
+}
+
+std::int32_t Motor::move_relative(const double position, const std::int32_t velocity) const {
+    return c::motor_move_relative(_port, position, velocity);
+}
+
+std::int32_t Motor::move_velocity(const std::int32_t velocity) const {
+    return c::motor_move_velocity(_port, velocity);
+}
+
+std::int32_t Motor::move_voltage(const std::int32_t voltage) const {
+    return c::motor_move_voltage(_port, voltage);
+}
+
+std::int32_t Motor::brake(void) const {
+    return c::motor_brake(_port);
+}
+
+std::int32_t Motor::modify_profiled_velocity(const std::int32_t velocity) const {
+    return c::motor_modify_profiled_velocity(_port, velocity);
+}
+
+double Motor::get_target_position(const std::uint8_t index) const {
+    return c::motor_get_target_position(portAt(_port, index));
+}
+
+std::vector<double> Motor::get_target_position_all(void) const {
+    std::vector<double> values;
+    values.push_back(c::motor_get_target_position(_port));
+    return values;
+}
+
+std::int32_t Motor::get_target_velocity(const std::uint8_t index) const {
+    return c::motor_get_target_velocity(portAt(_port, index));
+}
+
+std::vector<std::int32_t> Motor::get_target_velocity_all(void) const {
+    std::vector<std::int32_t> values;
+    values.push_back(c::motor_get_target_velocity(_port));
+    return values;
+}
+
+double Motor::get_actual_velocity(const std::uint8_t index) const {
+    return c::motor_get_actual_velocity(portAt(_port, index));
+}
+
+std::vector<double> Motor::get_actual_velocity_all(void) const {
+    std::vector<double> values;
+    values.push_back(c::motor_get_actual_velocity(_port));
+    return values;
+}
+
+std::int32_t Motor::get_current_draw(const std::uint8_t index) const {
+    return c::motor_get_current_draw(portAt(_port, index));
+}
+
+std::vector<std::int32_t> Motor::get_current_draw_all(void) const {
+    std::vector<std::int32_t> values;
+    values.push_back(c::motor_get_current_draw(_port));
+    return values;
+}
+
+std::int32_t Motor::get_direction(const std::uint8_t index) const {
+    return c::motor_get_direction(portAt(_port, index));
+}
+
+std::vector<std::int32_t> Motor::get_direction_all(void) const {
+    std::vector<std::int32_t> values;
+    values.push_back(c::motor_get_direction(_port));
+    return values;
+}
+
+double Motor::get_efficiency(const std::uint8_t index) const {
+    return c::motor_get_efficiency(portAt(_port, index));
+}
+
+std::vector<double> Motor::get_efficiency_all(void) const {
+    std::vector<double> values;
+    values.push_back(c::motor_get_efficiency(_port));
+    return values;
+}
+
+std::uint32_t Motor::get_faults(const std::uint8_t index) const {
+    return c::motor_get_faults(portAt(_port, index));
+}
+
+std::vector<std::uint32_t> Motor::get_faults_all(void) const {
+    std::vector<std::uint32_t> values;
+    values.push_back(c::motor_get_faults(_port));
+    return values;
+}
+
+std::uint32_t Motor::get_flags(const std::uint8_t index) const {
+    return c::motor_get_flags(portAt(_port, index));
+}
+
+std::vector<std::uint32_t> Motor::get_flags_all(void) const {
+    std::vector<std::uint32_t> values;
+    values.push_back(c::motor_get_flags(_port));
+    return values;
+}
+
+double Motor::get_position(const std::uint8_t index) const {
+    return c::motor_get_position(portAt(_port, index));
+}
+
+std::vector<double> Motor::get_position_all(void) const {
+    std::vector<double> values;
+    values.push_back(c::motor_get_position(_port));
+    return values;
+}
+
+double Motor::get_power(const std::uint8_t index) const {
+    return c::motor_get_power(portAt(_port, index));
+}
+
+std::vector<double> Motor::get_power_all(void) const {
+    std::vector<double> values;
+    values.push_back(c::motor_get_power(_port));
+    return values;
+}
+
+std::int32_t Motor::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t index) const {
+    return c::motor_get_raw_position(portAt(_port, index), timestamp);
+}
+
+std::vector<std::int32_t> Motor::get_raw_position_all(std::uint32_t* const timestamp) const {
+    std::vector<std::int32_t> values;
+    values.push_back(c::motor_get_raw_position(_port, timestamp));
+    return values;
+}
+
+double Motor::get_temperature(const std::uint8_t index) const {
+    return c::motor_get_temperature(portAt(_port, index));
+}
+
+std::vector<double> Motor::get_temperature_all(void) const {
+    std::vector<double> values;
+    values.push_back(c::motor_get_temperature(_port));
+    return values;
+}
+
+double Motor::get_torque(const std::uint8_t index) const {
+    return c::motor_get_torque(portAt(_port, index));
+}
+
+std::vector<double> Motor::get_torque_all(void) const {
+    std::vector<double> values;
+    values.push_back(c::motor_get_torque(_port));
+    return values;
+}
+
+std::int32_t Motor::get_voltage(const std::uint8_t index) const {
+    return c::motor_get_voltage(portAt(_port, index));
+}
+
+std::vector<std::int32_t> Motor::get_voltage_all(void) const {
+    std::vector<std::int32_t> values;
+    values.push_back(c::motor_get_voltage(_port));
+    return values;
+}
+
+std::int32_t Motor::is_over_current(const std::uint8_t index) const {
+    return c::motor_is_over_current(portAt(_port, index));
+}
+
+std::vector<std::int32_t> Motor::is_over_current_all(void) const {
+    std::vector<std::int32_t> values;
+    values.push_back(c::motor_is_over_current(_port));
+    return values;
+}
+
+std::int32_t Motor::is_over_temp(const std::uint8_t index) const {
+    return c::motor_is_over_temp(portAt(_port, index));
+}
+
+std::vector<std::int32_t> Motor::is_over_temp_all(void) const {
+    std::vector<std::int32_t> values;
+    values.push_back(c::motor_is_over_temp(_port));
+    return values;
+}
+
+MotorBrake Motor::get_brake_mode(const std::uint8_t index) const {
+    return static_cast<MotorBrake>(c::motor_get_brake_mode(portAt(_port, index)));
+}
+
+std::vector<MotorBrake> Motor::get_brake_mode_all(void) const {
+    std::vector<MotorBrake> values;
+    values.push_back(static_cast<MotorBrake>(c::motor_get_brake_mode(_port)));
+    return values;
+}
+
+std::int32_t Motor::get_current_limit(const std::uint8_t index) const {
+    return c::motor_get_current_limit(portAt(_port, index));
+}
+
+std::vector<std::int32_t> Motor::get_current_limit_all(void) const {
+    std::vector<std::int32_t> values;
+    values.push_back(c::motor_get_current_limit(_port));
+    return values;
+}
+
+MotorUnits Motor::get_encoder_units(const std::uint8_t index) const {
+    return static_cast<MotorUnits>(c::motor_get_encoder_units(portAt(_port, index)));
+}
+
+std::vector<MotorUnits> Motor::get_encoder_units_all(void) const {
+    std::vector<MotorUnits> values;
+    values.push_back(static_cast<MotorUnits>(c::motor_get_encoder_units(_port)));
+    return values;
+}
+
+MotorGears Motor::get_gearing(const std::uint8_t index) const {
+    return static_cast<MotorGears>(c::motor_get_gearing(portAt(_port, index)));
+}
+
+std::vector<MotorGears> Motor::get_gearing_all(void) const {
+    std::vector<MotorGears> values;
+    values.push_back(static_cast<MotorGears>(c::motor_get_gearing(_port)));
+    return values;
+}
+
+std::int32_t Motor::get_voltage_limit(const std::uint8_t index) const {
+    return c::motor_get_voltage_limit(portAt(_port, index));
+}
+
+std::vector<std::int32_t> Motor::get_voltage_limit_all(void) const {
+    std::vector<std::int32_t> values;
+    values.push_back(c::motor_get_voltage_limit(_port));
+    return values;
+}
+
+MotorType Motor::get_type(const std::uint8_t index) const {
+    return static_cast<MotorType>(c::motor_get_type(portAt(_port, index)));
+}
+
+std::vector<MotorType> Motor::get_type_all(void) const {
+    std::vector<MotorType> values;
+    values.push_back(static_cast<MotorType>(c::motor_get_type(_port)));
+    return values;
+}
+
+std::int32_t Motor::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const {
+    return c::motor_set_brake_mode(portAt(_port, index), static_cast<motor_brake_mode_e_t>(mode));
+}
+
+std::int32_t Motor::set_brake_mode_all(const MotorBrake mode) const {
+    return c::motor_set_brake_mode(_port, static_cast<motor_brake_mode_e_t>(mode));
+}
+
+std::int32_t Motor::set_brake_mode(const pros::motor_brake_mode_e_t mode, const std::uint8_t index) const {
+    return c::motor_set_brake_mode(portAt(_port, index), mode);
+}
+
+std::int32_t Motor::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const {
+    return c::motor_set_brake_mode(_port, mode);
+}
+
+std::int32_t Motor::set_current_limit(const std::int32_t limit, const std::uint8_t index) const {
+    return c::motor_set_current_limit(portAt(_port, index), limit);
+}
+
+std::int32_t Motor::set_current_limit_all(const std::int32_t limit) const {
+    return c::motor_set_current_limit(_port, limit);
+}
+
+std::int32_t Motor::set_encoder_units(const MotorUnits units, const std::uint8_t index) const {
+    return c::motor_set_encoder_units(portAt(_port, index), static_cast<motor_encoder_units_e_t>(units));
+}
+
+std::int32_t Motor::set_encoder_units_all(const MotorUnits units) const {
+    return c::motor_set_encoder_units(_port, static_cast<motor_encoder_units_e_t>(units));
+}
+
+std::int32_t Motor::set_encoder_units(const pros::motor_encoder_units_e_t units, const std::uint8_t index) const {
+    return c::motor_set_encoder_units(portAt(_port, index), units);
+}
+
+std::int32_t Motor::set_encoder_units_all(const pros::motor_encoder_units_e_t units) const {
+    return c::motor_set_encoder_units(_port, units);
+}
+
+std::int32_t Motor::set_gearing(const MotorGears gearset, const std::uint8_t index) const {
+    return c::motor_set_gearing(portAt(_port, index), static_cast<motor_gearset_e_t>(gearset));
+}
+
+std::int32_t Motor::set_gearing_all(const MotorGears gearset) const {
+    return c::motor_set_gearing(_port, static_cast<motor_gearset_e_t>(gearset));
+}
+
+std::int32_t Motor::set_gearing(const pros::motor_gearset_e_t gearset, const std::uint8_t index) const {
+    return c::motor_set_gearing(portAt(_port, index), gearset);
+}
+
+std::int32_t Motor::set_gearing_all(const pros::motor_gearset_e_t gearset) const {
+    return c::motor_set_gearing(_port, gearset);
+}
+
+std::int32_t Motor::set_voltage_limit(const std::int32_t limit, const std::uint8_t index) const {
+    return c::motor_set_voltage_limit(portAt(_port, index), limit);
+}
+
+std::int32_t Motor::set_voltage_limit_all(const std::int32_t limit) const {
+    return c::motor_set_voltage_limit(_port, limit);
+}
+
+std::int32_t Motor::set_zero_position(const double position, const std::uint8_t index) const {
+    return c::motor_set_zero_position(portAt(_port, index), position);
+}
+
+std::int32_t Motor::set_zero_position_all(const double position) const {
+    return c::motor_set_zero_position(_port, position);
+}
+
+std::int32_t Motor::tare_position(const std::uint8_t index) const {
+    return c::motor_tare_position(portAt(_port, index));
+}
+
+std::int32_t Motor::tare_position_all(void) const {
+    return c::motor_tare_position(_port);
+}
+
+// MotorGroup
+
+std::int32_t MotorGroup::move(std::int32_t voltage) const {
+    for (std::int8_t port : _ports) c::motor_move(port, voltage);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::move_absolute(const double position, const std::int32_t velocity) const {
+    for (std::int8_t port : _ports) c::motor_move_absolute(port, position, velocity);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::move_relative(const double position, const std::int32_t velocity) const {
+    for (std::int8_t port : _ports) c::motor_move_relative(port, position, velocity);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::move_velocity(const std::int32_t velocity) const {
+    for (std::int8_t port : _ports) c::motor_move_velocity(port, velocity);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::move_voltage(const std::int32_t voltage) const {
+    for (std::int8_t port : _ports) c::motor_move_voltage(port, voltage);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::brake(void) const {
+    for (std::int8_t port : _ports) c::motor_brake(port);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::modify_profiled_velocity(const std::int32_t velocity) const {
+    for (std::int8_t port : _ports) c::motor_modify_profiled_velocity(port, velocity);
+    return PROS_SUCCESS;
+}
+
+double MotorGroup::get_target_position(const std::uint8_t index) const {
+    return c::motor_get_target_position(portAt(_ports, index));
+}
+
+std::vector<double> MotorGroup::get_target_position_all(void) const {
+    std::vector<double> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_target_position(port));
+    return values;
+}
+
+std::int32_t MotorGroup::get_target_velocity(const std::uint8_t index) const {
+    return c::motor_get_target_velocity(portAt(_ports, index));
+}
+
+std::vector<std::int32_t> MotorGroup::get_target_velocity_all(void) const {
+    std::vector<std::int32_t> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_target_velocity(port));
+    return values;
+}
+
+double MotorGroup::get_actual_velocity(const std::uint8_t index) const {
+    return c::motor_get_actual_velocity(portAt(_ports, index));
+}
+
+std::vector<double> MotorGroup::get_actual_velocity_all(void) const {
+    std::vector<double> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_actual_velocity(port));
+    return values;
+}
+
+std::int32_t MotorGroup::get_current_draw(const std::uint8_t index) const {
+    return c::motor_get_current_draw(portAt(_ports, index));
+}
+
+std::vector<std::int32_t> MotorGroup::get_current_draw_all(void) const {
+    std::vector<std::int32_t> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_current_draw(port));
+    return values;
+}
+
+std::int32_t MotorGroup::get_direction(const std::uint8_t index) const {
+    return c::motor_get_direction(portAt(_ports, index));
+}
+
+std::vector<std::int32_t> MotorGroup::get_direction_all(void) const {
+    std::vector<std::int32_t> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_direction(port));
+    return values;
+}
+
+double MotorGroup::get_efficiency(const std::uint8_t index) const {
+    return c::motor_get_efficiency(portAt(_ports, index));
+}
+
+std::vector<double> MotorGroup::get_efficiency_all(void) const {
+    std::vector<double> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_efficiency(port));
+    return values;
+}
+
+std::uint32_t MotorGroup::get_faults(const std::uint8_t index) const {
+    return c::motor_get_faults(portAt(_ports, index));
+}
+
+std::vector<std::uint32_t> MotorGroup::get_faults_all(void) const {
+    std::vector<std::uint32_t> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_faults(port));
+    return values;
+}
+
+std::uint32_t MotorGroup::get_flags(const std::uint8_t index) const {
+    return c::motor_get_flags(portAt(_ports, index));
+}
+
+std::vector<std::uint32_t> MotorGroup::get_flags_all(void) const {
+    std::vector<std::uint32_t> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_flags(port));
+    return values;
+}
+
+double MotorGroup::get_position(const std::uint8_t index) const {
+    return c::motor_get_position(portAt(_ports, index));
+}
+
+std::vector<double> MotorGroup::get_position_all(void) const {
+    std::vector<double> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_position(port));
+    return values;
+}
+
+double MotorGroup::get_power(const std::uint8_t index) const {
+    return c::motor_get_power(portAt(_ports, index));
+}
+
+std::vector<double> MotorGroup::get_power_all(void) const {
+    std::vector<double> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_power(port));
+    return values;
+}
+
+std::int32_t MotorGroup::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t index) const {
+    return c::motor_get_raw_position(portAt(_ports, index), timestamp);
+}
+
+std::vector<std::int32_t> MotorGroup::get_raw_position_all(std::uint32_t* const timestamp) const {
+    std::vector<std::int32_t> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_raw_position(port, timestamp));
+    return values;
+}
+
+double MotorGroup::get_temperature(const std::uint8_t index) const {
+    return c::motor_get_temperature(portAt(_ports, index));
+}
+
+std::vector<double> MotorGroup::get_temperature_all(void) const {
+    std::vector<double> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_temperature(port));
+    return values;
+}
+
+double MotorGroup::get_torque(const std::uint8_t index) const {
+    return c::motor_get_torque(portAt(_ports, index));
+}
+
+std::vector<double> MotorGroup::get_torque_all(void) const {
+    std::vector<double> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_torque(port));
+    return values;
+}
+
+std::int32_t MotorGroup::get_voltage(const std::uint8_t index) const {
+    return c::motor_get_voltage(portAt(_ports, index));
+}
+
+std::vector<std::int32_t> MotorGroup::get_voltage_all(void) const {
+    std::vector<std::int32_t> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_voltage(port));
+    return values;
+}
+
+std::int32_t MotorGroup::is_over_current(const std::uint8_t index) const {
+    return c::motor_is_over_current(portAt(_ports, index));
+}
+
+std::vector<std::int32_t> MotorGroup::is_over_current_all(void) const {
+    std::vector<std::int32_t> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_is_over_current(port));
+    return values;
+}
+
+std::int32_t MotorGroup::is_over_temp(const std::uint8_t index) const {
+    return c::motor_is_over_temp(portAt(_ports, index));
+}
+
+std::vector<std::int32_t> MotorGroup::is_over_temp_all(void) const {
+    std::vector<std::int32_t> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_is_over_temp(port));
+    return values;
+}
+
+MotorBrake MotorGroup::get_brake_mode(const std::uint8_t index) const {
+    return static_cast<MotorBrake>(c::motor_get_brake_mode(portAt(_ports, index)));
+}
+
+std::vector<MotorBrake> MotorGroup::get_brake_mode_all(void) const {
+    std::vector<MotorBrake> values;
+    for (std::int8_t port : _ports) values.push_back(static_cast<MotorBrake>(c::motor_get_brake_mode(port)));
+    return values;
+}
+
+std::int32_t MotorGroup::get_current_limit(const std::uint8_t index) const {
+    return c::motor_get_current_limit(portAt(_ports, index));
+}
+
+std::vector<std::int32_t> MotorGroup::get_current_limit_all(void) const {
+    std::vector<std::int32_t> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_current_limit(port));
+    return values;
+}
+
+MotorUnits MotorGroup::get_encoder_units(const std::uint8_t index) const {
+    return static_cast<MotorUnits>(c::motor_get_encoder_units(portAt(_ports, index)));
+}
+
+std::vector<MotorUnits> MotorGroup::get_encoder_units_all(void) const {
+    std::vector<MotorUnits> values;
+    for (std::int8_t port : _ports) values.push_back(static_cast<MotorUnits>(c::motor_get_encoder_units(port)));
+    return values;
+}
+
+MotorGears MotorGroup::get_gearing(const std::uint8_t index) const {
+    return static_cast<MotorGears>(c::motor_get_gearing(portAt(_ports, index)));
+}
+
+std::vector<MotorGears> MotorGroup::get_gearing_all(void) const {
+    std::vector<MotorGears> values;
+    for (std::int8_t port : _ports) values.push_back(static_cast<MotorGears>(c::motor_get_gearing(port)));
+    return values;
+}
+
+std::int32_t MotorGroup::get_voltage_limit(const std::uint8_t index) const {
+    return c::motor_get_voltage_limit(portAt(_ports, index));
+}
+
+std::vector<std::int32_t> MotorGroup::get_voltage_limit_all(void) const {
+    std::vector<std::int32_t> values;
+    for (std::int8_t port : _ports) values.push_back(c::motor_get_voltage_limit(port));
+    return values;
+}
+
+MotorType MotorGroup::get_type(const std::uint8_t index) const {
+    return static_cast<MotorType>(c::motor_get_type(portAt(_ports, index)));
+}
+
+std::vector<MotorType> MotorGroup::get_type_all(void) const {
+    std::vector<MotorType> values;
+    for (std::int8_t port : _ports) values.push_back(static_cast<MotorType>(c::motor_get_type(port)));
+    return values;
+}
+
+std::int32_t MotorGroup::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const {
+    return c::motor_set_brake_mode(portAt(_ports, index), static_cast<motor_brake_mode_e_t>(mode));
+}
+
+std::int32_t MotorGroup::set_brake_mode_all(const MotorBrake mode) const {
+    for (std::int8_t port : _ports) c::motor_set_brake_mode(port, static_cast<motor_brake_mode_e_t>(mode));
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_brake_mode(const pros::motor_brake_mode_e_t mode, const std::uint8_t index) const {
+    return c::motor_set_brake_mode(portAt(_ports, index), mode);
+}
+
+std::int32_t MotorGroup::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const {
+    for (std::int8_t port : _ports) c::motor_set_brake_mode(port, mode);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_current_limit(const std::int32_t limit, const std::uint8_t index) const {
+    return c::motor_set_current_limit(portAt(_ports, index), limit);
+}
+
+std::int32_t MotorGroup::set_current_limit_all(const std::int32_t limit) const {
+    for (std::int8_t port : _ports) c::motor_set_current_limit(port, limit);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_encoder_units(const MotorUnits units, const std::uint8_t index) const {
+    return c::motor_set_encoder_units(portAt(_ports, index), static_cast<motor_encoder_units_e_t>(units));
+}
+
+std::int32_t MotorGroup::set_encoder_units_all(const MotorUnits units) const {
+    for (std::int8_t port : _ports) c::motor_set_encoder_units(port, static_cast<motor_encoder_units_e_t>(units));
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_encoder_units(const pros::motor_encoder_units_e_t units, const std::uint8_t index) const {
+    return c::motor_set_encoder_units(portAt(_ports, index), units);
+}
+
+std::int32_t MotorGroup::set_encoder_units_all(const pros::motor_encoder_units_e_t units) const {
+    for (std::int8_t port : _ports) c::motor_set_encoder_units(port, units);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_gearing(const MotorGears gearset, const std::uint8_t index) const {
+    return c::motor_set_gearing(portAt(_ports, index), static_cast<motor_gearset_e_t>(gearset));
+}
+
+std::int32_t MotorGroup::set_gearing_all(const MotorGears gearset) const {
+    for (std::int8_t port : _ports) c::motor_set_gearing(port, static_cast<motor_gearset_e_t>(gearset));
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_gearing(const pros::motor_gearset_e_t gearset, const std::uint8_t index) const {
+    return c::motor_set_gearing(portAt(_ports, index), gearset);
+}
+
+std::int32_t MotorGroup::set_gearing_all(const pros::motor_gearset_e_t gearset) const {
+    for (std::int8_t port : _ports) c::motor_set_gearing(port, gearset);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_voltage_limit(const std::int32_t limit, const std::uint8_t index) const {
+    return c::motor_set_voltage_limit(portAt(_ports, index), limit);
+}
+
+std::int32_t MotorGroup::set_voltage_limit_all(const std::int32_t limit) const {
+    for (std::int8_t port : _ports) c::motor_set_voltage_limit(port, limit);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::set_zero_position(const double position, const std::uint8_t index) const {
+    return c::motor_set_zero_position(portAt(_ports, index), position);
+}
+
+std::int32_t MotorGroup::set_zero_position_all(const double position) const {
+    for (std::int8_t port : _ports) c::motor_set_zero_position(port, position);
+    return PROS_SUCCESS;
+}
+
+std::int32_t MotorGroup::tare_position(const std::uint8_t index) const {
+    return c::motor_tare_position(portAt(_ports, index));
+}
+
+std::int32_t MotorGroup::tare_position_all(void) const {
+    for (std::int8_t port : _ports) c::motor_tare_position(port);
+    return PROS_SUCCESS;
+}
+} // namespace pros::inline v5
@@ -0,0 +1,280 @@
+// The PROS RTOS, running on the simulation's scheduler instead of FreeRTOS
+#include <cstring>
+#include <deque>
+#include <vector>
+#include "pros/apix.h"
+#include "pros/rtos.hpp"
+#include "sim/scheduler.hpp"
+
+using tiger::sim::scheduler;
+
+static tiger::sim::Task* toTask(pros::task_t task) {
+    // PROS uses nullptr for the current task
+    return task == nullptr ? scheduler().current() : static_cast<tiger::sim::Task*>(task);
+}
+
+static tiger::sim::Mutex* toMutex(pros::mutex_t mutex) { return static_cast<tiger::sim::Mutex*>(mutex); }
+
+namespace {
+/**
+ * @brief A FreeRTOS queue: a fixed number of fixed size items, copied in and out
+ */
+struct Queue {
+        uint32_t length;
+        uint32_t itemSize;
+        std::deque<std::vector<uint8_t>> items;
+};
+} // namespace
+
+static Queue* toQueue(pros::c::queue_t queue) { return static_cast<Queue*>(queue); }
+
+/**
+ * @brief Wait until the condition holds or the timeout runs out, checking every simulated millisecond
+ *
+ * Only sleeps when it has to, so a timeout of 0 works outside the simulation's tasks too.
+ */
+template <typename F> static bool waitFor(F condition, uint32_t timeout) {
+    const uint64_t end = scheduler().now() + uint64_t(timeout) * 1000;
+    while (!condition()) {
+        if (timeout != TIMEOUT_MAX && scheduler().now() >= end) return false;
+        scheduler().sleepUntil(scheduler().now() + 1000);
+    }
+    return true;
+}
+
+/**
+ * @brief Copy an item into the front or the back of a queue, once there's room
+ */
+static bool insert(pros::c::queue_t queue, const void* item, uint32_t timeout, bool front) {
+    Queue* q = toQueue(queue);
+    if (!waitFor([q] { return q->items.size() < q->length; }, timeout)) return false;
+    const uint8_t* bytes = static_cast<const uint8_t*>(item);
+    std::vector<uint8_t> copy(bytes, bytes + q->itemSize);
+    if (front) q->items.push_front(std::move(copy));
+    else q->items.push_back(std::move(copy));
+    return true;
+}
+
+namespace pros::c {
+uint32_t millis(void) { return scheduler().now() / 1000; }
+
+uint64_t micros(void) { return scheduler().now(); }
+
+task_t task_create(task_fn_t function, void* const parameters, uint32_t prio, const uint16_t, const char* const name) {
+    return scheduler().create(function, parameters, prio, name);
+}
+
+void task_delete(task_t task) { scheduler().remove(toTask(task)); }
+
+void task_delay(const uint32_t milliseconds) { scheduler().sleepUntil(scheduler().now() + milliseconds * 1000ull); }
+
+void delay(const uint32_t milliseconds) { task_delay(milliseconds); }
+
+void task_delay_until(uint32_t* const prev_time, const uint32_t delta) {
+    *prev_time += delta;
+    scheduler().sleepUntil(*prev_time * 1000ull);
+}
+
+uint32_t task_get_priority(task_t task) { return toTask(task)->priority; }
+
+void task_set_priority(task_t task, uint32_t prio) { scheduler().setPriority(toTask(task), prio); }
+
+task_state_e_t task_get_state(task_t task) {
+    tiger::sim::Task* simTask = toTask(task);
+    if (simTask == scheduler().current()) return E_TASK_STATE_RUNNING;
+    switch (simTask->state) {
+        case tiger::sim::Task::State::READY: return E_TASK_STATE_READY;
+        case tiger::sim::Task::State::DELAYED:
+        case tiger::sim::Task::State::BLOCKED: return E_TASK_STATE_BLOCKED;
+        case tiger::sim::Task::State::SUSPENDED: return E_TASK_STATE_SUSPENDED;
+        case tiger::sim::Task::State::DELETED: return E_TASK_STATE_DELETED;
+    }
+    return E_TASK_STATE_INVALID;
+}
+
+void task_suspend(task_t task) { scheduler().suspend(toTask(task)); }
+
+void task_resume(task_t task) { scheduler().resume(toTask(task)); }
+
+uint32_t task_get_count(void) { return scheduler().getTaskCount(); }
+
+char* task_get_name(task_t task) { return toTask(task)->name.data(); }
+
+task_t task_get_by_name(const char* name) { return scheduler().find(name); }
+
+task_t task_get_current() { return scheduler().current(); }
+
+uint32_t task_notify(task_t task) { return scheduler().notify(toTask(task), 0, E_NOTIFY_ACTION_INCR, nullptr); }
+
+void task_join(task_t task) { scheduler().join(toTask(task)); }
+
+uint32_t task_notify_ext(task_t task, uint32_t value, notify_action_e_t action, uint32_t* prev_value) {
+    return scheduler().notify(toTask(task), value, action, prev_value);
+}
+
+uint32_t task_notify_take(bool clear_on_exit, uint32_t timeout) {
+    return scheduler().notifyTake(clear_on_exit, timeout);
+}
+
+bool task_notify_clear(task_t task) { return scheduler().notifyClear(toTask(task)); }
+
+mutex_t mutex_create(void) { return new tiger::sim::Mutex(); }
+
+bool mutex_take(mutex_t mutex, uint32_t timeout) { return scheduler().take(toMutex(mutex), timeout); }
+
+bool mutex_give(mutex_t mutex) { return scheduler().give(toMutex(mutex)); }
+
+mutex_t mutex_recursive_create(void) {
+    tiger::sim::Mutex* mutex = new tiger::sim::Mutex();
+    mutex->recursive = true;
+    return mutex;
+}
+
+bool mutex_recursive_take(mutex_t mutex, uint32_t timeout) { return scheduler().take(toMutex(mutex), timeout); }
+
+bool mutex_recursive_give(mutex_t mutex) { return scheduler().give(toMutex(mutex)); }
+
+void mutex_delete(mutex_t mutex) { delete toMutex(mutex); }
+
+queue_t queue_create(uint32_t length, uint32_t item_size) { return new Queue {length, item_size, {}}; }
+
+bool queue_prepend(queue_t queue, const void* item, uint32_t timeout) {
+    return insert(queue, item, timeout, true);
+}
+
+bool queue_append(queue_t queue, const void* item, uint32_t timeout) {
+    return insert(queue, item, timeout, false);
+}
+
+bool queue_peek(queue_t queue, void* const buffer, uint32_t timeout) {
+    Queue* q = toQueue(queue);
+    if (!waitFor([q] { return !q->items.empty(); }, timeout)) return false;
+    std::memcpy(buffer, q->items.front().data(), q->itemSize);
+    return true;
+}
+
+bool queue_recv(queue_t queue, void* const buffer, uint32_t timeout) {
+    if (!queue_peek(queue, buffer, timeout)) return false;
+    toQueue(queue)->items.pop_front();
+    return true;
+}
+
+uint32_t queue_get_waiting(const queue_t queue) { return toQueue(queue)->items.size(); }
+
+uint32_t queue_get_available(const queue_t queue) {
+    return toQueue(queue)->length - toQueue(queue)->items.size();
+}
+
+void queue_delete(queue_t queue) { delete toQueue(queue); }
+
+void queue_reset(queue_t queue) { toQueue(queue)->items.clear(); }
+} // namespace pros::c
+
+namespace pros {
+Task::Task(task_fn_t function, void* parameters, std::uint32_t prio, std::uint16_t stack_depth, const char* name)
+    : task(c::task_create(function, parameters, prio, stack_depth, name)) {}
+
+Task::Task(task_fn_t function, void* parameters, const char* name)
+    : Task(function, parameters, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name) {}
+
+Task::Task(task_t task) : task(task) {}
+
+Task Task::current() { return Task(c::task_get_current()); }
+
+Task& Task::operator=(task_t in) {
+    task = in;
+    return *this;
+}
+
+void Task::remove() { c::task_delete(task); }
+
+std::uint32_t Task::get_priority() { return c::task_get_priority(task); }
+
+void Task::set_priority(std::uint32_t prio) { c::task_set_priority(task, prio); }
+
+std::uint32_t Task::get_state() { return c::task_get_state(task); }
+
+void Task::suspend() { c::task_suspend(task); }
+
+void Task::resume() { c::task_resume(task); }
+
+const char* Task::get_name() { return c::task_get_name(task); }
+
+std::uint32_t Task::notify() { return c::task_notify(task); }
+
+void Task::join() { c::task_join(task); }
+
+std::uint32_t Task::notify_ext(std::uint32_t value, notify_action_e_t action, std::uint32_t* prev_value) {
+    return c::task_notify_ext(task, value, action, prev_value);
+}
+
+std::uint32_t Task::notify_take(bool clear_on_exit, std::uint32_t timeout) {
+    return c::task_notify_take(clear_on_exit, timeout);
+}
+
+bool Task::notify_clear() { return c::task_notify_clear(task); }
+
+void Task::delay(const std::uint32_t milliseconds) { c::task_delay(milliseconds); }
+
+void Task::delay_until(std::uint32_t* const prev_time, const std::uint32_t delta) {
+    c::task_delay_until(prev_time, delta);
+}
+
+std::uint32_t Task::get_count() { return c::task_get_count(); }
+
+Clock::time_point Clock::now() { return time_point(duration(c::millis())); }
+
+mutex_t Mutex::lazy_init() {
+    mutex_t current = mutex.load();
+    if (current != nullptr) return current;
+    mutex_t created = c::mutex_create();
+    if (mutex.compare_exchange_strong(current, created)) return created;
+    c::mutex_delete(created);
+    return current;
+}
+
+bool Mutex::take() { return c::mutex_take(lazy_init(), TIMEOUT_MAX); }
+
+bool Mutex::take(std::uint32_t timeout) { return c::mutex_take(lazy_init(), timeout); }
+
+bool Mutex::give() { return c::mutex_give(lazy_init()); }
+
+void Mutex::lock() {
+    while (!take(TIMEOUT_MAX));
+}
+
+void Mutex::unlock() { give(); }
+
+bool Mutex::try_lock() { return take(0); }
+
+Mutex::~Mutex() {
+    if (mutex.load() != nullptr) c::mutex_delete(mutex.load());
+}
+
+mutex_t RecursiveMutex::lazy_init() {
+    mutex_t current = mutex.load();
+    if (current != nullptr) return current;
+    mutex_t created = c::mutex_recursive_create();
+    if (mutex.compare_exchange_strong(current, created)) return created;
+    c::mutex_delete(created);
+    return current;
+}
+
+bool RecursiveMutex::take() { return c::mutex_recursive_take(lazy_init(), TIMEOUT_MAX); }
+
+bool RecursiveMutex::take(std::uint32_t timeout) { return c::mutex_recursive_take(lazy_init(), timeout); }
+
+bool RecursiveMutex::give() { return c::mutex_recursive_give(lazy_init()); }
+
+void RecursiveMutex::lock() {
+    while (!take(TIMEOUT_MAX));
+}
+
+void RecursiveMutex::unlock() { give(); }
+
+bool RecursiveMutex::try_lock() { return take(0); }
+
+RecursiveMutex::~RecursiveMutex() {
+    if (mutex.load() != nullptr) c::mutex_delete(mutex.load());
+}
+} // namespace pros
@@ -0,0 +1,423 @@
+// Replays a tiger::Recorder recording through the robot's odometry and controllers, on the host. The recorded tracking
+// wheel and IMU readings go through tiger::OdomIntegrator, the math the odometry task runs, with whatever wheel offsets
+// and wheel size are given, and the resulting poses are compared with the ones the robot had. With --target, the
+// lateral and angular lemlib::PID controllers are run along the replayed path toward a point, the way moveToPose
+// settles on its target, with the given gains and horizontal drift. With --fusion, the recording goes through
+// tiger::OdomFusion instead, the EKF tiger::Chassis::setFusion() turns on, which also reads the IMU's turn rate and
+// acceleration and the drivetrain's motor positions.
+// Nothing is simulated and there are no tasks, so a replay is deterministic and takes milliseconds for a whole match.
+// The controllers only see the recorded path: the output shows what they would have commanded, not where they would
+// have taken the robot. The simulator shows that.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "lemlib/pid.hpp"
+#include "lemlib/util.hpp"
+#include "tiger/chassis/fusion.hpp"
+#include "tiger/chassis/odom.hpp"
+#include "replay/recording.hpp"
+
+// millivolts of a full motor command
+static constexpr float FULL_VOLTAGE = 12000;
+
+struct Options {
+        const char* recording = nullptr;
+        /** where to write the traces to, or nullptr for none */
+        const char* output = nullptr;
+        /** columns of the tracking wheels, empty for none */
+        std::string vertical = "vertical";
+        std::string horizontal;
+        /** column of the IMU's rotation, empty for none */
+        std::string imu = "imu_rotation";
+        /** start of the names of the robot's pose columns */
+        std::string pose = "pose";
+        /** offsets from the tracking center, in inches */
+        float verticalOffset = 0;
+        float horizontalOffset = 0;
+        /** multiplies the wheel distances, for a wheel diameter that's off */
+        float wheelScale = 1;
+        /** part of the recording to replay, in milliseconds since the program started */
+        uint32_t from = 0;
+        uint32_t to = UINT32_MAX;
+        /** where the robot was measured to be at the end, if it was */
+        bool hasEnd = false;
+        lemlib::Pose end = {0, 0, 0};
+        /** target of the controllers, if there is one */
+        bool hasTarget = false;
+        lemlib::Pose target = {0, 0, 0};
+        float lateralGains[3] = {0, 0, 0};
+        float angularGains[3] = {0, 0, 0};
+        float horizontalDrift = 0;
+        float maxSpeed = 127;
+        /** what the drivetrain's motor groups are called in the recording */
+        std::string left = "left";
+        std::string right = "right";
+        /** whether to replay through the fusion filter instead of the odometry */
+        bool fusion = false;
+        /** the drivetrain: track width and wheel diameter in inches, the wheels' rpm and the cartridge's */
+        float trackWidth = 0;
+        float wheelDiameter = 0;
+        float wheelRpm = 0;
+        float cartridgeRpm = 600;
+};
+
+static void usage(const char* name) {
+    std::fprintf(stderr,
+                 "usage: %s RECORDING [options]\n"
+                 "  --output FILE            write the pose, error and controller traces to a CSV file\n"
+                 "  --from MS, --to MS       replay only this part of the recording\n"
+                 "odometry:\n"
+                 "  --vertical COLUMN        the vertical tracking wheel (default vertical)\n"
+                 "  --horizontal COLUMN      the horizontal tracking wheel (default none)\n"
+                 "  --imu COLUMN             the IMU's rotation, or none (default imu_rotation)\n"
+                 "  --vertical-offset IN     offset of the vertical wheel from the tracking center (default 0)\n"
+                 "  --horizontal-offset IN   offset of the horizontal wheel from the tracking center (default 0)\n"
+                 "  --wheel-scale X          multiply the wheel distances, like new diameter / old (default 1)\n"
+                 "  --pose NAME              the robot's pose columns to compare with (default pose)\n"
+                 "  --end X,Y,THETA          where the robot was measured to be at the end, theta in degrees\n"
+                 "controllers:\n"
+                 "  --target X,Y             run the controllers toward this point\n"
+                 "  --lateral KP,KI,KD       gains of the lateral controller\n"
+                 "  --angular KP,KI,KD       gains of the angular controller\n"
+                 "  --horizontal-drift X     limit speed on curves like moveToPose (default 0, no limit)\n"
+                 "  --max-speed X            out of 127 (default 127)\n"
+                 "  --drive LEFT,RIGHT       the drivetrain's motor groups in the recording (default left,right)\n"
+                 "fusion:\n"
+                 "  --fusion                 replay through the EKF instead of the odometry, with the IMU's turn rate\n"
+                 "                           and acceleration, and the drivetrain's motor positions\n"
+                 "  --drivetrain TRACK,DIAMETER,RPM\n"
+                 "                           track width and wheel diameter in inches, and the wheels' rpm\n"
+                 "  --cartridge RPM          rpm of the drivetrain's cartridges (default 600)\n",
+                 name);
+    std::exit(2);
+}
+
+/**
+ * @brief Parse comma separated numbers
+ *
+ * @return whether there were exactly count of them
+ */
+static bool parseNumbers(const char* text, float* numbers, int count) {
+    for (int i = 0; i < count; i++) {
+        char* end;
+        numbers[i] = std::strtof(text, &end);
+        if (end == text || *end != (i + 1 == count ? '\0' : ',')) return false;
+        text = end + 1;
+    }
+    return true;
+}
+
+static Options parse(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        auto value = [&] {
+            if (i + 1 >= argc) usage(argv[0]);
+            return argv[++i];
+        };
+        float numbers[3];
+        if (argv[i][0] != '-' && options.recording == nullptr) options.recording = argv[i];
+        else if (std::strcmp(argv[i], "--output") == 0) options.output = value();
+        else if (std::strcmp(argv[i], "--from") == 0) options.from = std::atoi(value());
+        else if (std::strcmp(argv[i], "--to") == 0) options.to = std::atoi(value());
+        else if (std::strcmp(argv[i], "--vertical") == 0) options.vertical = value();
+        else if (std::strcmp(argv[i], "--horizontal") == 0) options.horizontal = value();
+        else if (std::strcmp(argv[i], "--imu") == 0) {
+            options.imu = value();
+            if (options.imu == "none") options.imu.clear();
+        } else if (std::strcmp(argv[i], "--vertical-offset") == 0) options.verticalOffset = std::atof(value());
+        else if (std::strcmp(argv[i], "--horizontal-offset") == 0) options.horizontalOffset = std::atof(value());
+        else if (std::strcmp(argv[i], "--wheel-scale") == 0) options.wheelScale = std::atof(value());
+        else if (std::strcmp(argv[i], "--pose") == 0) options.pose = value();
+        else if (std::strcmp(argv[i], "--end") == 0) {
+            if (!parseNumbers(value(), numbers, 3)) usage(argv[0]);
+            options.hasEnd = true;
+            options.end = {numbers[0], numbers[1], lemlib::degToRad(numbers[2])};
+        } else if (std::strcmp(argv[i], "--target") == 0) {
+            if (!parseNumbers(value(), numbers, 2)) usage(argv[0]);
+            options.hasTarget = true;
+            options.target = {numbers[0], numbers[1], 0};
+        } else if (std::strcmp(argv[i], "--lateral") == 0) {
+            if (!parseNumbers(value(), options.lateralGains, 3)) usage(argv[0]);
+        } else if (std::strcmp(argv[i], "--angular") == 0) {
+            if (!parseNumbers(value(), options.angularGains, 3)) usage(argv[0]);
+        } else if (std::strcmp(argv[i], "--horizontal-drift") == 0) options.horizontalDrift = std::atof(value());
+        else if (std::strcmp(argv[i], "--max-speed") == 0) options.maxSpeed = std::atof(value());
+        else if (std::strcmp(argv[i], "--drive") == 0) {
+            const std::string sides = value();
+            const size_t comma = sides.find(',');
+            if (comma == std::string::npos) usage(argv[0]);
+            options.left = sides.substr(0, comma);
+            options.right = sides.substr(comma + 1);
+        } else if (std::strcmp(argv[i], "--fusion") == 0) options.fusion = true;
+        else if (std::strcmp(argv[i], "--drivetrain") == 0) {
+            if (!parseNumbers(value(), numbers, 3)) usage(argv[0]);
+            options.trackWidth = numbers[0];
+            options.wheelDiameter = numbers[1];
+            options.wheelRpm = numbers[2];
+        } else if (std::strcmp(argv[i], "--cartridge") == 0) options.cartridgeRpm = std::atof(value());
+        else usage(argv[0]);
+    }
+    if (options.recording == nullptr) usage(argv[0]);
+    return options;
+}
+
+/**
+ * @brief Find a column, or exit if it's missing
+ */
+static int require(const tiger::replay::Recording& recording, const std::string& name) {
+    const int column = recording.find(name);
+    if (column < 0) {
+        std::fprintf(stderr, "[replay] the recording has no %s column\n", name.c_str());
+        std::exit(1);
+    }
+    return column;
+}
+
+/**
+ * @brief Find the columns of a quantity of every motor in a group, like left_voltage0, left_voltage1, ...
+ */
+static std::vector<int> findMotors(const tiger::replay::Recording& recording, const std::string& group,
+                                   const char* quantity) {
+    std::vector<int> columns;
+    for (int column; (column = recording.find(group + "_" + quantity + std::to_string(columns.size()))) >= 0;)
+        columns.push_back(column);
+    return columns;
+}
+
+/**
+ * @brief Average a quantity of the motors of a group
+ */
+static float average(const tiger::replay::Recording& recording, size_t row, const std::vector<int>& columns) {
+    if (columns.empty()) return 0;
+    float sum = 0;
+    for (int column : columns) sum += recording.value(row, column);
+    return sum / columns.size();
+}
+
+/**
+ * @brief Statistics of an error trace
+ */
+struct ErrorStats {
+        double sumSquares = 0;
+        float max = 0;
+        size_t count = 0;
+
+        void add(float error) {
+            sumSquares += error * error;
+            max = std::max(max, std::fabs(error));
+            count++;
+        }
+
+        float getRms() const { return count == 0 ? 0 : std::sqrt(sumSquares / count); }
+};
+
+int main(int argc, char** argv) {
+    const Options options = parse(argc, argv);
+    tiger::replay::Recording recording;
+    std::string error;
+    if (!recording.load(options.recording, error)) {
+        std::fprintf(stderr, "[replay] %s\n", error.c_str());
+        return 1;
+    }
+    if (options.vertical.empty() && options.horizontal.empty() && !options.fusion) {
+        std::fprintf(stderr, "[replay] odometry needs a tracking wheel\n");
+        return 1;
+    }
+    if (options.fusion && (options.trackWidth <= 0 || options.wheelDiameter <= 0 || options.wheelRpm <= 0)) {
+        std::fprintf(stderr, "[replay] --fusion needs the --drivetrain\n");
+        return 1;
+    }
+    if (options.hasTarget && options.lateralGains[0] == 0 && options.angularGains[0] == 0) {
+        std::fprintf(stderr, "[replay] --target needs --lateral or --angular gains\n");
+        return 1;
+    }
+
+    // the robots have one vertical tracking wheel, so the second one is the drivetrain, and the IMU gives the heading
+    const int verticalColumn = options.vertical.empty() ? -1 : require(recording, options.vertical);
+    const int horizontalColumn = options.horizontal.empty() ? -1 : require(recording, options.horizontal);
+    const int imuColumn = options.imu.empty() ? -1 : require(recording, options.imu);
+    const int poseX = recording.find(options.pose + "_x");
+    const int poseY = recording.find(options.pose + "_y");
+    const int poseTheta = recording.find(options.pose + "_theta");
+    const bool hasPose = poseX >= 0 && poseY >= 0 && poseTheta >= 0;
+    const std::vector<int> leftVoltage = findMotors(recording, options.left, "voltage");
+    const std::vector<int> rightVoltage = findMotors(recording, options.right, "voltage");
+    tiger::OdomGeometry geometry;
+    geometry.vertical1Offset = options.verticalOffset;
+    geometry.vertical1Powered = verticalColumn < 0;
+    geometry.vertical2Powered = true;
+    geometry.hasHorizontal1 = horizontalColumn >= 0;
+    geometry.horizontal1Offset = options.horizontalOffset;
+    geometry.hasImu = imuColumn >= 0;
+    if (!geometry.hasImu && !options.fusion) {
+        std::fprintf(stderr, "[replay] odometry needs the IMU for the heading, with one tracking wheel per axis\n");
+        return 1;
+    }
+
+    // fusion reads the rest of the IMU's columns, named like the rotation's, and the drivetrain's motor positions
+    int imuRateColumn = -1, imuAccelXColumn = -1, imuAccelYColumn = -1;
+    std::vector<int> leftPosition, rightPosition;
+    tiger::FusionGeometry fusionGeometry;
+    const tiger::FusionSettings fusionSettings;
+    if (options.fusion) {
+        const std::string suffix = "_rotation";
+        if (imuColumn >= 0) {
+            if (!options.imu.ends_with(suffix)) {
+                std::fprintf(stderr, "[replay] --fusion needs the IMU columns of tiger::Recorder::addImu\n");
+                return 1;
+            }
+            const std::string imu = options.imu.substr(0, options.imu.size() - suffix.size());
+            imuRateColumn = require(recording, imu + "_rate");
+            imuAccelXColumn = require(recording, imu + "_accel_x");
+            imuAccelYColumn = require(recording, imu + "_accel_y");
+        }
+        leftPosition = findMotors(recording, options.left, "position");
+        rightPosition = findMotors(recording, options.right, "position");
+        if (leftPosition.empty() || rightPosition.empty()) {
+            std::fprintf(stderr, "[replay] the recording has no %s and %s motor positions\n", options.left.c_str(),
+                         options.right.c_str());
+            return 1;
+        }
+        fusionGeometry.verticalOffset = options.verticalOffset;
+        fusionGeometry.horizontalOffset = options.horizontalOffset;
+        fusionGeometry.trackWidth = options.trackWidth;
+    }
+    // inches the drivetrain travels per rotation of a motor, like lemlib::TrackingWheel
+    const float driveScale = M_PI * options.wheelDiameter * options.wheelRpm / options.cartridgeRpm;
+
+    FILE* output = nullptr;
+    if (options.output != nullptr) {
+        output = std::fopen(options.output, "w");
+        if (output == nullptr) {
+            std::perror(options.output);
+            return 1;
+        }
+        std::fprintf(output, "time_ms,x,y,theta,recorded_x,recorded_y,recorded_theta,position_error,heading_error");
+        if (options.hasTarget) {
+            std::fprintf(output, ",lateral_error,angular_error,lateral_out,angular_out,slip_limit,recorded_lateral,"
+                                 "recorded_angular");
+        }
+        std::fprintf(output, "\n");
+    }
+
+    const auto wallStart = std::chrono::steady_clock::now();
+    tiger::OdomIntegrator odom(geometry);
+    tiger::OdomFusion fusion(fusionGeometry, fusionSettings);
+    lemlib::PID lateralPID(options.lateralGains[0], options.lateralGains[1], options.lateralGains[2]);
+    lemlib::PID angularPID(options.angularGains[0], options.angularGains[1], options.angularGains[2]);
+    ErrorStats positionStats;
+    ErrorStats headingStats;
+    ErrorStats lateralStats;
+    ErrorStats angularStats;
+    size_t limited = 0;
+    size_t replayed = 0;
+    lemlib::Pose recorded = {0, 0, 0};
+    for (size_t row = 0; row < recording.size(); row++) {
+        const uint32_t time = recording.time(row);
+        if (time < options.from || time > options.to) continue;
+        tiger::OdomSample sample;
+        sample.time = uint64_t(time) * 1000;
+        if (verticalColumn >= 0) sample.vertical1 = recording.value(row, verticalColumn) * options.wheelScale;
+        if (horizontalColumn >= 0) sample.horizontal1 = recording.value(row, horizontalColumn) * options.wheelScale;
+        if (imuColumn >= 0) sample.imu = lemlib::degToRad(recording.value(row, imuColumn));
+        if (hasPose) {
+            recorded = {recording.value(row, poseX), recording.value(row, poseY),
+                        lemlib::degToRad(recording.value(row, poseTheta))};
+        }
+        // start where the robot thought it was, so the traces are comparable
+        if (replayed++ == 0) {
+            odom.setPose(recorded);
+            fusion.setPose(recorded);
+        }
+        if (options.fusion) {
+            tiger::FusionSample fusionSample;
+            fusionSample.time = sample.time;
+            fusionSample.vertical = sample.vertical1;
+            fusionSample.hasVertical = verticalColumn >= 0;
+            fusionSample.horizontal = sample.horizontal1;
+            fusionSample.hasHorizontal = horizontalColumn >= 0;
+            fusionSample.leftDrive = average(recording, row, leftPosition) * driveScale;
+            fusionSample.rightDrive = average(recording, row, rightPosition) * driveScale;
+            if (imuColumn >= 0) {
+                fusionSample.setImu(fusionSettings, sample.imu, recording.value(row, imuRateColumn),
+                                    recording.value(row, imuAccelXColumn), recording.value(row, imuAccelYColumn));
+            }
+            fusion.step(fusionSample);
+        } else {
+            odom.step(sample);
+        }
+        const lemlib::Pose pose = options.fusion ? fusion.getPose() : odom.getPose();
+        const float positionError = pose.distance(recorded);
+        const float headingError = lemlib::radToDeg(lemlib::angleError(pose.theta, recorded.theta));
+        if (hasPose) {
+            positionStats.add(positionError);
+            headingStats.add(headingError);
+        }
+        if (output != nullptr) {
+            std::fprintf(output, "%u,%.3f,%.3f,%.2f,%.3f,%.3f,%.2f,%.3f,%.2f", time, pose.x, pose.y,
+                         lemlib::radToDeg(pose.theta), recorded.x, recorded.y, lemlib::radToDeg(recorded.theta),
+                         positionError, headingError);
+        }
+        if (options.hasTarget) {
+            // the PID part of moveToPose once it's close, with the carrot point on the target
+            const lemlib::Pose standard(pose.x, pose.y, M_PI_2 - pose.theta);
+            const float angularError = lemlib::angleError(standard.theta, standard.angle(options.target));
+            const float lateralError = standard.distance(options.target) * std::cos(angularError);
+            float lateralOut = std::clamp(lateralPID.update(lateralError), -options.maxSpeed, options.maxSpeed);
+            const float angularOut =
+                std::clamp(angularPID.update(lemlib::radToDeg(angularError)), -options.maxSpeed, options.maxSpeed);
+            float slipLimit = options.maxSpeed;
+            if (options.horizontalDrift != 0) {
+                const float radius = 1 / std::fabs(lemlib::getCurvature(standard, options.target));
+                slipLimit = std::fmin(slipLimit, std::sqrt(options.horizontalDrift * radius * 9.8));
+            }
+            if (std::fabs(lateralOut) > slipLimit) limited++;
+            lateralOut = std::clamp(lateralOut, -slipLimit, slipLimit);
+            // what the robot commanded, in the same units
+            const float left = average(recording, row, leftVoltage) / FULL_VOLTAGE * 127;
+            const float right = average(recording, row, rightVoltage) / FULL_VOLTAGE * 127;
+            lateralStats.add(lateralOut - (left + right) / 2);
+            angularStats.add(angularOut - (left - right) / 2);
+            if (output != nullptr) {
+                std::fprintf(output, ",%.3f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f", lateralError,
+                             lemlib::radToDeg(angularError), lateralOut, angularOut, slipLimit, (left + right) / 2,
+                             (left - right) / 2);
+            }
+        }
+        if (output != nullptr) std::fprintf(output, "\n");
+    }
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    if (output != nullptr) std::fclose(output);
+    if (replayed == 0) {
+        std::fprintf(stderr, "[replay] no samples to replay\n");
+        return 1;
+    }
+
+    const lemlib::Pose pose = options.fusion ? fusion.getPose() : odom.getPose();
+    std::printf("[replay] %zu samples replayed%s in %.3f s", replayed, options.fusion ? " through the EKF" : "",
+                wall);
+    if (recording.getDropped() != 0) std::printf(", %u were dropped on the brain", recording.getDropped());
+    std::printf("\n[replay] replayed: x %.2f, y %.2f, theta %.2f\n", pose.x, pose.y, lemlib::radToDeg(pose.theta));
+    if (hasPose) {
+        std::printf("[replay] recorded: x %.2f, y %.2f, theta %.2f\n", recorded.x, recorded.y,
+                    lemlib::radToDeg(recorded.theta));
+        std::printf("[replay] from recorded: position rms %.3f in, max %.3f in; heading rms %.3f deg, max %.3f deg\n",
+                    positionStats.getRms(), positionStats.max, headingStats.getRms(), headingStats.max);
+    }
+    if (options.hasEnd) {
+        std::printf("[replay] from measured end: position %.3f in, heading %.3f deg\n", pose.distance(options.end),
+                    lemlib::radToDeg(lemlib::angleError(pose.theta, options.end.theta)));
+    }
+    if (options.hasTarget) {
+        std::printf("[replay] from recorded commands: lateral rms %.2f, angular rms %.2f, out of 127\n",
+                    lateralStats.getRms(), angularStats.getRms());
+        if (options.horizontalDrift != 0)
+            std::printf("[replay] horizontal drift limited lateral output in %zu samples\n", limited);
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+// Reads the format tiger::Recorder writes, described in tiger/log/recorder.hpp
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "replay/recording.hpp"
+
+// the only version there is so far
+static constexpr uint16_t VERSION = 1;
+
+namespace {
+struct FileHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t columns;
+        uint32_t blockRows;
+        uint32_t period;
+        uint32_t headerSize;
+        uint32_t blockSize;
+};
+
+struct BlockHeader {
+        char magic[4];
+        uint32_t sequence;
+        uint32_t rows;
+        uint32_t dropped;
+};
+} // namespace
+
+bool tiger::replay::Recording::load(const std::string& path, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "can't open " + path;
+        return false;
+    }
+    const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    FileHeader header;
+    if (data.size() < sizeof(header)) {
+        error = path + " is too short to be a recording";
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, "TREC", 4) != 0 || header.version != VERSION || header.headerSize > data.size() ||
+        header.blockSize < sizeof(BlockHeader) + (header.columns + 1) * sizeof(float) * header.blockRows) {
+        error = path + " isn't a recording this can read";
+        return false;
+    }
+
+    names.clear();
+    const char* name = data.data() + sizeof(header);
+    const std::string columns(name, strnlen(name, header.headerSize - sizeof(header)));
+    for (size_t start = 0; start < columns.size();) {
+        size_t end = columns.find(',', start);
+        if (end == std::string::npos) end = columns.size();
+        names.push_back(columns.substr(start, end - start));
+        start = end + 1;
+    }
+    if (names.size() != header.columns) {
+        error = path + " has " + std::to_string(names.size()) + " column names for " +
+                std::to_string(header.columns) + " columns";
+        return false;
+    }
+
+    period = header.period;
+    times.clear();
+    values.clear();
+    dropped = 0;
+    uint32_t sequence = 0;
+    for (size_t offset = header.headerSize; offset + header.blockSize <= data.size(); offset += header.blockSize) {
+        BlockHeader block;
+        std::memcpy(&block, data.data() + offset, sizeof(block));
+        if (std::memcmp(block.magic, "TBLK", 4) != 0 || block.sequence != sequence || block.rows > header.blockRows)
+            break;
+        // a column at a time in the file, a row at a time here
+        const char* blockTimes = data.data() + offset + sizeof(block);
+        const char* blockValues = blockTimes + sizeof(uint32_t) * header.blockRows;
+        for (uint32_t row = 0; row < block.rows; row++) {
+            uint32_t time;
+            std::memcpy(&time, blockTimes + sizeof(uint32_t) * row, sizeof(time));
+            times.push_back(time);
+            for (uint32_t column = 0; column < header.columns; column++) {
+                float value;
+                std::memcpy(&value, blockValues + sizeof(float) * (column * header.blockRows + row), sizeof(value));
+                values.push_back(value);
+            }
+        }
+        dropped = block.dropped;
+        sequence++;
+    }
+    return true;
+}
+
+int tiger::replay::Recording::find(const std::string& name) const {
+    for (size_t i = 0; i < names.size(); i++) {
+        if (names[i] == name) return i;
+    }
+    return -1;
+}
@@ -0,0 +1,241 @@
+// Runs checks of the tiger layer's motions and routines on a robot project's simulated robot, and fails if any of them
+// doesn't behave. The cases run one after another on the same robot, each starting from where the last one left it,
+// stopped, with the pose reset to the origin. Pass the names of cases to run only those.
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "lemlib/util.hpp"
+#include "tiger/chassis/chassis.hpp"
+#include "tiger/motion/queue.hpp"
+#include "tiger/task/action.hpp"
+#include "sim/lemlib.hpp"
+#include "sim/robot.hpp"
+#include "sim/scheduler.hpp"
+#include "sim/world.hpp"
+
+using tiger::sim::scheduler;
+using tiger::sim::world;
+
+// initialize() gets this much simulated time to return, in milliseconds
+static constexpr uint32_t INITIALIZE_TIMEOUT = 30000;
+// a case gets this much simulated time, in milliseconds
+static constexpr uint32_t CASE_TIMEOUT = 20000;
+// slowest the robot turns while it's still counted as spinning, in degrees per second
+static constexpr double SPINNING = 20;
+// how far an Action can finish from when it should, in milliseconds. A couple of runner ticks
+static constexpr int ACTION_SLACK = 25;
+
+namespace {
+/**
+ * @brief A check, run as a routine on the robot
+ */
+struct Case {
+        const char* name;
+        /** returns whether the case passed, after printing what it measured */
+        std::function<bool(tiger::Chassis& chassis)> run;
+};
+} // namespace
+
+/**
+ * @brief Wait for the robot to stop, and reset the pose to the origin
+ */
+static void reset(tiger::Chassis& chassis) {
+    chassis.cancelAllMotions();
+    while (std::fabs(world().getImuRate()) > 1) pros::delay(10);
+    pros::delay(200);
+    chassis.setPose(0, 0, 0);
+}
+
+/**
+ * @brief The queue every case shares. Its task never ends, so there's only ever one
+ */
+static tiger::MotionQueue& queue(tiger::Chassis& chassis) {
+    static tiger::MotionQueue queue(chassis);
+    return queue;
+}
+
+/**
+ * @brief Queue two turns, and measure how fast the robot is turning when the first one hands over to the second
+ *
+ * @return double the turn rate at the handover, in degrees per second clockwise
+ */
+static double turnHandover(tiger::Chassis& chassis, float first, float second) {
+    tiger::MotionQueue& motions = queue(chassis);
+    motions.turnToHeading(first, 1500);
+    motions.turnToHeading(second, 1500);
+    // the second turn leaves the queue as soon as the first one is done
+    while (motions.size() > 0) pros::delay(1);
+    const double rate = world().getImuRate();
+    const float heading = chassis.getPose().theta;
+    motions.waitUntilDone();
+    std::printf("[cases]   turns to %.0f then %.0f: handed over at %.1f deg turning %.1f deg/s, ended at %.1f deg\n",
+                first, second, heading, rate, chassis.getPose().theta);
+    return rate;
+}
+
+/**
+ * @brief A turn that has to reverse for the next turn settles first, instead of exiting early while still spinning
+ */
+static bool reversingTurns(tiger::Chassis& chassis) {
+    return std::fabs(turnHandover(chassis, 90, 45)) < SPINNING;
+}
+
+/**
+ * @brief A turn that keeps rotating the same way for the next turn still hands over its spin
+ */
+static bool continuingTurns(tiger::Chassis& chassis) { return turnHandover(chassis, 90, 135) > SPINNING; }
+
+/**
+ * @brief Drive 24 inches forward, from a stop at the origin
+ */
+static tiger::Action drive(tiger::Chassis& chassis) {
+    chassis.moveToPoint(0, 24, 3000);
+    co_await chassis.untilDone();
+}
+
+/**
+ * @brief Wait, as an Action of its own
+ */
+static tiger::Action wait(uint32_t delay) { co_await tiger::delayMs(delay); }
+
+/**
+ * @brief Drive and wait at the same time
+ */
+static tiger::Action driveAndWait(tiger::Chassis& chassis, uint32_t delay) {
+    co_await tiger::whenAll(drive(chassis), wait(delay));
+}
+
+/**
+ * @brief Run an Action to its end, from a stop at the origin
+ *
+ * @return int how long it took, in milliseconds
+ */
+static int timeAction(tiger::Chassis& chassis, tiger::Action action) {
+    reset(chassis);
+    const uint32_t start = pros::millis();
+    tiger::ActionRunner().run(std::move(action));
+    return pros::millis() - start;
+}
+
+/**
+ * @brief Actions in a whenAll() run at the same time, so it takes as long as the longest of them, not their sum
+ */
+static bool concurrentActions(tiger::Chassis& chassis) {
+    const int alone = timeAction(chassis, drive(chassis));
+    bool passed = true;
+    // a delay that ends while the robot is still driving, and one that outlasts the drive
+    for (const int delay : {alone / 2, alone * 2}) {
+        const int both = timeAction(chassis, driveAndWait(chassis, delay));
+        const int expected = std::max(alone, delay);
+        std::printf("[cases]   drive %d ms and delay %d ms: %d ms, expected %d ms\n", alone, delay, both, expected);
+        passed = passed && std::abs(both - expected) <= ACTION_SLACK;
+    }
+    return passed;
+}
+
+/**
+ * @brief Steps the nested Actions below go through, in the order they went through them
+ */
+static std::vector<const char*> steps;
+
+static tiger::Action inner(uint32_t delay) {
+    steps.push_back("inner start");
+    co_await tiger::delayMs(delay);
+    steps.push_back("inner end");
+}
+
+static tiger::Action middle(uint32_t delay) {
+    steps.push_back("middle start");
+    co_await inner(delay);
+    steps.push_back("middle end");
+}
+
+static tiger::Action outer(uint32_t delay) {
+    steps.push_back("outer start");
+    co_await middle(delay);
+    steps.push_back("outer end");
+}
+
+/**
+ * @brief An Action that awaits another one is resumed once that one finishes, however deeply they're nested
+ */
+static bool nestedActions(tiger::Chassis& chassis) {
+    static constexpr uint32_t DELAY = 300;
+    steps.clear();
+    const int elapsed = timeAction(chassis, outer(DELAY));
+    static const std::vector<std::string> EXPECTED = {"outer start", "middle start", "inner start",
+                                                      "inner end",   "middle end",   "outer end"};
+    std::printf("[cases]   took %d ms for a %u ms delay, went through", elapsed, DELAY);
+    for (size_t i = 0; i < steps.size(); i++) std::printf("%s %s", i == 0 ? "" : ",", steps[i]);
+    std::printf("\n");
+    const bool ordered = std::equal(steps.begin(), steps.end(), EXPECTED.begin(), EXPECTED.end());
+    return ordered && std::abs(elapsed - int(DELAY)) <= ACTION_SLACK;
+}
+
+static const std::vector<Case> CASES = {
+    {"reversing-turns", reversingTurns},
+    {"continuing-turns", continuingTurns},
+    {"concurrent-actions", concurrentActions},
+    {"nested-actions", nestedActions},
+};
+
+/**
+ * @brief Exit without running destructors. The tasks' threads are still waiting for their turn
+ */
+[[noreturn]] static void quit(int status) {
+    std::fflush(nullptr);
+    std::_Exit(status);
+}
+
+int main(int argc, char** argv) {
+    std::vector<const Case*> selected;
+    for (int i = 1; i < argc; i++) {
+        const Case* found = nullptr;
+        for (const Case& c : CASES)
+            if (std::strcmp(argv[i], c.name) == 0) found = &c;
+        if (found == nullptr) {
+            std::fprintf(stderr, "usage: %s [case...]\ncases:\n", argv[0]);
+            for (const Case& c : CASES) std::fprintf(stderr, "  %s\n", c.name);
+            return 2;
+        }
+        selected.push_back(found);
+    }
+    if (selected.empty())
+        for (const Case& c : CASES) selected.push_back(&c);
+
+    scheduler().setTickHook([](uint64_t) { world().step(0.001); });
+    if (!tiger::sim::runInitialize(INITIALIZE_TIMEOUT)) {
+        std::fprintf(stderr, "[cases] initialize() didn't return\n");
+        quit(1);
+    }
+    // lemlib::Chassis has no virtual functions to check the type with, but every robot here uses tiger::Chassis
+    tiger::Chassis* chassis = static_cast<tiger::Chassis*>(tiger::sim::getChassis());
+    if (chassis == nullptr) {
+        std::fprintf(stderr, "[cases] the robot has no chassis\n");
+        quit(1);
+    }
+
+    int failed = 0;
+    for (const Case* c : selected) {
+        std::printf("[cases] %s\n", c->name);
+        bool passed = false;
+        const bool finished = tiger::sim::runRoutine(
+            [&] {
+                reset(*chassis);
+                passed = c->run(*chassis);
+            },
+            CASE_TIMEOUT, c->name, false);
+        if (!finished) std::printf("[cases]   didn't finish in %u ms\n", CASE_TIMEOUT);
+        passed = passed && finished;
+        std::printf("[cases] %s %s\n", passed ? "PASS" : "FAIL", c->name);
+        if (!passed) failed++;
+    }
+    std::printf("[cases] %d of %zu failed\n", failed, selected.size());
+    quit(failed == 0 ? 0 : 1);
+}
@@ -0,0 +1,230 @@
+// Runs a robot project's autonomous routine on the simulated robot, as fast as the host can go.
+// initialize() and competition_initialize() run first, like on a field, then autonomous() runs until it returns and
+// every motion it started is done, or until the autonomous period is over. With --characterize, the robot's
+// tiger::Chassis measures its feedforward instead of running autonomous.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "pros/adi.h"
+#include "pros/rtos.h"
+#include "lemlib/chassis/odom.hpp"
+#include "tiger/chassis/chassis.hpp"
+#include "tiger/log/telemetry.hpp"
+#include "tiger/log/profiler.hpp"
+#include "sim/lemlib.hpp"
+#include "sim/robot.hpp"
+#include "sim/scheduler.hpp"
+#include "sim/world.hpp"
+
+extern "C" {
+void autonomous(void);
+}
+
+using tiger::sim::scheduler;
+using tiger::sim::world;
+
+// initialize() gets this much simulated time to return, in milliseconds
+static constexpr uint64_t INITIALIZE_TIMEOUT = 30000;
+// characterization gets this much simulated time, in milliseconds
+static constexpr uint32_t CHARACTERIZE_TIMEOUT = 60000;
+// bytes of telemetry the simulator buffers before it drops frames
+static constexpr size_t TELEMETRY_CAPACITY = 1 << 16;
+// bytes of task trace the simulator buffers before it drops events
+static constexpr size_t PROFILE_CAPACITY = 1 << 20;
+
+struct Options {
+        /** how long autonomous can run, in milliseconds */
+        uint32_t duration = 15000;
+        /** where to write the trace to, or nullptr for no trace */
+        const char* trace = nullptr;
+        /** milliseconds between trace rows */
+        uint32_t tracePeriod = 10;
+        /** where to write the robot's binary telemetry to, or nullptr to leave it off */
+        const char* telemetry = nullptr;
+        /** where to write the trace of every task's loop to, or nullptr to leave it off */
+        const char* profile = nullptr;
+        /** simulated seconds per real second, or 0 to run as fast as possible */
+        double rate = 0;
+        /** characterize the drivetrain instead of running autonomous */
+        bool characterize = false;
+        /** characterize turning instead of driving straight */
+        bool angular = false;
+};
+
+static void usage(const char* name) {
+    std::fprintf(stderr,
+                 "usage: %s [options]\n"
+                 "  --duration MS      how long autonomous can run (default 15000)\n"
+                 "  --trace FILE       write the robot's pose and drivetrain to a CSV file\n"
+                 "  --trace-period MS  time between trace rows (default 10)\n"
+                 "  --telemetry FILE   write the robot's binary telemetry to a file, for tools/telemetry2csv.py\n"
+                 "  --profile FILE     write a trace of every task's loop to a file, for tools/trace2json.py\n"
+                 "  --rate FACTOR      run at FACTOR times real time instead of as fast as possible\n"
+                 "  --characterize lateral|angular\n"
+                 "                     measure the drivetrain's feedforward instead of running autonomous\n"
+                 "  --mass KG          mass of the robot (default 6.8)\n"
+                 "  --traction MU      friction coefficient of the wheels (default 0.9)\n",
+                 name);
+    std::exit(2);
+}
+
+static Options parse(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        auto value = [&] {
+            if (i + 1 >= argc) usage(argv[0]);
+            return argv[++i];
+        };
+        if (std::strcmp(argv[i], "--duration") == 0) options.duration = std::atoi(value());
+        else if (std::strcmp(argv[i], "--trace") == 0) options.trace = value();
+        else if (std::strcmp(argv[i], "--trace-period") == 0) options.tracePeriod = std::max(1, std::atoi(value()));
+        else if (std::strcmp(argv[i], "--telemetry") == 0) options.telemetry = value();
+        else if (std::strcmp(argv[i], "--profile") == 0) options.profile = value();
+        else if (std::strcmp(argv[i], "--rate") == 0) options.rate = std::atof(value());
+        else if (std::strcmp(argv[i], "--characterize") == 0) {
+            const char* mode = value();
+            options.characterize = true;
+            options.angular = std::strcmp(mode, "angular") == 0;
+            if (!options.angular && std::strcmp(mode, "lateral") != 0) usage(argv[0]);
+        } else if (std::strcmp(argv[i], "--mass") == 0) world().settings.mass = std::atof(value());
+        else if (std::strcmp(argv[i], "--traction") == 0) world().settings.traction = std::atof(value());
+        else usage(argv[0]);
+    }
+    return options;
+}
+
+/**
+ * @brief Print a three wire port change, like a piston firing
+ */
+static void printAdi(uint8_t smartPort, uint8_t adiPort, int32_t value) {
+    const double time = scheduler().now() / 1e6;
+    const char letter = 'A' + adiPort - 1;
+    if (smartPort == INTERNAL_ADI_PORT) std::printf("[sim] %8.3f s: port %c = %d\n", time, letter, value);
+    else std::printf("[sim] %8.3f s: port %d%c = %d\n", time, smartPort, letter, value);
+}
+
+/**
+ * @brief Exit without running destructors. The tasks' threads are still waiting for their turn
+ */
+[[noreturn]] static void quit(int status) {
+    std::fflush(nullptr);
+    std::_Exit(status);
+}
+
+int main(int argc, char** argv) {
+    const Options options = parse(argc, argv);
+    FILE* trace = nullptr;
+    if (options.trace != nullptr) {
+        trace = std::fopen(options.trace, "w");
+        if (trace == nullptr) {
+            std::perror(options.trace);
+            return 1;
+        }
+        std::fprintf(trace, "t_ms,x,y,theta,odom_x,odom_y,odom_theta,left_volts,right_volts,left_speed,right_speed\n");
+    }
+
+    // the brain sends telemetry to the serial port, the simulator to a file
+    FILE* telemetryFile = nullptr;
+    std::shared_ptr<tiger::OutputBuffer> telemetry;
+    if (options.telemetry != nullptr) {
+        telemetryFile = std::fopen(options.telemetry, "wb");
+        if (telemetryFile == nullptr) {
+            std::perror(options.telemetry);
+            return 1;
+        }
+        telemetry = std::make_shared<tiger::OutputBuffer>(
+            [=](std::string_view frame) { std::fwrite(frame.data(), 1, frame.size(), telemetryFile); },
+            TELEMETRY_CAPACITY);
+        tiger::telemetry().setOutput(telemetry);
+    }
+    FILE* profileFile = nullptr;
+    std::shared_ptr<tiger::OutputBuffer> profile;
+    if (options.profile != nullptr) {
+        profileFile = std::fopen(options.profile, "w");
+        if (profileFile == nullptr) {
+            std::perror(options.profile);
+            return 1;
+        }
+        profile = std::make_shared<tiger::OutputBuffer>(
+            [=](std::string_view line) { std::fwrite(line.data(), 1, line.size(), profileFile); }, PROFILE_CAPACITY);
+        tiger::profiler().setTraceOutput(profile);
+    }
+
+    // the world steps every millisecond, and autonomous is traced from its start
+    uint64_t autonomousStart = UINT64_MAX;
+    scheduler().setTickHook([&](uint64_t time) {
+        world().step(0.001);
+        if (trace == nullptr || time < autonomousStart) return;
+        const uint64_t elapsed = (time - autonomousStart) / 1000;
+        if (elapsed % options.tracePeriod != 0) return;
+        const lemlib::Pose pose = world().getPose();
+        const lemlib::Pose odom = lemlib::getPose(true);
+        double leftVolts, rightVolts, leftSpeed, rightSpeed;
+        world().getSideVoltages(leftVolts, rightVolts);
+        world().getSideSpeeds(leftSpeed, rightSpeed);
+        std::fprintf(trace, "%llu,%.3f,%.3f,%.2f,%.3f,%.3f,%.2f,%.2f,%.2f,%.2f,%.2f\n", (unsigned long long)elapsed,
+                     pose.x, pose.y, pose.theta * 180 / M_PI, odom.x, odom.y, odom.theta * 180 / M_PI, leftVolts,
+                     rightVolts, leftSpeed, rightSpeed);
+    });
+    world().setAdiHook(printAdi);
+    scheduler().setRealTimeFactor(options.rate);
+    const auto wallStart = std::chrono::steady_clock::now();
+
+    if (!tiger::sim::runInitialize(INITIALIZE_TIMEOUT)) {
+        std::fprintf(stderr, "[sim] initialize() didn't return\n");
+        quit(1);
+    }
+
+    autonomousStart = scheduler().now();
+    bool finished;
+    tiger::Feedforward feedforward;
+    if (options.characterize) {
+        // lemlib::Chassis has no virtual functions to check the type with, but every robot here uses tiger::Chassis
+        tiger::Chassis* chassis = static_cast<tiger::Chassis*>(tiger::sim::getChassis());
+        if (chassis == nullptr) {
+            std::fprintf(stderr, "[sim] the robot has no chassis to characterize\n");
+            quit(1);
+        }
+        tiger::CharacterizeSettings settings;
+        settings.angular = options.angular;
+        finished = tiger::sim::runRoutine([&] { feedforward = chassis->characterize(settings); },
+                                          CHARACTERIZE_TIMEOUT, "characterize");
+    } else {
+        finished = tiger::sim::runRoutine(autonomous, options.duration, "autonomous");
+    }
+
+    const double simulated = (scheduler().now() - autonomousStart) / 1e6;
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    const lemlib::Pose pose = world().getPose();
+    const lemlib::Pose odom = lemlib::getPose(true);
+    const char* routine = options.characterize ? "characterization" : "autonomous";
+    if (finished) std::printf("[sim] %s finished after %.3f s\n", routine, simulated);
+    else std::printf("[sim] %s didn't finish in %.3f s\n", routine, simulated);
+    if (options.characterize && finished) {
+        std::printf("[sim] %s feedforward: kS %.3f, kV %.4f, kA %.4f\n", options.angular ? "angular" : "lateral",
+                    feedforward.kS, feedforward.kV, feedforward.kA);
+    }
+    std::printf("[sim] robot:    x %.2f, y %.2f, theta %.2f\n", pose.x, pose.y, pose.theta * 180 / M_PI);
+    std::printf("[sim] odometry: x %.2f, y %.2f, theta %.2f\n", odom.x, odom.y, odom.theta * 180 / M_PI);
+    std::printf("[sim] %.3f s simulated in %.3f s, %.0fx real time\n", scheduler().now() / 1e6, wall,
+                scheduler().now() / 1e6 / wall);
+    if (trace != nullptr) std::fclose(trace);
+    if (telemetry != nullptr) {
+        telemetry->flush();
+        if (telemetry->getDropped() != 0) std::printf("[sim] telemetry dropped %u frames\n", telemetry->getDropped());
+        std::fclose(telemetryFile);
+    }
+    if (profile != nullptr) {
+        profile->flush();
+        if (profile->getDropped() != 0) std::printf("[sim] profile dropped %u events\n", profile->getDropped());
+        std::fclose(profileFile);
+        for (const tiger::TaskStats& task : tiger::profiler().getStats()) {
+            std::printf("[sim] %-16s %5.2f%% cpu, %6.1f/s, run %5u us avg %5u us max, late %5u us max, %u overruns\n",
+                        task.name.c_str(), task.cpu * 100, task.rate, task.averageRun, task.maxRun, task.maxLate,
+                        task.overruns);
+        }
+    }
+    quit(finished ? 0 : 1);
+}
@@ -0,0 +1,45 @@
+#include "pros/rtos.h"
+#include "sim/robot.hpp"
+#include "sim/scheduler.hpp"
+
+extern "C" {
+void initialize(void);
+void competition_initialize(void);
+}
+
+namespace {
+/**
+ * @brief A routine, handed to its task
+ */
+struct Routine {
+        std::function<void()> function;
+        bool returned = false;
+};
+} // namespace
+
+bool tiger::sim::runInitialize(uint32_t timeout) {
+    bool initialized = false;
+    scheduler().setGroup(0);
+    scheduler().create(
+        [](void* done) {
+            initialize();
+            competition_initialize();
+            *static_cast<bool*>(done) = true;
+        },
+        &initialized, TASK_PRIORITY_DEFAULT, "initialize");
+    return scheduler().run([&] { return initialized; }, scheduler().now() + timeout * 1000ull);
+}
+
+bool tiger::sim::runRoutine(std::function<void()> routine, uint32_t duration, const char* name, bool waitForTasks) {
+    Routine state {routine};
+    scheduler().setGroup(1);
+    scheduler().create(
+        [](void* data) {
+            Routine* routine = static_cast<Routine*>(data);
+            routine->function();
+            routine->returned = true;
+        },
+        &state, TASK_PRIORITY_DEFAULT, name);
+    const uint64_t end = scheduler().now() + duration * 1000ull;
+    return scheduler().run([&] { return state.returned && (!waitForTasks || !scheduler().isRunning(1)); }, end);
+}
@@ -0,0 +1,305 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "pros/rtos.h"
+#include "sim/scheduler.hpp"
+
+tiger::sim::Scheduler& tiger::sim::scheduler() {
+    static Scheduler instance;
+    return instance;
+}
+
+tiger::sim::Task* tiger::sim::Scheduler::create(void (*function)(void*), void* parameters, uint32_t priority,
+                                                const char* name) {
+    std::unique_lock guard(lock);
+    Task* task = new Task();
+    task->name = name == nullptr ? "" : name;
+    task->priority = priority;
+    task->function = function;
+    task->parameters = parameters;
+    task->group = running != nullptr ? running->group : group;
+    tasks.push_back(task);
+    makeReady(task);
+    std::thread([this, task] {
+        {
+            std::unique_lock guard(lock);
+            task->resume.wait(guard, [&] { return running == task; });
+        }
+        task->function(task->parameters);
+        std::unique_lock guard(lock);
+        task->state = Task::State::DELETED;
+        running = nullptr;
+        idle.notify_one();
+    }).detach();
+    return task;
+}
+
+void tiger::sim::Scheduler::remove(Task* task) {
+    std::unique_lock guard(lock);
+    if (task->state == Task::State::DELETED) return;
+    task->state = Task::State::DELETED;
+    if (task != running) return;
+    // the thread of a deleted task waits forever, it can't be stopped from the outside either
+    running = nullptr;
+    idle.notify_one();
+    task->resume.wait(guard, [] { return false; });
+}
+
+tiger::sim::Task* tiger::sim::Scheduler::current() {
+    std::unique_lock guard(lock);
+    return running;
+}
+
+uint64_t tiger::sim::Scheduler::now() {
+    std::unique_lock guard(lock);
+    return time;
+}
+
+void tiger::sim::Scheduler::sleepUntil(uint64_t wakeTime) {
+    std::unique_lock guard(lock);
+    Task* task = running;
+    if (task == nullptr) {
+        std::fprintf(stderr, "sim: tried to delay outside of a task\n");
+        std::abort();
+    }
+    if (wakeTime <= time) makeReady(task);
+    else {
+        task->state = Task::State::DELAYED;
+        task->wakeTime = wakeTime;
+    }
+    yield(guard, task);
+}
+
+bool tiger::sim::Scheduler::take(Mutex* mutex, uint32_t timeout) {
+    std::unique_lock guard(lock);
+    Task* task = running;
+    if (mutex->count == 0) {
+        mutex->owner = task;
+        mutex->count = 1;
+        return true;
+    }
+    if (mutex->recursive && mutex->owner == task) {
+        mutex->count++;
+        return true;
+    }
+    // nothing can wait outside of a task
+    if (timeout == 0 || task == nullptr) return false;
+    task->state = Task::State::BLOCKED;
+    task->mutex = mutex;
+    task->timedOut = false;
+    task->wakeTime = timeout == TIMEOUT_MAX ? UINT64_MAX : time + uint64_t(timeout) * 1000;
+    yield(guard, task);
+    // give() hands the mutex over before waking the task up
+    return !task->timedOut;
+}
+
+bool tiger::sim::Scheduler::give(Mutex* mutex) {
+    std::unique_lock guard(lock);
+    if (mutex->count == 0 || mutex->owner != running) return false;
+    if (--mutex->count > 0) return true;
+    Task* next = nullptr;
+    for (Task* task : tasks) {
+        if (task->state != Task::State::BLOCKED || task->mutex != mutex) continue;
+        if (next == nullptr || task->priority > next->priority) next = task;
+    }
+    mutex->owner = next;
+    if (next == nullptr) return true;
+    mutex->count = 1;
+    next->mutex = nullptr;
+    makeReady(next);
+    return true;
+}
+
+uint32_t tiger::sim::Scheduler::notify(Task* task, uint32_t value, int action, uint32_t* previous) {
+    std::unique_lock guard(lock);
+    if (previous != nullptr) *previous = task->notifyValue;
+    switch (action) {
+        case pros::E_NOTIFY_ACTION_BITS: task->notifyValue |= value; break;
+        case pros::E_NOTIFY_ACTION_INCR: task->notifyValue++; break;
+        case pros::E_NOTIFY_ACTION_OWRITE: task->notifyValue = value; break;
+        case pros::E_NOTIFY_ACTION_NO_OWRITE:
+            if (task->notifyPending) return 0;
+            task->notifyValue = value;
+            break;
+        default: break;
+    }
+    task->notifyPending = true;
+    if (task->state == Task::State::BLOCKED && task->waitingForNotify) {
+        task->waitingForNotify = false;
+        makeReady(task);
+    }
+    return 1;
+}
+
+uint32_t tiger::sim::Scheduler::notifyTake(bool clear, uint32_t timeout) {
+    std::unique_lock guard(lock);
+    Task* task = running;
+    if (task == nullptr) return 0;
+    if (task->notifyValue == 0 && timeout != 0) {
+        task->state = Task::State::BLOCKED;
+        task->waitingForNotify = true;
+        task->timedOut = false;
+        task->wakeTime = timeout == TIMEOUT_MAX ? UINT64_MAX : time + uint64_t(timeout) * 1000;
+        yield(guard, task);
+    }
+    const uint32_t value = task->notifyValue;
+    if (value != 0) task->notifyValue = clear ? 0 : value - 1;
+    task->notifyPending = false;
+    return value;
+}
+
+bool tiger::sim::Scheduler::notifyClear(Task* task) {
+    std::unique_lock guard(lock);
+    const bool pending = task->notifyPending;
+    task->notifyPending = false;
+    return pending;
+}
+
+void tiger::sim::Scheduler::suspend(Task* task) {
+    std::unique_lock guard(lock);
+    if (task->state == Task::State::DELETED) return;
+    task->state = Task::State::SUSPENDED;
+    if (task == running) yield(guard, task);
+}
+
+void tiger::sim::Scheduler::resume(Task* task) {
+    std::unique_lock guard(lock);
+    if (task->state == Task::State::SUSPENDED) makeReady(task);
+}
+
+void tiger::sim::Scheduler::setPriority(Task* task, uint32_t priority) {
+    std::unique_lock guard(lock);
+    task->priority = priority;
+}
+
+void tiger::sim::Scheduler::join(Task* task) {
+    // polling is good enough here, joining is rare and a millisecond of latency doesn't matter
+    while (true) {
+        {
+            std::unique_lock guard(lock);
+            if (task->state == Task::State::DELETED) return;
+        }
+        sleepUntil(now() + 1000);
+    }
+}
+
+uint32_t tiger::sim::Scheduler::getTaskCount() {
+    std::unique_lock guard(lock);
+    uint32_t count = 0;
+    for (Task* task : tasks)
+        if (task->state != Task::State::DELETED) count++;
+    return count;
+}
+
+tiger::sim::Task* tiger::sim::Scheduler::find(const char* name) {
+    std::unique_lock guard(lock);
+    for (Task* task : tasks)
+        if (task->state != Task::State::DELETED && task->name == name) return task;
+    return nullptr;
+}
+
+void tiger::sim::Scheduler::setGroup(int group) {
+    std::unique_lock guard(lock);
+    this->group = group;
+}
+
+bool tiger::sim::Scheduler::isRunning(int group) {
+    std::unique_lock guard(lock);
+    for (Task* task : tasks)
+        if (task->group == group && task->state != Task::State::DELETED) return true;
+    return false;
+}
+
+void tiger::sim::Scheduler::setTickHook(std::function<void(uint64_t)> hook) {
+    std::unique_lock guard(lock);
+    tickHook = hook;
+}
+
+void tiger::sim::Scheduler::setRealTimeFactor(double factor) {
+    std::unique_lock guard(lock);
+    realTimeFactor = factor;
+}
+
+bool tiger::sim::Scheduler::run(std::function<bool()> done, uint64_t endTime) {
+    std::unique_lock guard(lock);
+    while (true) {
+        // no task is running, so the condition can use the scheduler
+        guard.unlock();
+        const bool finished = done();
+        guard.lock();
+        if (finished) return true;
+
+        Task* next = pick();
+        if (next != nullptr) {
+            running = next;
+            next->resume.notify_one();
+            idle.wait(guard, [&] { return running == nullptr; });
+            continue;
+        }
+
+        // every task is blocked, so skip ahead to the next time one of them wakes up
+        if (time >= endTime) return false;
+        uint64_t wakeTime = UINT64_MAX;
+        for (Task* task : tasks) {
+            if (task->state != Task::State::DELAYED && task->state != Task::State::BLOCKED) continue;
+            if (task->wakeTime < wakeTime) wakeTime = task->wakeTime;
+        }
+        // nothing will ever wake up
+        if (wakeTime == UINT64_MAX) return false;
+        advance(guard, std::min(wakeTime, endTime));
+    }
+}
+
+void tiger::sim::Scheduler::yield(std::unique_lock<std::mutex>& guard, Task* task) {
+    running = nullptr;
+    idle.notify_one();
+    task->resume.wait(guard, [&] { return running == task; });
+}
+
+void tiger::sim::Scheduler::makeReady(Task* task) {
+    task->state = Task::State::READY;
+    task->wakeTime = 0;
+    task->readyOrder = readyCounter++;
+}
+
+tiger::sim::Task* tiger::sim::Scheduler::pick() {
+    Task* next = nullptr;
+    for (Task* task : tasks) {
+        // wake up tasks whose delay or timeout is over
+        if ((task->state == Task::State::DELAYED || task->state == Task::State::BLOCKED) && task->wakeTime <= time) {
+            if (task->state == Task::State::BLOCKED) task->timedOut = true;
+            task->mutex = nullptr;
+            task->waitingForNotify = false;
+            makeReady(task);
+        }
+    }
+    for (Task* task : tasks) {
+        if (task->state != Task::State::READY) continue;
+        if (next == nullptr || task->priority > next->priority ||
+            (task->priority == next->priority && task->readyOrder < next->readyOrder))
+            next = task;
+    }
+    return next;
+}
+
+void tiger::sim::Scheduler::advance(std::unique_lock<std::mutex>& guard, uint64_t target) {
+    using Clock = std::chrono::steady_clock;
+    static const Clock::time_point wallStart = Clock::now();
+    static const uint64_t simStart = time;
+    while (time < target) {
+        time += 1000;
+        if (tickHook) {
+            // no task is running, so the hook can use the scheduler
+            guard.unlock();
+            tickHook(time);
+            guard.lock();
+        }
+        if (realTimeFactor > 0) {
+            const auto wallTime = std::chrono::microseconds(uint64_t((time - simStart) / realTimeFactor));
+            guard.unlock();
+            std::this_thread::sleep_until(wallStart + wallTime);
+            guard.lock();
+        }
+    }
+}
@@ -0,0 +1,259 @@
+// Tunes a robot project's lateral or angular PID gains on the simulated robot. A relay test gives starting gains,
+// then two rounds of candidates around them are scored with step trials there and back. Every run gets its own
+// process, forked before the simulation starts any threads, so they all start from the same freshly initialized
+// robot and run in parallel on every core.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "tiger/chassis/chassis.hpp"
+#include "sim/lemlib.hpp"
+#include "sim/robot.hpp"
+#include "sim/scheduler.hpp"
+#include "sim/world.hpp"
+
+using tiger::sim::scheduler;
+using tiger::sim::world;
+
+// initialize() gets this much simulated time to return, in milliseconds
+static constexpr uint32_t INITIALIZE_TIMEOUT = 30000;
+// a run gets this much simulated time, in milliseconds
+static constexpr uint32_t RUN_TIMEOUT = 60000;
+// how many of the best candidates are printed
+static constexpr size_t SHOWN = 5;
+
+struct Options {
+        tiger::TuneSettings settings;
+        /** how many runs at once */
+        unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+};
+
+/**
+ * @brief A set of gains, and how they did
+ */
+struct Candidate {
+        float kP = 0;
+        float kD = 0;
+        float score = INFINITY;
+        tiger::TuneTrial forwards;
+        tiger::TuneTrial backwards;
+};
+
+static void usage(const char* name) {
+    std::fprintf(stderr,
+                 "usage: %s [options]\n"
+                 "  --angular          tune the angular controller instead of the lateral one\n"
+                 "  --jobs N           runs at once (default: one per core)\n"
+                 "  --step X           size of the step trials, in inches or degrees (default 24 or 90)\n"
+                 "  --tolerance X      how close counts as settled, in inches or degrees (default 1)\n"
+                 "  --trial-time MS    length of each step trial (default 2000)\n"
+                 "  --mass KG          mass of the robot (default 6.8)\n"
+                 "  --traction MU      friction coefficient of the wheels (default 0.9)\n",
+                 name);
+    std::exit(2);
+}
+
+static Options parse(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        auto value = [&] {
+            if (i + 1 >= argc) usage(argv[0]);
+            return argv[++i];
+        };
+        if (std::strcmp(argv[i], "--angular") == 0) options.settings.angular = true;
+        else if (std::strcmp(argv[i], "--jobs") == 0) options.jobs = std::max(1, std::atoi(value()));
+        else if (std::strcmp(argv[i], "--step") == 0) options.settings.step = std::atof(value());
+        else if (std::strcmp(argv[i], "--tolerance") == 0) options.settings.tolerance = std::atof(value());
+        else if (std::strcmp(argv[i], "--trial-time") == 0) options.settings.trialTime = std::atoi(value());
+        else if (std::strcmp(argv[i], "--mass") == 0) world().settings.mass = std::atof(value());
+        else if (std::strcmp(argv[i], "--traction") == 0) world().settings.traction = std::atof(value());
+        else usage(argv[0]);
+    }
+    return options;
+}
+
+/**
+ * @brief Get the robot's chassis
+ *
+ * lemlib::Chassis has no virtual functions to check the type with, but every robot here uses tiger::Chassis.
+ */
+static tiger::Chassis* getChassis() {
+    tiger::Chassis* chassis = static_cast<tiger::Chassis*>(tiger::sim::getChassis());
+    if (chassis == nullptr) {
+        std::fprintf(stderr, "[tune] the robot has no chassis to tune\n");
+        std::exit(1);
+    }
+    return chassis;
+}
+
+/**
+ * @brief Runs jobs on freshly initialized robots, each in its own process
+ *
+ * A job writes its result as a T. The parent process never starts the simulation, so it has no threads to lose when
+ * it forks.
+ */
+template <typename T> class Runner {
+    public:
+        explicit Runner(unsigned jobs) : jobs(jobs) {}
+
+        /**
+         * @brief Run every job, at most jobs at a time
+         *
+         * @param count how many jobs
+         * @param job the job, given its index. Runs in a task on the initialized robot, and returns its result
+         * @return std::vector<T> the results, in order. A job that didn't finish gives a default T
+         */
+        std::vector<T> run(size_t count, std::function<T(size_t)> job) {
+            std::vector<T> results(count);
+            // the read end of each running job's pipe, by process
+            std::map<pid_t, std::pair<int, size_t>> running;
+            size_t next = 0;
+            while (next < count || !running.empty()) {
+                if (next < count && running.size() < jobs) {
+                    int fds[2];
+                    if (pipe(fds) != 0) {
+                        std::perror("pipe");
+                        std::exit(1);
+                    }
+                    // anything buffered would be written again by the child
+                    std::fflush(nullptr);
+                    const pid_t pid = fork();
+                    if (pid == 0) {
+                        close(fds[0]);
+                        child(fds[1], [&] { return job(next); });
+                    }
+                    close(fds[1]);
+                    running[pid] = {fds[0], next++};
+                    continue;
+                }
+                int status;
+                const pid_t pid = wait(&status);
+                const auto found = running.find(pid);
+                if (found == running.end()) continue;
+                auto [fd, index] = found->second;
+                T result;
+                if (read(fd, &result, sizeof(result)) == sizeof(result)) results[index] = result;
+                close(fd);
+                running.erase(found);
+            }
+            return results;
+        }
+    private:
+        /**
+         * @brief Initialize the robot, run a job and write its result
+         */
+        [[noreturn]] static void child(int fd, std::function<T()> job) {
+            // nothing is printed, the parent reports the results
+            if (std::freopen("/dev/null", "w", stdout) == nullptr) std::_Exit(1);
+            scheduler().setTickHook([](uint64_t) { world().step(0.001); });
+            if (!tiger::sim::runInitialize(INITIALIZE_TIMEOUT)) std::_Exit(1);
+            T result;
+            if (!tiger::sim::runRoutine([&] { result = job(); }, RUN_TIMEOUT, "tune")) std::_Exit(1);
+            if (write(fd, &result, sizeof(result)) != sizeof(result)) std::_Exit(1);
+            // the tasks' threads are still waiting for their turn, so skip destructors
+            std::_Exit(0);
+        }
+
+        unsigned jobs;
+};
+
+/**
+ * @brief Score every candidate
+ */
+static void evaluate(std::vector<Candidate>& candidates, const Options& options,
+                     const lemlib::ControllerSettings& base) {
+    Runner<Candidate> runner(options.jobs);
+    candidates = runner.run(candidates.size(), [&](size_t index) {
+        Candidate candidate = candidates[index];
+        tiger::Chassis* chassis = getChassis();
+        lemlib::ControllerSettings gains = base;
+        gains.kP = candidate.kP;
+        gains.kD = candidate.kD;
+        if (options.settings.angular) chassis->setAngularSettings(gains);
+        else chassis->setLateralSettings(gains);
+        candidate.forwards = chassis->runTuneTrial(options.settings, 1);
+        candidate.backwards = chassis->runTuneTrial(options.settings, -1);
+        candidate.score = (tiger::getTuneScore(candidate.forwards, options.settings) +
+                           tiger::getTuneScore(candidate.backwards, options.settings)) /
+                          2;
+        return candidate;
+    });
+}
+
+/**
+ * @brief Candidates on a grid of scales around a set of gains
+ */
+static std::vector<Candidate> grid(float kP, float kD, const std::vector<float>& scales) {
+    std::vector<Candidate> candidates;
+    for (float kPScale : scales) {
+        for (float kDScale : scales) {
+            Candidate candidate;
+            candidate.kP = kP * kPScale;
+            candidate.kD = kD * kDScale;
+            candidates.push_back(candidate);
+        }
+    }
+    return candidates;
+}
+
+static void print(const Candidate& candidate) {
+    std::printf("  kP %8.3f  kD %8.3f  score %6.3f  settled %5.2f s / %5.2f s  overshoot %5.2f / %5.2f  "
+                "chatter %6.1f / %6.1f V/s\n",
+                candidate.kP, candidate.kD, candidate.score, candidate.forwards.settleTime,
+                candidate.backwards.settleTime, candidate.forwards.overshoot, candidate.backwards.overshoot,
+                candidate.forwards.chatter, candidate.backwards.chatter);
+}
+
+int main(int argc, char** argv) {
+    const Options options = parse(argc, argv);
+    const char* controller = options.settings.angular ? "angular" : "lateral";
+    tiger::Chassis* chassis = getChassis();
+    const lemlib::ControllerSettings base =
+        options.settings.angular ? chassis->getAngularSettings() : chassis->getLateralSettings();
+
+    // the current gains, for comparison
+    std::vector<Candidate> current(1);
+    current[0].kP = base.kP;
+    current[0].kD = base.kD;
+    evaluate(current, options, base);
+    std::printf("[tune] current %s gains:\n", controller);
+    print(current[0]);
+
+    Runner<tiger::RelayResult> relayRunner(1);
+    const tiger::RelayResult relay =
+        relayRunner.run(1, [&](size_t) { return getChassis()->runRelayTest(options.settings); })[0];
+    lemlib::ControllerSettings start = tiger::getRelayGains(relay, base);
+    if (relay.isValid()) {
+        std::printf("[tune] relay test: ultimate gain %.3f, period %.3f s, amplitude %.2f\n", relay.ultimateGain,
+                    relay.ultimatePeriod, relay.amplitude);
+    } else {
+        std::printf("[tune] relay test didn't oscillate, searching around the current gains\n");
+    }
+    if (start.kD <= 0) start.kD = start.kP;
+
+    // a coarse round over a wide range, then a fine round around the best of it
+    std::vector<Candidate> candidates = grid(start.kP, start.kD, {0.35, 0.5, 0.71, 1, 1.41, 2, 2.83});
+    evaluate(candidates, options, base);
+    auto better = [](const Candidate& a, const Candidate& b) { return a.score < b.score; };
+    const Candidate coarse = *std::min_element(candidates.begin(), candidates.end(), better);
+    std::vector<Candidate> fine = grid(coarse.kP, coarse.kD, {0.71, 0.84, 1, 1.19, 1.41});
+    evaluate(fine, options, base);
+    candidates.insert(candidates.end(), fine.begin(), fine.end());
+    std::sort(candidates.begin(), candidates.end(), better);
+
+    std::printf("[tune] best of %zu candidates, %u at a time:\n", candidates.size(), options.jobs);
+    for (size_t i = 0; i < std::min(SHOWN, candidates.size()); i++) print(candidates[i]);
+    const Candidate& best = candidates.front();
+    std::printf("lemlib::ControllerSettings %sController(%g, %g, %g, %g, %g, %g, %g, %g, %g);\n",
+                options.settings.angular ? "angular" : "linear", best.kP, base.kI, best.kD, base.windupRange,
+                base.smallError, base.smallErrorTimeout, base.largeError, base.largeErrorTimeout, base.slew);
+    return best.score <= current[0].score ? 0 : 1;
+}
@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <cmath>
+#include "sim/world.hpp"
+
+// inches in a meter
+static constexpr double METER = 39.3701;
+static constexpr double GRAVITY = 9.81;
+// the V5 motor's current limit at full power, in milliamps
+static constexpr double MAX_CURRENT = 2500;
+// volts per rpm of velocity error, as a fraction of 12V per free speed. Stiff, like the motor's own controller
+static constexpr double VELOCITY_GAIN = 3;
+// rpm per rotation of position error, as a fraction of free speed
+static constexpr double POSITION_GAIN = 2;
+// volts per rotation of position error in the hold brake mode
+static constexpr double HOLD_GAIN = 240;
+// how long a motor that isn't on the drivetrain takes to spin up, in seconds
+static constexpr double FREE_SPIN_UP = 0.05;
+// friction of a motor that isn't on the drivetrain, as a fraction of its stall torque
+static constexpr double FREE_FRICTION = 0.02;
+
+double tiger::sim::MotorState::getFreeSpeed() const {
+    switch (gearset) {
+        case pros::E_MOTOR_GEARSET_36: return 100;
+        case pros::E_MOTOR_GEARSET_06: return 600;
+        default: return 200;
+    }
+}
+
+double tiger::sim::MotorState::getStallTorque() const {
+    switch (gearset) {
+        case pros::E_MOTOR_GEARSET_36: return 2.1;
+        case pros::E_MOTOR_GEARSET_06: return 0.35;
+        default: return 1.05;
+    }
+}
+
+double tiger::sim::MotorState::getTicksPerRotation() const {
+    switch (gearset) {
+        case pros::E_MOTOR_GEARSET_36: return 1800;
+        case pros::E_MOTOR_GEARSET_06: return 300;
+        default: return 900;
+    }
+}
+
+double tiger::sim::MotorState::toUnits(double rotations) const {
+    switch (units) {
+        case pros::E_MOTOR_ENCODER_ROTATIONS: return rotations;
+        case pros::E_MOTOR_ENCODER_COUNTS: return rotations * getTicksPerRotation();
+        default: return rotations * 360;
+    }
+}
+
+double tiger::sim::MotorState::fromUnits(double value) const {
+    switch (units) {
+        case pros::E_MOTOR_ENCODER_ROTATIONS: return value;
+        case pros::E_MOTOR_ENCODER_COUNTS: return value / getTicksPerRotation();
+        default: return value / 360;
+    }
+}
+
+/**
+ * @brief Apply friction to a velocity, without letting it push the velocity past 0
+ *
+ * @param velocity the velocity
+ * @param acceleration acceleration from everything but friction
+ * @param friction deceleration from friction, always positive
+ * @param dt seconds
+ * @return double the new velocity
+ */
+static double applyFriction(double velocity, double acceleration, double friction, double dt) {
+    if (velocity == 0) {
+        // static friction holds the robot still until something pushes harder than it
+        if (std::fabs(acceleration) <= friction) return 0;
+        return (acceleration - std::copysign(friction, acceleration)) * dt;
+    }
+    const double next = velocity + (acceleration - std::copysign(friction, velocity)) * dt;
+    // friction can stop the robot, but not turn it around
+    if (std::signbit(next) != std::signbit(velocity) && std::fabs(acceleration) <= friction) return 0;
+    return next;
+}
+
+/**
+ * @brief The direction a drivetrain port turns its side's wheels in
+ */
+static double getSign(int8_t port) { return port < 0 ? -1 : 1; }
+
+tiger::sim::World& tiger::sim::world() {
+    static World instance;
+    return instance;
+}
+
+tiger::sim::MotorState& tiger::sim::World::motor(uint8_t port) { return motors[std::clamp<int>(port, 1, 21) - 1]; }
+
+void tiger::sim::World::setDrivetrain(const std::vector<int8_t>& left, const std::vector<int8_t>& right,
+                                      float trackWidth, float wheelDiameter, float rpm) {
+    leftPorts = left;
+    rightPorts = right;
+    for (int8_t port : left) motor(std::abs(port)).drivetrain = true;
+    for (int8_t port : right) motor(std::abs(port)).drivetrain = true;
+    this->trackWidth = trackWidth / METER;
+    this->wheelRadius = wheelDiameter / 2 / METER;
+    this->rpm = rpm;
+}
+
+void tiger::sim::World::setTrackingWheel(uint8_t port, TrackingWheelGeometry geometry) {
+    trackingWheels[port] = geometry;
+}
+
+double tiger::sim::World::getRotation(uint8_t port) {
+    const auto wheel = trackingWheels.find(port);
+    if (wheel == trackingWheels.end()) return 0;
+    const TrackingWheelGeometry& geometry = wheel->second;
+    return wheelTravel[port] * 36000 * geometry.gearRatio / (M_PI * geometry.diameter);
+}
+
+double tiger::sim::World::getRotationVelocity(uint8_t port) {
+    const auto wheel = trackingWheels.find(port);
+    if (wheel == trackingWheels.end()) return 0;
+    const TrackingWheelGeometry& geometry = wheel->second;
+    return wheelSpeed[port] * 36000 * geometry.gearRatio / (M_PI * geometry.diameter);
+}
+
+double tiger::sim::World::getImuRotation() const { return imuAngle * 180 / M_PI; }
+
+double tiger::sim::World::getImuRate() const { return angularVelocity * 180 / M_PI; }
+
+void tiger::sim::World::getImuAccel(double& forward, double& right) const {
+    forward = acceleration / GRAVITY;
+    // turning clockwise while driving forwards pulls the robot towards the right
+    right = velocity * angularVelocity / GRAVITY;
+}
+
+void tiger::sim::World::setAdi(uint8_t smartPort, uint8_t adiPort, int32_t value) {
+    const auto previous = adi.find({smartPort, adiPort});
+    const bool changed = previous == adi.end() || previous->second != value;
+    adi[{smartPort, adiPort}] = value;
+    if (changed && adiHook) adiHook(smartPort, adiPort, value);
+}
+
+int32_t tiger::sim::World::getAdi(uint8_t smartPort, uint8_t adiPort) {
+    const auto value = adi.find({smartPort, adiPort});
+    return value == adi.end() ? 0 : value->second;
+}
+
+void tiger::sim::World::place(lemlib::Pose pose) {
+    if (moved) return;
+    x = pose.x;
+    y = pose.y;
+    theta = pose.theta;
+}
+
+lemlib::Pose tiger::sim::World::getPose() const { return lemlib::Pose(x, y, theta); }
+
+void tiger::sim::World::getSideSpeeds(double& left, double& right) const {
+    left = (velocity + angularVelocity * trackWidth / 2) * METER;
+    right = (velocity - angularVelocity * trackWidth / 2) * METER;
+}
+
+void tiger::sim::World::getSideVoltages(double& left, double& right) {
+    auto average = [this](const std::vector<int8_t>& ports) {
+        double sum = 0;
+        for (int8_t port : ports) sum += getSign(port) * motor(std::abs(port)).voltage;
+        return ports.empty() ? 0 : sum / ports.size();
+    };
+    left = average(leftPorts);
+    right = average(rightPorts);
+}
+
+void tiger::sim::World::setAdiHook(std::function<void(uint8_t, uint8_t, int32_t)> hook) { adiHook = hook; }
+
+double tiger::sim::World::getTorque(MotorState& motor) {
+    const double freeSpeed = motor.getFreeSpeed();
+    double volts = 0;
+    bool coasting = false;
+    auto stop = [&] {
+        switch (motor.brakeMode) {
+            // shorting the motor makes its back EMF brake it
+            case pros::E_MOTOR_BRAKE_BRAKE: volts = 0; break;
+            case pros::E_MOTOR_BRAKE_HOLD: volts = HOLD_GAIN * (motor.holdPosition - motor.position); break;
+            default: coasting = true; break;
+        }
+    };
+    // drive at a velocity, feeding forward the voltage the motor needs at that speed
+    auto drive = [&](double target) { volts = 12 * (target + VELOCITY_GAIN * (target - motor.velocity)) / freeSpeed; };
+
+    switch (motor.mode) {
+        case MotorState::Mode::VOLTAGE:
+            if (motor.target == 0) stop();
+            else volts = motor.target / 1000;
+            break;
+        case MotorState::Mode::VELOCITY:
+            if (motor.target == 0) stop();
+            else drive(motor.target);
+            break;
+        case MotorState::Mode::POSITION:
+            drive(std::clamp(POSITION_GAIN * freeSpeed * (motor.target - motor.position), -motor.maxVelocity,
+                             motor.maxVelocity));
+            break;
+        case MotorState::Mode::BRAKE: stop(); break;
+    }
+
+    if (coasting) {
+        motor.voltage = 0;
+        motor.torque = 0;
+        return 0;
+    }
+    volts = std::clamp(volts, -12.0, 12.0);
+    if (motor.voltageLimit > 0) volts = std::clamp(volts, -motor.voltageLimit / 1000.0, motor.voltageLimit / 1000.0);
+    motor.voltage = volts;
+    const double maxTorque = motor.getStallTorque() * std::min<double>(motor.currentLimit, MAX_CURRENT) / MAX_CURRENT;
+    const double torque = motor.getStallTorque() * (volts / 12 - motor.velocity / freeSpeed);
+    motor.torque = std::clamp(torque, -maxTorque, maxTorque);
+    return motor.torque;
+}
+
+double tiger::sim::World::getSideForce(const std::vector<int8_t>& ports) {
+    double force = 0;
+    for (int8_t port : ports) {
+        MotorState& state = motor(std::abs(port));
+        // wheel rpm over motor rpm. Torque goes the other way through the gears
+        const double ratio = rpm / state.getFreeSpeed();
+        force += getSign(port) * getTorque(state) / ratio / wheelRadius;
+    }
+    return force;
+}
+
+void tiger::sim::World::moveSide(const std::vector<int8_t>& ports, double speed, double dt) {
+    const double wheelRpm = speed / wheelRadius * 60 / (2 * M_PI);
+    for (int8_t port : ports) {
+        MotorState& state = motor(std::abs(port));
+        state.velocity = getSign(port) * wheelRpm / (rpm / state.getFreeSpeed());
+        state.position += state.velocity / 60 * dt;
+    }
+}
+
+void tiger::sim::World::step(double dt) {
+    // the robot
+    const double mass = settings.mass;
+    // a uniform 18" square
+    const double inertia = settings.inertia > 0 ? settings.inertia : mass * 2 * std::pow(18 / METER, 2) / 12;
+    const double grip = settings.traction * mass * GRAVITY / 2;
+    const double left = std::clamp(getSideForce(leftPorts), -grip, grip);
+    const double right = std::clamp(getSideForce(rightPorts), -grip, grip);
+    const double previousVelocity = velocity;
+    velocity = applyFriction(velocity, (left + right) / mass, settings.rollingResistance * GRAVITY, dt);
+    angularVelocity = applyFriction(angularVelocity, (left - right) * trackWidth / 2 / inertia,
+                                    settings.turnScrub / inertia, dt);
+    acceleration = (velocity - previousVelocity) / dt;
+    if (velocity != 0 || angularVelocity != 0) moved = true;
+
+    // integrate along the average heading of the step
+    const double heading = theta + angularVelocity * dt / 2;
+    x += velocity * METER * std::sin(heading) * dt;
+    y += velocity * METER * std::cos(heading) * dt;
+    theta += angularVelocity * dt;
+    imuAngle += angularVelocity * dt;
+
+    moveSide(leftPorts, velocity + angularVelocity * trackWidth / 2, dt);
+    moveSide(rightPorts, velocity - angularVelocity * trackWidth / 2, dt);
+
+    // tracking wheels. A point ahead of the tracking center moves right when the robot turns clockwise, which
+    // LemLib's odometry expects horizontal wheels to read as negative
+    for (const auto& [port, geometry] : trackingWheels) {
+        const double forwards = geometry.vertical ? velocity * METER : 0;
+        wheelSpeed[port] = forwards - angularVelocity * geometry.offset;
+        wheelTravel[port] += wheelSpeed[port] * dt;
+    }
+
+    // everything else spins a small load
+    for (MotorState& state : motors) {
+        if (state.drivetrain) continue;
+        const double freeSpeed = state.getFreeSpeed() * 2 * M_PI / 60;
+        const double load = FREE_SPIN_UP * state.getStallTorque() / freeSpeed;
+        const double torque = getTorque(state);
+        const double velocity = applyFriction(state.velocity * 2 * M_PI / 60, torque / load,
+                                              FREE_FRICTION * state.getStallTorque() / load, dt);
+        state.velocity = velocity * 60 / (2 * M_PI);
+        state.position += state.velocity / 60 * dt;
+    }
+}
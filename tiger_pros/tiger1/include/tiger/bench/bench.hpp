@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+namespace tiger {
+/**
+ * @brief A clock for benchmarks
+ *
+ * @return uint64_t the current time, in nanoseconds
+ */
+using BenchClock = uint64_t (*)();
+
+/**
+ * @brief The brain's microsecond timer, in nanoseconds
+ *
+ * @return uint64_t
+ */
+uint64_t microsClock();
+
+/**
+ * @brief Keep the compiler from optimizing away a value a benchmark computes
+ *
+ * @param value the value, which the compiler has to assume is read and changed
+ */
+template <typename T> inline void doNotOptimize(T& value) { asm volatile("" : "+r,m"(value) : : "memory"); }
+
+/**
+ * @brief Histogram of durations, with logarithmic buckets
+ *
+ * Every power of two is split into 4 buckets, so a bucket is never more than 25% wider than the durations in it.
+ * Adding a duration is a couple of shifts, so histograms can also be filled in from a running control loop.
+ *
+ * @b Example
+ * @code {.cpp}
+ * tiger::TimingHistogram histogram;
+ * histogram.add(1200);
+ * histogram.add(1350);
+ * // about 1350
+ * uint64_t p99 = histogram.getPercentile(0.99);
+ * @endcode
+ */
+class TimingHistogram {
+    public:
+        /**
+         * @brief Add a duration
+         *
+         * @param duration nanoseconds
+         */
+        void add(uint64_t duration);
+        /**
+         * @brief Remove every duration
+         */
+        void reset();
+        /**
+         * @brief Get how many durations were added
+         *
+         * @return uint32_t
+         */
+        uint32_t getCount() const { return count; }
+        /**
+         * @brief Get the shortest duration, in nanoseconds
+         *
+         * @return uint64_t 0 if the histogram is empty
+         */
+        uint64_t getMin() const { return count == 0 ? 0 : min; }
+        /**
+         * @brief Get the longest duration, in nanoseconds
+         *
+         * @return uint64_t
+         */
+        uint64_t getMax() const { return max; }
+        /**
+         * @brief Get the mean duration, in nanoseconds
+         *
+         * @return double 0 if the histogram is empty
+         */
+        double getMean() const { return count == 0 ? 0 : total / count; }
+        /**
+         * @brief Get a percentile of the durations
+         *
+         * @param fraction the fraction of durations at or below the result, from 0 to 1
+         * @return uint64_t the upper end of the bucket the percentile falls in, in nanoseconds, but never more than
+         * the longest duration
+         */
+        uint64_t getPercentile(float fraction) const;
+        /**
+         * @brief Print a bar chart of the buckets that have durations in them
+         *
+         * @param out where to print to
+         */
+        void print(FILE* out) const;
+    private:
+        static constexpr int SUB_BUCKETS = 4;
+        static constexpr int BUCKETS = 64 * SUB_BUCKETS;
+
+        /**
+         * @brief Get the bucket a duration goes in
+         */
+        static int getBucket(uint64_t duration);
+        /**
+         * @brief Get the shortest duration that goes in a bucket
+         */
+        static uint64_t getBucketStart(int bucket);
+
+        uint32_t buckets[BUCKETS] = {};
+        uint32_t count = 0;
+        uint64_t min = UINT64_MAX;
+        uint64_t max = 0;
+        double total = 0;
+};
+
+/**
+ * @brief How to run benchmarks
+ */
+struct BenchSettings {
+        /** timed samples per benchmark */
+        uint32_t samples = 1000;
+        /** calls per sample. The brain's clock counts microseconds, so a single call is far too short to time */
+        uint32_t batch = 100;
+        /** print each benchmark's histogram, not only its summary */
+        bool histograms = false;
+};
+
+/**
+ * @brief Time a piece of code
+ *
+ * The code runs in batches, and every batch adds the mean time of one call to the histogram. The time of an empty
+ * batch is subtracted, so the clock's own cost doesn't count.
+ *
+ * @param clock the clock to time with
+ * @param settings how many samples and calls per sample
+ * @param function the code to time. Gets the index of the call, which can pick an input
+ * @return TimingHistogram the time of one call, in nanoseconds
+ */
+template <typename F> TimingHistogram benchmark(BenchClock clock, BenchSettings settings, F&& function) {
+    uint64_t overhead = UINT64_MAX;
+    for (uint32_t sample = 0; sample < 16; sample++) {
+        const uint64_t start = clock();
+        for (uint32_t i = 0; i < settings.batch; i++) asm volatile("" : : : "memory");
+        const uint64_t elapsed = clock() - start;
+        if (elapsed < overhead) overhead = elapsed;
+    }
+
+    TimingHistogram histogram;
+    uint32_t call = 0;
+    for (uint32_t sample = 0; sample < settings.samples; sample++) {
+        const uint64_t start = clock();
+        for (uint32_t i = 0; i < settings.batch; i++) function(call++);
+        const uint64_t elapsed = clock() - start;
+        histogram.add((elapsed > overhead ? elapsed - overhead : 0) / settings.batch);
+    }
+    return histogram;
+}
+
+/**
+ * @brief Print the column names of a table of benchmark results
+ *
+ * @param out where to print to
+ */
+void printBenchHeader(FILE* out);
+
+/**
+ * @brief Print one benchmark's row of a table of results
+ *
+ * @param out where to print to
+ * @param name what was timed
+ * @param histogram the time of one call, from tiger::benchmark
+ * @param printHistogram also print the histogram under the row
+ */
+void printBenchResult(FILE* out, const char* name, const TimingHistogram& histogram, bool printHistogram);
+
+/**
+ * @brief Benchmark the math of a control cycle
+ *
+ * Times PID::update, ExpoDriveCurve::curve, angleError, getCurvature, Pose arithmetic, ExitCondition::update, one
+ * iteration of moveToPose, one odometry update, and one step of the fusion EKF and of the OdomFusion that runs it,
+ * and prints a table of how long one call takes. The last lines are how much of a 10ms control cycle an odometry
+ * update plus a moveToPose iteration take, at the 99th percentile, and how much a fusion step adds.
+ *
+ * The robot doesn't move. Run it on the brain to see the real numbers, and on the host to catch regressions.
+ *
+ * @b Example
+ * @code {.cpp}
+ * void initialize() {
+ *     // prints to the terminal
+ *     tiger::benchControlLoop(tiger::microsClock);
+ * }
+ * @endcode
+ *
+ * @param clock the clock to time with. tiger::microsClock on the brain
+ * @param settings how to run the benchmarks
+ * @param out where to print the results to
+ */
+void benchControlLoop(BenchClock clock, BenchSettings settings = {}, FILE* out = stdout);
+
+/**
+ * @brief Benchmark logging a message from a control task
+ *
+ * Times logging "Chassis pose: {}" through a lemlib::BaseSink, which formats it right away, and through a
+ * tiger::DeferredLog, which only records it, plus formatting a deferred record the way the flush task does. Also times
+ * queueing a formatted message in a tiger::OutputBuffer, alone and behind a tiger::BufferedSink, and sending the pose
+ * as a tiger::Telemetry frame. Messages are thrown away instead of printed, so only the cost of logging counts.
+ *
+ * @param clock the clock to time with. tiger::microsClock on the brain
+ * @param settings how to run the benchmarks
+ * @param out where to print the results to
+ */
+void benchLogging(BenchClock clock, BenchSettings settings = {}, FILE* out = stdout);
+
+/**
+ * @brief Benchmark reading and writing state shared between tasks
+ *
+ * Times a pose and a 64 byte snapshot of sensors stored and loaded through pros::MutexVar, tiger::SeqLockVar and
+ * tiger::LatestVar, all from one task, so the numbers are what each costs when nothing else wants the value. With
+ * a mutex, a task that does want it also waits for whoever holds it, which the other two never do.
+ *
+ * @param clock the clock to time with. tiger::microsClock on the brain
+ * @param settings how to run the benchmarks
+ * @param out where to print the results to
+ */
+void benchSharedState(BenchClock clock, BenchSettings settings = {}, FILE* out = stdout);
+} // namespace tiger
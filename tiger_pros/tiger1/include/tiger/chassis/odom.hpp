@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include "lemlib/pose.hpp"
+
+namespace tiger {
+/**
+ * @brief Geometry of the odometry sensors
+ *
+ * Mirrors what LemLib reads out of lemlib::OdomSensors, but as plain values so the integrator can run without any
+ * devices attached (e.g. on a host against recorded data).
+ */
+struct OdomGeometry {
+        /** offset of the first vertical tracking wheel from the tracking center, in inches */
+        float vertical1Offset = 0;
+        /** offset of the second vertical tracking wheel from the tracking center, in inches */
+        float vertical2Offset = 0;
+        /** offset of the first horizontal tracking wheel from the tracking center, in inches */
+        float horizontal1Offset = 0;
+        /** offset of the second horizontal tracking wheel from the tracking center, in inches */
+        float horizontal2Offset = 0;
+        /** true if the first vertical wheel is substituted by a drivetrain motor group */
+        bool vertical1Powered = false;
+        /** true if the second vertical wheel is substituted by a drivetrain motor group */
+        bool vertical2Powered = false;
+        /** whether there is a first horizontal tracking wheel */
+        bool hasHorizontal1 = false;
+        /** whether there is a second horizontal tracking wheel */
+        bool hasHorizontal2 = false;
+        /** whether there is an inertial sensor */
+        bool hasImu = false;
+};
+
+/**
+ * @brief A single timestamped set of odometry sensor readings
+ */
+struct OdomSample {
+        /** distance traveled by the first vertical tracking wheel, in inches */
+        float vertical1 = 0;
+        /** distance traveled by the second vertical tracking wheel, in inches */
+        float vertical2 = 0;
+        /** distance traveled by the first horizontal tracking wheel, in inches */
+        float horizontal1 = 0;
+        /** distance traveled by the second horizontal tracking wheel, in inches */
+        float horizontal2 = 0;
+        /** rotation reported by the inertial sensor, in radians, clockwise positive */
+        float imu = 0;
+        /** time the sample was taken, in microseconds. The drivetrain motors' own timestamp when they are the
+         * tracking wheels */
+        uint64_t time = 0;
+};
+
+/**
+ * @brief Position tracking math, separated from the task that feeds it
+ *
+ * This is the same arc-based integration LemLib uses in lemlib::update(), except that velocities are computed with
+ * the measured time between samples instead of a nominal 10ms. A late cycle therefore no longer inflates the speed
+ * estimate, which is what lemlib::estimatePose and the motion algorithms build on.
+ *
+ * All poses are in LemLib's convention: theta in radians, 0 is +y, clockwise positive.
+ */
+class OdomIntegrator {
+    public:
+        /**
+         * @brief Construct a new Odom Integrator
+         *
+         * @param geometry the geometry of the sensors the samples come from
+         */
+        OdomIntegrator(OdomGeometry geometry = {});
+        /**
+         * @brief Forget the previous sample. The next call to step() only primes the integrator
+         *
+         * @b Example
+         * @code {.cpp}
+         * // tracking wheels were reset to 0, so the old readings are meaningless
+         * integrator.reset();
+         * @endcode
+         */
+        void reset();
+        /**
+         * @brief Integrate a new sample
+         *
+         * @param sample the new sensor readings
+         * @return float the time since the previous sample in seconds, or 0 if this was the first sample
+         */
+        float step(const OdomSample& sample);
+        /**
+         * @brief Set the pose the next step() integrates from
+         *
+         * @param pose the new pose, theta in radians
+         */
+        void setPose(lemlib::Pose pose);
+        /**
+         * @brief Get the integrated pose
+         *
+         * @return lemlib::Pose theta in radians
+         */
+        lemlib::Pose getPose() const;
+        /**
+         * @brief Get the global speed of the robot
+         *
+         * @return lemlib::Pose inches per second, theta in radians per second
+         */
+        lemlib::Pose getSpeed() const;
+        /**
+         * @brief Get the speed of the robot relative to its own heading
+         *
+         * @return lemlib::Pose inches per second, theta in radians per second
+         */
+        lemlib::Pose getLocalSpeed() const;
+    private:
+        OdomGeometry geometry;
+        OdomSample prev;
+        bool primed = false;
+
+        lemlib::Pose pose = {0, 0, 0};
+        lemlib::Pose speed = {0, 0, 0};
+        lemlib::Pose localSpeed = {0, 0, 0};
+};
+} // namespace tiger
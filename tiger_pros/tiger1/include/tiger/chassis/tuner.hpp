@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include "lemlib/chassis/chassis.hpp"
+
+namespace tiger {
+/**
+ * @brief Settings for PID tuning
+ */
+struct TuneSettings {
+        /** tune the angular controller instead of the lateral one */
+        bool angular = false;
+        /** size of each step trial, in inches or degrees. 0 for 24 inches or 90 degrees */
+        float step = 0;
+        /** how close to the target the robot must stay to count as settled, in inches or degrees. 0 for 1 */
+        float tolerance = 0;
+        /** how long each step trial runs, in milliseconds */
+        uint32_t trialTime = 2000;
+        /** power the relay test drives with, out of 127 */
+        float relayPower = 40;
+        /** oscillations the relay test measures, not counting the first one */
+        int relayCycles = 4;
+        /** gain candidates the search can try on the robot after the relay test. Each one is a step there and
+         * back */
+        int candidates = 16;
+        /** seconds of settle time an inch or degree of overshoot costs */
+        float overshootWeight = 0.1;
+        /** seconds of settle time a volt per second of chatter costs. Keeps the search away from gains that only
+         * settle fast by slamming the motors back and forth */
+        float chatterWeight = 0.001;
+};
+
+/**
+ * @brief Result of a relay feedback test
+ *
+ * Switching full power back and forth around a target makes the robot oscillate at the frequency where the loop's
+ * phase lag is 180 degrees. From the oscillation's amplitude and period follow the gain and period at which a
+ * proportional controller would oscillate forever, which classic tuning rules turn into PID gains.
+ */
+struct RelayResult {
+        /** proportional gain that would oscillate forever, in power out of 127 per inch or degree */
+        float ultimateGain = 0;
+        /** period of that oscillation, in seconds */
+        float ultimatePeriod = 0;
+        /** half the peak to peak size of the oscillation, in inches or degrees */
+        float amplitude = 0;
+
+        /**
+         * @brief Whether the test measured an oscillation
+         */
+        bool isValid() const { return ultimateGain > 0 && ultimatePeriod > 0; }
+};
+
+/**
+ * @brief How a step trial went
+ */
+struct TuneTrial {
+        /** seconds until the error stayed within the tolerance, or the whole trial if it didn't settle */
+        float settleTime = 0;
+        /** how far past the target the robot went, in inches or degrees */
+        float overshoot = 0;
+        /** how much the drivetrain's voltage changed, in volts per second of the trial */
+        float chatter = 0;
+        /** error at the end of the trial, in inches or degrees */
+        float finalError = 0;
+        /** whether the error was within the tolerance at the end of the trial */
+        bool settled = false;
+        /** whether the trial was cancelled before it was over, which makes the rest meaningless */
+        bool cancelled = false;
+};
+
+/**
+ * @brief Score a step trial. Lower is better
+ *
+ * @param trial the trial
+ * @param settings the tuning settings, for the weight of overshoot
+ * @return float seconds
+ */
+float getTuneScore(const TuneTrial& trial, const TuneSettings& settings);
+
+/**
+ * @brief Get starting gains from a relay test
+ *
+ * Uses the Ziegler-Nichols "some overshoot" rule, converted to lemlib::PID, which runs every 10ms and doesn't divide
+ * its derivative by time. The integral and the rest of the settings are kept from the base settings.
+ *
+ * @param relay the relay test
+ * @param base the current settings
+ * @return lemlib::ControllerSettings the base settings with the new kP and kD
+ */
+lemlib::ControllerSettings getRelayGains(const RelayResult& relay, lemlib::ControllerSettings base);
+} // namespace tiger
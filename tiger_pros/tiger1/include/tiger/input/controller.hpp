@@ -0,0 +1,180 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "pros/adi.hpp"
+#include "pros/apix.h"
+#include "pros/misc.hpp"
+
+namespace tiger {
+/**
+ * @brief Something a button did between two samples of the controller
+ */
+enum class ButtonEvent : uint8_t {
+    /** the button went down */
+    PRESSED,
+    /** the button came back up */
+    RELEASED,
+    /** the button has been down for the hold time. Fires once per press */
+    HELD,
+    /** the button went down again within the double tap time of its last press */
+    DOUBLE_TAPPED
+};
+
+/**
+ * @brief An event, as pushed into the queue from ControllerInput::createQueue
+ */
+struct InputEvent {
+        pros::controller_digital_e_t button;
+        ButtonEvent type;
+        /** when the controller was sampled, in milliseconds */
+        uint32_t time;
+};
+
+/**
+ * @brief Timing for the events ControllerInput finds
+ */
+struct InputSettings {
+        /** milliseconds a button has to stay down before it's held */
+        uint32_t holdTime = 500;
+        /** the most milliseconds between two presses that makes them a double tap */
+        uint32_t doubleTapTime = 300;
+};
+
+/**
+ * @brief Samples a controller once per tick, and turns its buttons into events
+ *
+ * Every call to update() reads each button and stick once, into a snapshot the rest of the tick reads from, and
+ * compares it with the last one to find every button's presses, releases, holds and double taps in one pass. Each
+ * event runs the callbacks registered for it with on(), and goes into the queue from createQueue() if there is one,
+ * so another task can wait on it with pros::c::queue_recv.
+ *
+ * This replaces keeping a last_pressed flag per button by hand. toggle() covers the common case of a piston that
+ * flips on every press, with a state of its own for each piston.
+ *
+ * Callbacks run on the task that calls update(), in the order their buttons were sampled, so they should be quick.
+ *
+ * @b Example
+ * @code {.cpp}
+ * void opcontrol() {
+ *     tiger::ControllerInput input(controller);
+ *     input.toggle(pros::E_CONTROLLER_DIGITAL_DOWN, loaderPiston);
+ *     input.on(pros::E_CONTROLLER_DIGITAL_B, tiger::ButtonEvent::DOUBLE_TAPPED, [] { chassis.setPose(0, 0, 0); });
+ *
+ *     while (true) {
+ *         input.update();
+ *         chassis.arcade(input.getAnalog(pros::E_CONTROLLER_ANALOG_LEFT_Y),
+ *                        input.getAnalog(pros::E_CONTROLLER_ANALOG_RIGHT_X));
+ *         intake.move(input.isDown(pros::E_CONTROLLER_DIGITAL_R1) ? 127 : 0);
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+class ControllerInput {
+    public:
+        /**
+         * @brief Construct a new Controller Input. Nothing is read until the first update()
+         *
+         * @param controller the controller to sample
+         * @param settings timing for holds and double taps
+         */
+        ControllerInput(pros::Controller& controller, InputSettings settings = {});
+        /**
+         * @brief Sample the controller, find what changed since the last sample, and dispatch the events. Call it
+         * once at the start of every tick
+         */
+        void update();
+        /**
+         * @brief Whether the button was down when the controller was last sampled
+         */
+        bool isDown(pros::controller_digital_e_t button) const;
+        /**
+         * @brief Whether the button did something during the last update()
+         *
+         * @param button the button
+         * @param event what it did
+         */
+        bool hasEvent(pros::controller_digital_e_t button, ButtonEvent event) const;
+        /**
+         * @brief Get a stick's position when the controller was last sampled, from -127 to 127
+         */
+        int32_t getAnalog(pros::controller_analog_e_t channel) const;
+        /**
+         * @brief Run a callback every time a button does something
+         *
+         * Register callbacks before the loop that calls update(), not from one another.
+         *
+         * @param button the button
+         * @param event what it has to do
+         * @param callback called from update(), with the controller already sampled
+         */
+        void on(pros::controller_digital_e_t button, ButtonEvent event, std::function<void()> callback);
+        /**
+         * @brief Flip a piston every time a button is pressed
+         *
+         * @param button the button
+         * @param piston the piston
+         * @param state the state the piston starts out in. The first press sets the opposite
+         */
+        void toggle(pros::controller_digital_e_t button, pros::adi::DigitalOut& piston, bool state = false);
+        /**
+         * @brief Push every event into a queue from now on, as an InputEvent
+         *
+         * update() never waits on the queue: an event that doesn't fit is dropped and counted. Only one queue is made,
+         * so later calls return the first one.
+         *
+         * @param length how many events the queue can hold
+         * @return pros::c::queue_t the queue, for pros::c::queue_recv
+         */
+        pros::c::queue_t createQueue(uint32_t length = 16);
+        /**
+         * @brief Get how many events didn't fit in the queue
+         */
+        uint32_t getDropped() const;
+    private:
+        /** the controller's buttons are numbered from L1 to A */
+        static constexpr size_t BUTTONS = pros::E_CONTROLLER_DIGITAL_A - pros::E_CONTROLLER_DIGITAL_L1 + 1;
+        /** and its sticks from the left X to the right Y */
+        static constexpr size_t AXES = 4;
+
+        /**
+         * @brief Everything known about one button
+         */
+        struct Button {
+                bool down = false;
+                /** when the button last went down, in milliseconds */
+                uint32_t pressTime = 0;
+                /** whether the last press can start a double tap */
+                bool tapPending = false;
+                /** whether HELD has fired for the current press */
+                bool heldFired = false;
+                /** a bit for every ButtonEvent found during the last update() */
+                uint8_t events = 0;
+        };
+
+        /**
+         * @brief A callback registered with on()
+         */
+        struct Binding {
+                size_t button;
+                ButtonEvent event;
+                std::function<void()> callback;
+        };
+
+        /**
+         * @brief Record an event, and push it into the queue
+         */
+        void emit(size_t index, ButtonEvent event, uint32_t time);
+
+        pros::Controller& controller;
+        InputSettings settings;
+        std::array<Button, BUTTONS> buttons;
+        std::array<int32_t, AXES> axes {};
+        std::vector<Binding> bindings;
+        pros::c::queue_t queue = nullptr;
+        uint32_t dropped = 0;
+};
+} // namespace tiger
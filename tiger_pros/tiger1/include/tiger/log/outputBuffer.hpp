@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include "pros/rtos.hpp"
+
+namespace tiger {
+/**
+ * @brief What an OutputBuffer does with a string that doesn't fit
+ */
+enum class FullPolicy {
+    /** drop the new string */
+    DROP_NEWEST,
+    /** drop the oldest strings until the new one fits */
+    DROP_OLDEST,
+    /** wait until the flush task makes room. Never use it from a control task */
+    BLOCK
+};
+
+/**
+ * @brief A bounded, lock-free replacement for lemlib::Buffer
+ *
+ * lemlib::Buffer queues strings in a std::deque behind a mutex, which grows without limit when output is slower than
+ * logging, and polls for them at a fixed rate. This copies strings into a ring of bytes that's allocated once, so
+ * memory is bounded and pushing costs a copy and a couple of atomic operations. Producers never wait for each other.
+ * The flush task sleeps until a push notifies it, then writes everything that's waiting.
+ *
+ * Any number of tasks can push at once. What happens when the ring is full is up to the FullPolicy, and every
+ * dropped string is counted.
+ *
+ * @b Example
+ * @code {.cpp}
+ * // prints whatever is pushed, from a task of its own
+ * tiger::OutputBuffer buffer([](std::string_view string) { std::fwrite(string.data(), 1, string.size(), stdout); });
+ * buffer.push("Hello\n");
+ * @endcode
+ */
+class OutputBuffer {
+    public:
+        /**
+         * @brief Construct a new Output Buffer, and start its flush task
+         *
+         * @param write called with each string, in the order they were pushed, from the flush task
+         * @param capacity size of the ring, in bytes. Rounded up to a power of two, and allocated here, once
+         * @param policy what to do when a string doesn't fit
+         * @param priority priority of the flush task
+         */
+        explicit OutputBuffer(std::function<void(std::string_view)> write, size_t capacity = 4096,
+                              FullPolicy policy = FullPolicy::DROP_NEWEST, uint32_t priority = TASK_PRIORITY_MIN + 1);
+        OutputBuffer(const OutputBuffer&) = delete;
+        OutputBuffer& operator=(const OutputBuffer&) = delete;
+        ~OutputBuffer();
+
+        /**
+         * @brief Copy a string into the buffer
+         *
+         * Strings longer than a quarter of the ring are cut short.
+         *
+         * @param string the string
+         * @return true if it was queued, false if it was dropped
+         */
+        bool push(std::string_view string);
+        /**
+         * @brief Write every string that's waiting, on the calling task
+         *
+         * The flush task calls this whenever it's notified. Calling it from anywhere else races with the flush task.
+         * Useful when there is no scheduler, or before the program exits.
+         *
+         * @return size_t how many strings were written
+         */
+        size_t flush();
+        /**
+         * @brief Check whether every string has been written
+         */
+        bool isEmpty() const;
+        /**
+         * @brief Get how many strings were dropped because the ring was full
+         */
+        uint32_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+    private:
+        /**
+         * @brief Header of a string in the ring. The string follows it
+         */
+        struct Header {
+                /** position of the header plus one, stored last. Until it matches, the string isn't written yet */
+                uint32_t stamp;
+                /** length of the string, or of the skipped space with the PADDING bit set */
+                uint32_t length;
+        };
+
+        static constexpr uint32_t PADDING = 0x80000000;
+
+        /**
+         * @brief Drop the oldest string, if it's been written
+         *
+         * @return whether a string was dropped
+         */
+        bool dropOldest();
+        /**
+         * @brief Get the header at a position
+         */
+        Header* header(uint32_t position) const;
+
+        std::function<void(std::string_view)> write;
+        std::unique_ptr<uint8_t[]> ring;
+        /** string copied out of the ring before it's written, so the space can be freed first */
+        std::unique_ptr<char[]> scratch;
+        uint32_t capacity;
+        FullPolicy policy;
+        /** positions count bytes since the start and wrap around at 2^32. The ring offset is the position modulo the
+         * capacity */
+        std::atomic<uint32_t> head = 0;
+        std::atomic<uint32_t> tail = 0;
+        /** whether the flush task is waiting for a notification */
+        std::atomic<bool> sleeping = false;
+        std::atomic<uint32_t> dropped = 0;
+        pros::Task task;
+};
+} // namespace tiger
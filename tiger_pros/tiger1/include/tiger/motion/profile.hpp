@@ -0,0 +1,103 @@
+#pragma once
+
+namespace tiger {
+/**
+ * @brief Kinematic limits for a motion profile
+ */
+struct ProfileConstraints {
+        /** maximum velocity, in units per second */
+        float maxVelocity = 0;
+        /** maximum acceleration, in units per second squared */
+        float maxAcceleration = 0;
+        /** maximum jerk, in units per second cubed. 0 gives a trapezoidal profile */
+        float maxJerk = 0;
+};
+
+/**
+ * @brief A point on a motion profile
+ */
+struct ProfileState {
+        /** position, in units */
+        float position = 0;
+        /** velocity, in units per second */
+        float velocity = 0;
+        /** acceleration, in units per second squared */
+        float acceleration = 0;
+};
+
+/**
+ * @brief Time-optimal one dimensional motion profile
+ *
+ * Moves a given distance as fast as the constraints allow: accelerate, cruise, decelerate. With a jerk limit each
+ * change of velocity is an S-curve, otherwise the profile is trapezoidal. The profile is computed once when it is
+ * constructed, after which sampling it is a handful of multiplications.
+ *
+ * @b Example
+ * @code {.cpp}
+ * // move 24 inches, at most 60 in/s, 120 in/s^2 and 1200 in/s^3
+ * tiger::MotionProfile profile(24, {60, 120, 1200});
+ * // where should we be 0.5 seconds in?
+ * tiger::ProfileState state = profile.sample(0.5);
+ * @endcode
+ */
+class MotionProfile {
+    public:
+        /**
+         * @brief Generate a new profile
+         *
+         * @param distance distance to travel. Must be positive
+         * @param constraints kinematic limits
+         * @param startVelocity velocity at the start of the profile
+         * @param endVelocity velocity at the end of the profile. Lowered if the distance is too short to reach it
+         */
+        MotionProfile(float distance, ProfileConstraints constraints, float startVelocity = 0, float endVelocity = 0);
+        /**
+         * @brief Sample the profile
+         *
+         * @param time seconds since the start of the profile. Clamped to the duration of the profile
+         * @return ProfileState
+         */
+        ProfileState sample(float time) const;
+        /**
+         * @brief Get the duration of the profile
+         *
+         * @return float seconds
+         */
+        float getDuration() const;
+        /**
+         * @brief Get the distance covered by the profile
+         *
+         * @return float
+         */
+        float getDistance() const { return distance; }
+    private:
+        /**
+         * @brief A change of velocity. Jerk up, constant acceleration, jerk down
+         */
+        struct Transition {
+                float startVelocity = 0;
+                float endVelocity = 0;
+                /** duration of each jerk phase */
+                float jerkTime = 0;
+                /** duration of the constant acceleration phase */
+                float accelTime = 0;
+                /** signed peak acceleration */
+                float acceleration = 0;
+
+                /**
+                 * @brief Plan a velocity change as fast as the constraints allow
+                 */
+                Transition(float startVelocity, float endVelocity, const ProfileConstraints& constraints);
+                Transition() = default;
+                float duration() const { return 2 * jerkTime + accelTime; }
+                float distance() const { return (startVelocity + endVelocity) / 2 * duration(); }
+                ProfileState sample(float time) const;
+        };
+
+        float distance;
+        Transition accel;
+        Transition decel;
+        float cruiseVelocity = 0;
+        float cruiseTime = 0;
+};
+} // namespace tiger
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <variant>
+#include "pros/rtos.hpp"
+#include "lemlib/chassis/chassis.hpp"
+
+namespace tiger {
+class Chassis;
+
+/**
+ * @brief Settings for blending consecutive motions in a MotionQueue
+ *
+ * A motion that is followed by another one exits early and keeps moving, instead of settling and stopping. Speeds are
+ * scaled down by the cosine of the change in heading between the two motions, so sharp corners are taken slower, and
+ * a corner sharper than maxBlendAngle still stops.
+ */
+struct QueueSettings {
+        /** speed a move keeps when it hands over to the next motion, out of 127 */
+        float moveSpeed = 60;
+        /** how far before the target a move hands over, in inches */
+        float moveRange = 3;
+        /** speed a turn keeps when it hands over to the next motion, out of 127 */
+        float turnSpeed = 30;
+        /** how far before the target heading a turn hands over, in degrees */
+        float turnRange = 5;
+        /** sharpest change in heading, in degrees, that is still blended */
+        float maxBlendAngle = 90;
+        /** priority of the task running the queue */
+        uint32_t priority = TASK_PRIORITY_DEFAULT;
+};
+
+/**
+ * @brief A bounded queue of motions that are run one after another, blending each into the next
+ *
+ * Every lemlib::Chassis motion blocks until it has settled, so a chain of motions stops between each of them. The
+ * queue knows what comes next, so it sets the minSpeed and earlyExitRange of each motion to carry the robot's speed
+ * into the next one. Parameters set by the caller are never overridden, so a motion can still be made to stop by
+ * giving it a minSpeed or earlyExitRange of its own.
+ *
+ * Motions are only blended with the ones already queued when they start, so queue the whole sequence up front. A
+ * move never blends into a turn in place, since the turn would start with the robot still driving, and a turn only
+ * blends into another turn that keeps rotating the same way, with its direction parameter taken into account.
+ * follow() has no exit speed, so it never blends into the next motion, but the motion before a binary path can blend
+ * into it.
+ *
+ * @b Example
+ * @code {.cpp}
+ * tiger::MotionQueue queue(chassis);
+ *
+ * void autonomous() {
+ *     queue.moveToPoint(0, 24, 3000);
+ *     queue.turnToHeading(90, 2000);
+ *     queue.moveToPoint(24, 24, 3000);
+ *     // block until every motion has finished
+ *     queue.waitUntilDone();
+ * }
+ * @endcode
+ */
+class MotionQueue {
+    public:
+        /** most motions that can be waiting at once */
+        static constexpr size_t CAPACITY = 32;
+
+        /**
+         * @brief Create a new motion queue
+         *
+         * The task running the queue is only started once the first motion is queued.
+         *
+         * @param chassis the chassis to move
+         * @param settings blending settings
+         */
+        MotionQueue(Chassis& chassis, QueueSettings settings = {});
+        /**
+         * @brief Queue a moveToPoint. Parameters are the same as for tiger::Chassis::moveToPoint
+         *
+         * @return true if the motion was queued, false if the queue is full
+         */
+        bool moveToPoint(float x, float y, int timeout, lemlib::MoveToPointParams params = {});
+        /**
+         * @brief Queue a moveToPose. Parameters are the same as for tiger::Chassis::moveToPose
+         *
+         * @return true if the motion was queued, false if the queue is full
+         */
+        bool moveToPose(float x, float y, float theta, int timeout, lemlib::MoveToPoseParams params = {});
+        /**
+         * @brief Queue a turnToHeading. Parameters are the same as for lemlib::Chassis::turnToHeading
+         *
+         * @return true if the motion was queued, false if the queue is full
+         */
+        bool turnToHeading(float theta, int timeout, lemlib::TurnToHeadingParams params = {});
+        /**
+         * @brief Queue a turnToPoint. Parameters are the same as for lemlib::Chassis::turnToPoint
+         *
+         * @return true if the motion was queued, false if the queue is full
+         */
+        bool turnToPoint(float x, float y, int timeout, lemlib::TurnToPointParams params = {});
+        /**
+         * @brief Queue a follow. Parameters are the same as for lemlib::Chassis::follow
+         *
+         * @note the path is not copied, so it has to outlive the motion. Paths declared with ASSET() always do
+         *
+         * @return true if the motion was queued, false if the queue is full
+         */
+        bool follow(const asset& path, float lookahead, int timeout, bool forwards = true);
+        /**
+         * @brief Drop all queued motions and cancel the one that is running
+         *
+         * Returns once no motion queued before the call can still run, even one the queue task had taken off the
+         * queue but not started yet.
+         */
+        void clear();
+        /**
+         * @brief Block until all queued motions have finished
+         */
+        void waitUntilDone();
+        /**
+         * @brief Whether a motion is running or queued
+         *
+         * @return bool
+         */
+        bool isBusy();
+        /**
+         * @brief Get the number of motions waiting to run, not counting the running one
+         *
+         * @return size_t
+         */
+        size_t size();
+    private:
+        struct MoveToPoint {
+                float x;
+                float y;
+                int timeout;
+                lemlib::MoveToPointParams params;
+        };
+
+        struct MoveToPose {
+                float x;
+                float y;
+                float theta;
+                int timeout;
+                lemlib::MoveToPoseParams params;
+        };
+
+        struct TurnToHeading {
+                float theta;
+                int timeout;
+                lemlib::TurnToHeadingParams params;
+        };
+
+        struct TurnToPoint {
+                float x;
+                float y;
+                int timeout;
+                lemlib::TurnToPointParams params;
+        };
+
+        struct Follow {
+                const asset* path;
+                float lookahead;
+                int timeout;
+                bool forwards;
+        };
+
+        using Motion = std::variant<MoveToPoint, MoveToPose, TurnToHeading, TurnToPoint, Follow>;
+
+        /**
+         * @brief Add a motion to the back of the queue, starting the task if needed
+         */
+        bool push(const Motion& motion);
+        /**
+         * @brief The loop run by the queue task
+         */
+        void loop();
+        /**
+         * @brief Set the exit parameters of a motion so it blends into the next one
+         *
+         * @param motion the motion about to run
+         * @param next the motion after it
+         * @param pose the pose of the robot, radians in standard position
+         */
+        void blend(Motion& motion, const Motion& next, lemlib::Pose pose) const;
+        /**
+         * @brief Get where a motion ends
+         *
+         * @param motion the motion
+         * @param start pose at the start of the motion, radians in standard position
+         * @return std::optional<lemlib::Pose> position and heading of the robot at the end, if known
+         */
+        static std::optional<lemlib::Pose> getEnd(const Motion& motion, lemlib::Pose start);
+        /**
+         * @brief Get the heading a motion initially drives the robot towards
+         *
+         * @param motion the motion
+         * @param start pose at the start of the motion, radians in standard position
+         * @return std::optional<float> heading in radians in standard position, if known
+         */
+        static std::optional<float> getStartHeading(const Motion& motion, lemlib::Pose start);
+        /**
+         * @brief Get how far a turn rotates the robot, the way its direction parameter makes it go
+         *
+         * @param motion the motion
+         * @param start pose at the start of the motion, radians in standard position
+         * @return std::optional<float> rotation in radians, clockwise positive, or nothing if it's not a turn
+         */
+        static std::optional<float> getRotation(const Motion& motion, lemlib::Pose start);
+        /**
+         * @brief Get the direction a motion drives in
+         *
+         * @return int 1 for forwards, -1 for backwards, 0 for turns in place
+         */
+        static int getDirection(const Motion& motion);
+        /**
+         * @brief Run a motion, blocking until it is done
+         */
+        void run(const Motion& motion);
+
+        Chassis& chassis;
+        QueueSettings settings;
+        std::array<Motion, CAPACITY> motions;
+        size_t head = 0;
+        size_t count = 0;
+        bool running = false;
+        /** counts calls to clear(), so a motion taken off the queue before one can be told apart */
+        uint32_t generation = 0;
+        /** the generation of the running motion */
+        uint32_t runningGeneration = 0;
+        pros::Mutex mutex;
+        pros::Task* task = nullptr;
+};
+} // namespace tiger
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace tiger {
+class ActionRunner;
+
+/**
+ * @brief A step of a routine, written as a C++20 coroutine, that can wait without blocking its task
+ *
+ * A function returning Action can co_await delayMs(), waitUntil(), another Action, or whenAll() of several. While it
+ * waits, its ActionRunner runs the other Actions that are ready, so a routine can spin the intake while it drives
+ * instead of doing one after the other. Every Action runs on the runner's task, and a waiting Action only keeps its
+ * coroutine frame, a few dozen bytes, instead of a stack of its own.
+ *
+ * An Action doesn't start until it's awaited or run, and it has to finish before the Action object is destroyed.
+ * Actions must never call pros::delay or block in any other way, since that stops every other Action too.
+ *
+ * @b Example
+ * @code {.cpp}
+ * tiger::Action intakeFor(uint32_t time) {
+ *     intake.move(127);
+ *     co_await tiger::delayMs(time);
+ *     intake.move(0);
+ * }
+ *
+ * tiger::Action driveTo(float x, float y) {
+ *     chassis.moveToPoint(x, y, 2000);
+ *     co_await chassis.untilDone();
+ * }
+ *
+ * tiger::Action route() {
+ *     // drive and intake at the same time, then go on once both are done
+ *     co_await tiger::whenAll(driveTo(0, 24), intakeFor(800));
+ *     co_await driveTo(24, 24);
+ * }
+ *
+ * void autonomous() { tiger::ActionRunner().run(route()); }
+ * @endcode
+ */
+class Action {
+    public:
+        /**
+         * @brief The coroutine's state, as the compiler needs it
+         */
+        struct promise_type {
+                /** runs every Action in the routine this one belongs to */
+                ActionRunner* runner = nullptr;
+                /** the Action awaiting this one, resumed once it finishes */
+                std::coroutine_handle<> continuation;
+                /** Actions left in the whenAll() this one was started by */
+                uint32_t* remaining = nullptr;
+
+                Action get_return_object() { return Action(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+                std::suspend_always initial_suspend() noexcept { return {}; }
+
+                /**
+                 * @brief Hands control to whatever was waiting on the Action once it finishes
+                 */
+                struct FinalAwaiter {
+                        bool await_ready() noexcept { return false; }
+
+                        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+
+                        void await_resume() noexcept {}
+                };
+
+                FinalAwaiter final_suspend() noexcept { return {}; }
+
+                void return_void() {}
+
+                // there's nowhere sensible to rethrow to once the routine is split across resumptions
+                void unhandled_exception() { std::terminate(); }
+        };
+
+        Action(Action&& other) noexcept;
+        Action& operator=(Action&& other) noexcept;
+        ~Action();
+        /**
+         * @brief Whether the Action has run to its end
+         */
+        bool isDone() const;
+
+        bool await_ready() const noexcept { return isDone(); }
+
+        /**
+         * @brief Start the Action straight away, on the awaiting Action's runner
+         */
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> awaiter);
+
+        void await_resume() const noexcept {}
+    private:
+        friend class ActionRunner;
+        friend class WhenAll;
+
+        explicit Action(std::coroutine_handle<promise_type> handle)
+            : handle(handle) {}
+
+        /**
+         * @brief Run the Action until it first waits
+         */
+        void start(ActionRunner* runner);
+
+        std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * @brief Suspends an Action until a condition holds. Returned by waitUntil() and delayMs()
+ */
+class Condition {
+    public:
+        explicit Condition(std::function<bool()> condition)
+            : condition(std::move(condition)) {}
+
+        bool await_ready() { return condition(); }
+
+        void await_suspend(std::coroutine_handle<Action::promise_type> awaiter);
+
+        void await_resume() const noexcept {}
+    private:
+        std::function<bool()> condition;
+};
+
+/**
+ * @brief Suspends an Action until every one of a group of Actions has finished. Returned by whenAll()
+ */
+class WhenAll {
+    public:
+        explicit WhenAll(std::vector<Action> actions)
+            : actions(std::move(actions)) {}
+
+        bool await_ready() const noexcept { return actions.empty(); }
+
+        /**
+         * @brief Start every Action, and resume the awaiting one after the last of them finishes
+         */
+        bool await_suspend(std::coroutine_handle<Action::promise_type> awaiter);
+
+        void await_resume() const noexcept {}
+    private:
+        std::vector<Action> actions;
+        uint32_t remaining = 0;
+};
+
+/**
+ * @brief Runs a routine of Actions on the calling task until it's done
+ *
+ * Each tick the runner sleeps with pros::Task::delay_until, then resumes every Action whose condition now holds. A
+ * waiting Action is resumed at most one period after its condition starts to hold.
+ */
+class ActionRunner {
+    public:
+        /**
+         * @brief Construct a new Action Runner
+         *
+         * @param period milliseconds between checks of the waiting Actions' conditions
+         */
+        ActionRunner(uint32_t period = 10);
+        /**
+         * @brief Run an Action, and every Action it starts, until it finishes. Blocks the calling task until then
+         *
+         * @param action the routine
+         */
+        void run(Action action);
+    private:
+        friend class Condition;
+
+        /**
+         * @brief An Action waiting for its condition
+         */
+        struct Waiter {
+                std::coroutine_handle<> handle;
+                std::function<bool()> condition;
+        };
+
+        /**
+         * @brief Resume an Action once its condition holds
+         */
+        void wait(std::coroutine_handle<> handle, std::function<bool()> condition);
+
+        uint32_t period;
+        std::vector<Waiter> waiters;
+        /** the waiters checked this tick. Kept so the run loop doesn't allocate once it's seen every Action */
+        std::vector<Waiter> checking;
+};
+
+/**
+ * @brief Wait in an Action until a condition holds
+ *
+ * @param condition checked once per tick of the runner, and once straight away
+ */
+Condition waitUntil(std::function<bool()> condition);
+
+/**
+ * @brief Wait in an Action for a number of milliseconds, without blocking the other Actions
+ */
+Condition delayMs(uint32_t time);
+
+/**
+ * @brief Run several Actions at the same time, and wait until all of them have finished
+ */
+template <typename... Actions> WhenAll whenAll(Actions&&... actions) {
+    std::vector<Action> list;
+    list.reserve(sizeof...(actions));
+    (list.push_back(std::forward<Actions>(actions)), ...);
+    return WhenAll(std::move(list));
+}
+} // namespace tiger
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "tiger/bench/bench.hpp"
+#include "tiger/log/profiler.hpp"
+#include "tiger/task/shared.hpp"
+
+namespace tiger {
+/**
+ * @brief How a subsystem registered with an Executor has been keeping its deadlines
+ */
+struct SubsystemStats {
+        std::string name;
+        /** milliseconds between updates */
+        uint32_t period = 0;
+        uint32_t priority = 0;
+        /** updates that finished */
+        uint32_t runs = 0;
+        /** updates that finished after the next one was due. The next one is skipped */
+        uint32_t misses = 0;
+        /** how long each update ran, in nanoseconds */
+        TimingHistogram runTime;
+        /** how long after it was due each update started, in nanoseconds */
+        TimingHistogram lateness;
+};
+
+/**
+ * @brief Runs the robot's periodic subsystems on a few shared tasks
+ *
+ * Every subsystem, like odometry, the screen or telemetry, registers an update with a period and a priority instead
+ * of starting a task of its own that polls with pros::delay. Subsystems with the same priority share one task, so
+ * there are only as many tasks and stacks as there are priorities. Each task sleeps with pros::Task::delay_until until
+ * its next update is due, then runs every update that's due, in the order they were added. Higher priorities
+ * preempt lower ones, so put control-critical work on its own high priority, and the screen and logs on a low one.
+ *
+ * An update that finishes after its next one was due missed its deadline. The missed update is skipped instead of run
+ * straight away, the miss is counted and logged, and the update is due again a period later. Every update's run time
+ * and lateness go into histograms getStats() returns, and every subsystem is reported to tiger::profiler().
+ *
+ * Updates share a task, so one that blocks delays every other update with its priority. They should read sensors,
+ * compute, and set outputs, never wait for something.
+ *
+ * @b Example
+ * @code {.cpp}
+ * void initialize() {
+ *     tiger::executor().add("screen", 50, TASK_PRIORITY_MIN + 1, [] {
+ *         pros::lcd::print(0, "X: %f", chassis.getPose().x);
+ *     });
+ *     tiger::executor().add("intake", 10, TASK_PRIORITY_DEFAULT, [] { intake.update(); });
+ * }
+ * @endcode
+ */
+class Executor {
+    public:
+        /**
+         * @brief Add a subsystem. Starts a task for its priority, if there isn't one yet
+         *
+         * The first update is due right away, but a task that's already sleeping only sees it once it wakes up for
+         * its other subsystems. Add subsystems in initialize(), before their priority's task has much to wait for.
+         *
+         * @param name name of the subsystem, in the stats, the log and the profiler
+         * @param period milliseconds between updates
+         * @param priority priority of the task the update runs on
+         * @param update called once every period
+         */
+        void add(const std::string& name, uint32_t period, uint32_t priority, std::function<void()> update);
+        /**
+         * @brief Get every subsystem's stats so far. Safe to call from any task, and never holds up a subsystem
+         */
+        std::vector<SubsystemStats> getStats();
+        /**
+         * @brief Get how many tasks the subsystems run on
+         */
+        size_t getTaskCount();
+    private:
+        /**
+         * @brief How a subsystem's updates went, as its task publishes them
+         */
+        struct Timing {
+                uint32_t runs = 0;
+                uint32_t misses = 0;
+                TimingHistogram runTime;
+                TimingHistogram lateness;
+        };
+
+        /**
+         * @brief A registered subsystem
+         */
+        struct Subsystem {
+                std::string name;
+                uint32_t period;
+                uint32_t priority;
+                std::function<void()> update;
+                TaskProfile* profile;
+                /** when the next update is due, in milliseconds. Only its group's task touches it once it's added */
+                uint32_t due;
+                /** the group's task's own copy of the timing */
+                Timing timing {};
+                /** a copy of the timing for getStats(), which is only read with the executor's mutex held */
+                LatestVar<Timing, 1> published {};
+        };
+
+        /**
+         * @brief The subsystems sharing a priority, and the task they run on
+         */
+        struct Group {
+                uint32_t priority;
+                std::vector<std::unique_ptr<Subsystem>> subsystems;
+                pros::Task* task = nullptr;
+                /** guards the subsystems, so a group only ever waits for add(), never for another group */
+                pros::Mutex mutex;
+        };
+
+        /**
+         * @brief The loop run by each group's task
+         */
+        void run(Group* group);
+        /**
+         * @brief Run one update, and record how it went
+         */
+        void runUpdate(Subsystem* subsystem);
+
+        std::vector<std::unique_ptr<Group>> groups;
+        /** every subsystem, in the order they were added */
+        std::vector<Subsystem*> subsystems;
+        /** guards the list of groups and of subsystems, and reading the published timing. No group takes it */
+        pros::Mutex mutex;
+};
+
+/**
+ * @brief The executor shared by the whole program
+ */
+Executor& executor();
+} // namespace tiger
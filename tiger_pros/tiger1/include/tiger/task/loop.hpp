@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "pros/rtos.hpp"
+#include "tiger/bench/bench.hpp"
+#include "tiger/log/profiler.hpp"
+#include "tiger/task/shared.hpp"
+
+namespace tiger {
+/**
+ * @brief How a PeriodicLoop has been keeping time
+ */
+struct LoopStats {
+        /** iterations that finished */
+        uint32_t iterations = 0;
+        /** iterations whose body ran past the next deadline, which was skipped */
+        uint32_t overruns = 0;
+        /** how long each iteration's body ran, in nanoseconds */
+        TimingHistogram body;
+        /** how long after its deadline each iteration woke up, in nanoseconds */
+        TimingHistogram jitter;
+};
+
+/**
+ * @brief Runs a loop at a fixed period, and measures how well it keeps it
+ *
+ * A loop that ends with pros::delay(10) runs every 10ms plus however long its body took, so its period drifts with
+ * every device call in it. This sleeps with pros::Task::delay_until instead, so iterations start on a fixed grid no
+ * matter how long the body takes. A body that runs past the next deadline is an overrun: the missed deadline is
+ * skipped rather than fired straight away, and the grid starts again from the end of the body.
+ *
+ * Every iteration's body time and wake up jitter go into histograms another task can read with getStats(). They are
+ * published through a LatestVar, so the loop never waits for a task that's reading them. With a name, the loop also
+ * reports to tiger::profiler(), so it shows up on the profiler's screen and in its trace.
+ *
+ * @b Example
+ * @code {.cpp}
+ * void opcontrol() {
+ *     tiger::PeriodicLoop loop(10, "opcontrol");
+ *     while (true) {
+ *         chassis.arcade(leftY, rightX);
+ *         loop.wait();
+ *     }
+ * }
+ *
+ * // from another task, the 99th percentile of the body, in microseconds
+ * uint64_t p99 = loop.getStats().body.getPercentile(0.99) / 1000;
+ * @endcode
+ */
+class PeriodicLoop {
+    public:
+        /**
+         * @brief Construct a new Periodic Loop. The first iteration starts now
+         *
+         * @param period milliseconds between the starts of iterations
+         * @param name name to report to the profiler with, or empty to leave the profiler out
+         */
+        PeriodicLoop(uint32_t period, const std::string& name = "");
+        /**
+         * @brief Stop reporting to the profiler, so it doesn't read the task once it's gone
+         */
+        ~PeriodicLoop();
+        /**
+         * @brief End an iteration, and sleep until the next one is due. Call it at the end of the loop's body
+         */
+        void wait();
+        /**
+         * @brief Run a body forever, once every period
+         *
+         * @param body the body of the loop
+         */
+        template <typename F> [[noreturn]] void run(F&& body) {
+            while (true) {
+                body();
+                wait();
+            }
+        }
+        /**
+         * @brief Get the loop's stats as of the last iteration. Safe to call from up to two tasks at once
+         */
+        LoopStats getStats() const;
+        /**
+         * @brief Start the stats over, like after the robot was disabled. Takes effect when the current iteration
+         * ends
+         */
+        void resetStats();
+        /**
+         * @brief Get the period
+         *
+         * @return uint32_t milliseconds between the starts of iterations
+         */
+        uint32_t getPeriod() const { return period; }
+    private:
+        const uint32_t period;
+        TaskProfile* profile = nullptr;
+        /** the deadline delay_until last woke up for, in milliseconds */
+        uint32_t deadline;
+        /** when the current iteration started, in microseconds */
+        uint64_t start;
+        /** only touched by the loop's own task */
+        LoopStats stats;
+        /** the stats as of the last iteration, for the other tasks */
+        LatestVar<LoopStats> published {};
+        /** set by resetStats(), for the loop's task to act on */
+        std::atomic<bool> resetRequested {false};
+};
+} // namespace tiger
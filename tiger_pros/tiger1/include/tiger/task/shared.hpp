@@ -0,0 +1,178 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace tiger {
+/**
+ * @brief A small value shared between tasks, read and written without a mutex
+ *
+ * A lock-free alternative to pros::MutexVar for snapshots like a pose, a few sensor readings or a state machine's
+ * state. The value is kept twice, guarded by a sequence counter: the writer updates one copy while readers read the
+ * other, then the other way around. A reader that raced with a write retries, and since the writer has to have run
+ * for that to happen, a reader never waits on a writer that was preempted halfway through. The writer never waits at
+ * all. So a high priority task can read or write without ever being held up by a lower priority one, which a mutex
+ * can't promise.
+ *
+ * Each copy is stored as 32 bit atomic words, so reads and writes cost a copy of the value and a few barriers. Keep
+ * it for values up to a few dozen bytes, and use LatestVar for bigger ones.
+ *
+ * There must only be one writer at a time. Any number of tasks can read.
+ *
+ * @b Example
+ * @code {.cpp}
+ * tiger::SeqLockVar<lemlib::Pose> target(0, 0, 0);
+ *
+ * // the planning task
+ * target.store(lemlib::Pose(24, 24, 90));
+ *
+ * // the screen task
+ * const lemlib::Pose pose = target.load();
+ * @endcode
+ */
+template <typename T> class SeqLockVar {
+        static_assert(std::is_trivially_copyable_v<T>, "SeqLockVar values are copied as raw bytes");
+    public:
+        /**
+         * @brief Construct a new SeqLockVar, with the value constructed from the arguments
+         */
+        template <typename... Args> explicit SeqLockVar(Args&&... args) { store(T(std::forward<Args>(args)...)); }
+        /**
+         * @brief Replace the value. Only one task may store at a time
+         *
+         * @param value the new value
+         */
+        void store(const T& value) {
+            std::array<uint32_t, WORDS> words {};
+            std::memcpy(words.data(), &value, sizeof(T));
+            const uint32_t sequence = this->sequence.load(std::memory_order_relaxed);
+            // readers move to the second copy while the first is written, then back. Each step publishes the copy
+            // written before it, and the fence keeps the next copy's writes from overtaking it
+            for (int copy = 0; copy < 2; copy++) {
+                this->sequence.store(sequence + copy + 1, std::memory_order_release);
+                std::atomic_thread_fence(std::memory_order_release);
+                for (size_t i = 0; i < WORDS; i++) copies[copy][i].store(words[i], std::memory_order_relaxed);
+            }
+        }
+        /**
+         * @brief Get a copy of the value. Safe from any task
+         */
+        T load() const {
+            std::array<uint32_t, WORDS> words;
+            while (true) {
+                const uint32_t sequence = this->sequence.load(std::memory_order_acquire);
+                const auto& copy = copies[sequence & 1];
+                for (size_t i = 0; i < WORDS; i++) words[i] = copy[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (this->sequence.load(std::memory_order_relaxed) == sequence) break;
+            }
+            std::array<std::byte, sizeof(T)> bytes;
+            std::memcpy(bytes.data(), words.data(), sizeof(T));
+            return std::bit_cast<T>(bytes);
+        }
+    private:
+        static constexpr size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+        /** even while readers should read the first copy, odd while they should read the second */
+        std::atomic<uint32_t> sequence {0};
+        std::array<std::array<std::atomic<uint32_t>, WORDS>, 2> copies {};
+};
+
+/**
+ * @brief The latest version of a value one task produces and others read, without a mutex or a retry loop
+ *
+ * A triple buffer, generalized to several readers: the writer fills a buffer no reader is using, then publishes it as
+ * the latest, and each reader marks the latest buffer as in use while it copies it. With a buffer for every reader
+ * plus two, the writer always finds a free one, so neither side ever waits for the other, and every read is a
+ * complete version. A read only starts over if a new version was published between finding the latest buffer and
+ * marking it, so the copy itself is never repeated.
+ *
+ * Use it for values too big for SeqLockVar, like a snapshot of every sensor or a planned path. There must only be
+ * one writer, and at most Readers tasks reading at the same time.
+ *
+ * @b Example
+ * @code {.cpp}
+ * struct Sensors {
+ *     float left, right, heading;
+ *     std::array<float, 8> temperatures;
+ * };
+ * tiger::LatestVar<Sensors> sensors;
+ *
+ * // the control task
+ * sensors.store(readSensors());
+ *
+ * // the telemetry task
+ * const Sensors latest = sensors.load();
+ * @endcode
+ *
+ * @tparam T the value, which has to be copyable
+ * @tparam Readers how many tasks can read at once
+ */
+template <typename T, size_t Readers = 2> class LatestVar {
+    public:
+        /**
+         * @brief Construct a new LatestVar, with the value constructed from the arguments
+         */
+        template <typename... Args>
+        explicit LatestVar(Args&&... args)
+            : buffers(makeBuffers(T(std::forward<Args>(args)...), std::make_index_sequence<BUFFERS>())) {}
+        /**
+         * @brief Publish a new version of the value. Only one task may store at a time
+         *
+         * @param value the new value
+         */
+        void store(const T& value) {
+            const size_t current = latest.load();
+            // a buffer that isn't the latest and that no reader is copying. There always is one
+            size_t free = 0;
+            while (free == current || buffers[free].readers.load() != 0) free = (free + 1) % BUFFERS;
+            buffers[free].value = value;
+            latest.store(free);
+        }
+        /**
+         * @brief Get a copy of the latest version. Safe from up to Readers tasks at once
+         */
+        T load() const {
+            while (true) {
+                const size_t index = latest.load();
+                Buffer& buffer = buffers[index];
+                buffer.readers.fetch_add(1);
+                // the writer may have picked this buffer before it was marked, but only once it was no longer latest
+                if (latest.load() == index) {
+                    T value = buffer.value;
+                    buffer.readers.fetch_sub(1);
+                    return value;
+                }
+                buffer.readers.fetch_sub(1);
+            }
+        }
+    private:
+        static constexpr size_t BUFFERS = Readers + 2;
+
+        struct Buffer {
+                explicit Buffer(const T& value)
+                    : value(value) {}
+
+                T value;
+                /** readers copying this buffer right now */
+                std::atomic<uint32_t> readers {0};
+        };
+
+        /**
+         * @brief Start every buffer out with the same value, so T needn't have a default constructor
+         */
+        template <size_t... I>
+        static std::array<Buffer, BUFFERS> makeBuffers(const T& value, std::index_sequence<I...>) {
+            return {((void)I, Buffer(value))...};
+        }
+
+        mutable std::array<Buffer, BUFFERS> buffers;
+        std::atomic<size_t> latest {0};
+};
+} // namespace tiger
@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "lemlib/exitcondition.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/pid.hpp"
+#include "lemlib/util.hpp"
+#include "tiger/bench/bench.hpp"
+#include "tiger/chassis/fusion.hpp"
+#include "tiger/chassis/odom.hpp"
+#include "tiger/motion/feedforward.hpp"
+#include "tiger/motion/profile.hpp"
+
+// inputs are picked from tables of this size, so the compiler can't fold them into constants
+static constexpr uint32_t INPUTS = 64;
+// how often the motion and odometry tasks run, in nanoseconds
+static constexpr double CYCLE = 10e6;
+
+namespace {
+/**
+ * @brief Deterministic pseudo random numbers for benchmark inputs
+ */
+class Random {
+    public:
+        /**
+         * @brief Get a number from min to max
+         */
+        float next(float min, float max) {
+            state = state * 1664525 + 1013904223;
+            return min + (max - min) * (state >> 8) / float(1 << 24);
+        }
+    private:
+        uint32_t state = 1;
+};
+
+/**
+ * @brief One iteration of tiger::Chassis::moveToPose, without the sensor reads, motor writes and delay
+ *
+ * Keep this in step with the loop in moveToPose.cpp, it stands in for it because the real loop can't run without
+ * a drivetrain.
+ */
+class MoveToPoseLoop {
+    public:
+        MoveToPoseLoop() { params.horizontalDrift = 2; }
+
+        /**
+         * @brief Compute the motor powers for a pose
+         *
+         * @param pose the robot's pose, in standard form
+         * @param time seconds since the motion started
+         * @return float the power of the left side. The right side's goes in rightPower
+         */
+        float step(lemlib::Pose pose, float time, float& rightPower) {
+            distTraveled += pose.distance(lastPose);
+            lastPose = pose;
+            const float distTarget = pose.distance(target);
+            if (distTarget < 7.5 && close == false) {
+                close = true;
+                params.maxSpeed = std::fmax(std::fabs(prevLateralOut), 60);
+                lateralPID.reset();
+            }
+            if (lateralLargeExit.getExit() && lateralSmallExit.getExit()) lateralSettled = true;
+            lemlib::Pose carrot =
+                target - lemlib::Pose(std::cos(target.theta), std::sin(target.theta)) * params.lead * distTarget;
+            if (close) carrot = target;
+            const bool robotSide = (pose.y - target.y) * -std::sin(target.theta) <=
+                                   (pose.x - target.x) * std::cos(target.theta) + params.earlyExitRange;
+            const bool carrotSide = (carrot.y - target.y) * -std::sin(target.theta) <=
+                                    (carrot.x - target.x) * std::cos(target.theta) + params.earlyExitRange;
+            prevSameSide = robotSide == carrotSide;
+
+            const float adjustedRobotTheta = params.forwards ? pose.theta : pose.theta + M_PI;
+            const float angularError = close ? lemlib::angleError(adjustedRobotTheta, target.theta)
+                                             : lemlib::angleError(adjustedRobotTheta, pose.angle(carrot));
+            float lateralError = pose.distance(carrot);
+            if (close) lateralError *= std::cos(lemlib::angleError(pose.theta, pose.angle(carrot)));
+            else lateralError *= lemlib::sgn(std::cos(lemlib::angleError(pose.theta, pose.angle(carrot))));
+            lateralSmallExit.update(lateralError);
+            lateralLargeExit.update(lateralError);
+            angularSmallExit.update(lemlib::radToDeg(angularError));
+            angularLargeExit.update(lemlib::radToDeg(angularError));
+
+            float lateralOut = 0;
+            float angularFeedforwardOut = 0;
+            if (!close) {
+                const tiger::ProfileState reference = profile.sample(time);
+                lateralOut = lateralFeedforward.getPower(reference.velocity, reference.acceleration) +
+                             lateralPID.update(reference.position - distTraveled);
+                const float curvature = lemlib::getCurvature(pose, carrot);
+                angularFeedforwardOut =
+                    angularFeedforward.getPower(lemlib::radToDeg(reference.velocity * curvature),
+                                                lemlib::radToDeg(reference.acceleration * curvature));
+            } else {
+                lateralOut = lateralPID.update(lateralError);
+            }
+            float angularOut = angularFeedforwardOut + angularPID.update(lemlib::radToDeg(angularError));
+            angularOut = std::clamp(angularOut, -params.maxSpeed, params.maxSpeed);
+            lateralOut = std::clamp(lateralOut, -params.maxSpeed, params.maxSpeed);
+            const float radius = 1 / std::fabs(lemlib::getCurvature(pose, carrot));
+            const float maxSlipSpeed(std::sqrt(params.horizontalDrift * radius * 9.8));
+            lateralOut = std::clamp(lateralOut, -maxSlipSpeed, maxSlipSpeed);
+            const float overturn = std::fabs(angularOut) + std::fabs(lateralOut) - params.maxSpeed;
+            if (overturn > 0) lateralOut -= lateralOut > 0 ? overturn : -overturn;
+            if (!close) lateralOut = std::fmax(lateralOut, 0);
+            if (lateralOut < std::fabs(params.minSpeed) && lateralOut > 0) lateralOut = std::fabs(params.minSpeed);
+            prevLateralOut = lateralOut;
+
+            lemlib::infoSink()->debug("Lateral Out: {}, Angular Out: {}", lateralOut, angularOut);
+
+            float leftPower = lateralOut + angularOut;
+            rightPower = lateralOut - angularOut;
+            const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / params.maxSpeed;
+            if (ratio > 1) {
+                leftPower /= ratio;
+                rightPower /= ratio;
+            }
+            return leftPower;
+        }
+    private:
+        lemlib::PID lateralPID {10, 0, 3, 0, true};
+        lemlib::PID angularPID {2, 0, 10, 0, true};
+        lemlib::ExitCondition lateralSmallExit {1, 100};
+        lemlib::ExitCondition lateralLargeExit {3, 500};
+        lemlib::ExitCondition angularSmallExit {1, 100};
+        lemlib::ExitCondition angularLargeExit {3, 500};
+        tiger::MotionProfile profile {72, {60, 120, 1200}};
+        lemlib::MoveToPoseParams params;
+        lemlib::Pose target {48, 48, M_PI_4};
+        lemlib::Pose lastPose {0, 0, 0};
+        tiger::Feedforward lateralFeedforward {0.9, 0.18, 0.03};
+        tiger::Feedforward angularFeedforward {0.8, 0.025, 0.004};
+        float distTraveled = 0;
+        bool close = false;
+        bool lateralSettled = false;
+        bool prevSameSide = false;
+        float prevLateralOut = 0;
+};
+} // namespace
+
+void tiger::benchControlLoop(BenchClock clock, BenchSettings settings, FILE* out) {
+    // inputs
+    Random random;
+    float errors[INPUTS];
+    float sticks[INPUTS];
+    std::vector<lemlib::Pose> poses;
+    tiger::OdomSample samples[INPUTS];
+    tiger::FusionSample fusionSamples[INPUTS];
+    for (uint32_t i = 0; i < INPUTS; i++) {
+        errors[i] = random.next(-48, 48);
+        sticks[i] = random.next(-127, 127);
+        // somewhere on the way to moveToPose's target, pointed roughly at it
+        poses.emplace_back(random.next(0, 30), random.next(0, 30), random.next(0.5, 1.2));
+        // driving along an arc at about 50 in/s
+        samples[i].vertical1 = i * 0.5f;
+        samples[i].vertical2 = i * 0.52f;
+        samples[i].imu = i * 0.002f;
+        // the same arc, with everything a robot with one tracking wheel and an IMU reads
+        fusionSamples[i].vertical = i * 0.5f;
+        fusionSamples[i].leftDrive = i * 0.51f;
+        fusionSamples[i].rightDrive = i * 0.49f;
+        fusionSamples[i].setImu({}, i * 0.002f, -11, 0.01f * (i % 7), -0.02f);
+        fusionSamples[i].hasVertical = true;
+    }
+
+    printBenchHeader(out);
+
+    lemlib::PID pid(10, 0.01, 3, 5, true);
+    printBenchResult(out, "PID::update",
+                     benchmark(clock, settings,
+                               [&](uint32_t i) {
+                                   float output = pid.update(errors[i % INPUTS]);
+                                   doNotOptimize(output);
+                               }),
+                     settings.histograms);
+
+    lemlib::ExpoDriveCurve curve(3, 10, 1.019);
+    printBenchResult(out, "ExpoDriveCurve::curve",
+                     benchmark(clock, settings,
+                               [&](uint32_t i) {
+                                   float output = curve.curve(sticks[i % INPUTS]);
+                                   doNotOptimize(output);
+                               }),
+                     settings.histograms);
+
+    printBenchResult(out, "angleError",
+                     benchmark(clock, settings,
+                               [&](uint32_t i) {
+                                   float error = lemlib::angleError(poses[i % INPUTS].theta, errors[i % INPUTS]);
+                                   doNotOptimize(error);
+                               }),
+                     settings.histograms);
+
+    printBenchResult(out, "getCurvature",
+                     benchmark(clock, settings,
+                               [&](uint32_t i) {
+                                   float curvature = lemlib::getCurvature(poses[i % INPUTS], poses[(i + 1) % INPUTS]);
+                                   doNotOptimize(curvature);
+                               }),
+                     settings.histograms);
+
+    // the carrot point of moveToPose, and the distances and angles taken from it
+    printBenchResult(out, "Pose arithmetic",
+                     benchmark(clock, settings,
+                               [&](uint32_t i) {
+                                   const lemlib::Pose& pose = poses[i % INPUTS];
+                                   const lemlib::Pose& target = poses[(i + 1) % INPUTS];
+                                   const lemlib::Pose heading(std::cos(target.theta), std::sin(target.theta));
+                                   const lemlib::Pose carrot = target - heading * 0.6f * 24;
+                                   float result = pose.distance(carrot) + pose.angle(carrot) + (carrot - pose) * target;
+                                   doNotOptimize(result);
+                               }),
+                     settings.histograms);
+
+    lemlib::ExitCondition exit(1, 100);
+    printBenchResult(out, "ExitCondition::update",
+                     benchmark(clock, settings,
+                               [&](uint32_t i) {
+                                   bool done = exit.update(errors[i % INPUTS]);
+                                   doNotOptimize(done);
+                               }),
+                     settings.histograms);
+
+    MoveToPoseLoop loop;
+    const TimingHistogram motion = benchmark(clock, settings, [&](uint32_t i) {
+        float right = 0;
+        float left = loop.step(poses[i % INPUTS], i * 0.01f, right);
+        doNotOptimize(left);
+        doNotOptimize(right);
+    });
+    printBenchResult(out, "moveToPose iteration", motion, settings.histograms);
+
+    OdomGeometry geometry;
+    geometry.vertical1Offset = -5.5;
+    geometry.vertical2Offset = 5.5;
+    geometry.vertical1Powered = true;
+    geometry.vertical2Powered = true;
+    geometry.hasImu = true;
+    OdomIntegrator integrator(geometry);
+    const TimingHistogram odom = benchmark(clock, settings, [&](uint32_t i) {
+        OdomSample sample = samples[i % INPUTS];
+        sample.time = uint64_t(i) * 10000;
+        float dt = integrator.step(sample);
+        doNotOptimize(dt);
+    });
+    printBenchResult(out, "odometry update", odom, settings.histograms);
+
+    // a predict and the three updates OdomFusion makes with one tracking wheel, without the differencing around them
+    Ekf ekf;
+    ekf.reset(lemlib::Pose(0, 0, 0));
+    printBenchResult(out, "Ekf predict + updates",
+                     benchmark(clock, settings,
+                               [&](uint32_t i) {
+                                   const FusionSample& sample = fusionSamples[i % INPUTS];
+                                   ekf.predict(0.01, sample.gyroRate, sample.accelForward, sample.accelLateral, 1600,
+                                               0.0004);
+                                   ekf.updateForwardVelocity(errors[i % INPUTS], 0, sample.gyroRate, 2.25);
+                                   ekf.updateLateralVelocity(0, 0, sample.gyroRate, 9);
+                                   ekf.updateHeading(sample.imuRotation, 0.000016);
+                                   float x = ekf.get(Ekf::X);
+                                   doNotOptimize(x);
+                               }),
+                     settings.histograms);
+
+    OdomFusion odomFusion(FusionGeometry {0, 0, 11});
+    const TimingHistogram fused = benchmark(clock, settings, [&](uint32_t i) {
+        FusionSample sample = fusionSamples[i % INPUTS];
+        sample.time = uint64_t(i) * 10000;
+        float dt = odomFusion.step(sample);
+        doNotOptimize(dt);
+    });
+    printBenchResult(out, "OdomFusion::step", fused, settings.histograms);
+
+    const double cycle = motion.getPercentile(0.99) + odom.getPercentile(0.99);
+    std::fprintf(out, "odometry + moveToPose: %.1f us of a 10 ms cycle (%.2f%%) at p99\n", cycle / 1000,
+                 100 * cycle / CYCLE);
+    const double fusion = fused.getPercentile(0.99);
+    std::fprintf(out, "fusion adds %.1f us (%.2f%%) at p99\n", fusion / 1000, 100 * fusion / CYCLE);
+}
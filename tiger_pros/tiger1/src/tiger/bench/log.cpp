@@ -0,0 +1,102 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include "lemlib/pose.hpp"
+#include "lemlib/logger/baseSink.hpp"
+#include "tiger/bench/bench.hpp"
+#include "tiger/log/bufferedSink.hpp"
+#include "tiger/log/deferred.hpp"
+#include "tiger/log/telemetry.hpp"
+
+// inputs are picked from a table of this size, so the compiler can't fold them into constants
+static constexpr uint32_t INPUTS = 64;
+// ring bytes per call of a batch, more than a record of a pose takes
+static constexpr size_t RECORD_SPACE = 128;
+
+namespace {
+/**
+ * @brief A sink that formats messages like any other, then throws them away
+ */
+class DiscardSink : public lemlib::BaseSink {
+    protected:
+        void sendMessage(const lemlib::Message& message) override {
+            size_t size = message.message.size();
+            tiger::doNotOptimize(size);
+        }
+};
+} // namespace
+
+void tiger::benchLogging(BenchClock clock, BenchSettings settings, FILE* out) {
+    std::vector<lemlib::Pose> poses;
+    for (uint32_t i = 0; i < INPUTS; i++) poses.emplace_back(i * 0.75f, 48 - i * 0.5f, i * 5.5f);
+
+    printBenchHeader(out);
+
+    DiscardSink sink;
+    sink.setLowestLevel(lemlib::Level::INFO);
+    printBenchResult(out, "BaseSink::info",
+                     benchmark(clock, settings, [&](uint32_t i) { sink.info("Chassis pose: {}", poses[i % INPUTS]); }),
+                     settings.histograms);
+
+    // big enough for a whole batch, which is freed before the next one starts
+    DeferredLog log(settings.batch * RECORD_SPACE);
+    printBenchResult(out, "DeferredLog::info",
+                     benchmark(clock, settings,
+                               [&](uint32_t i) {
+                                   if (i % settings.batch == 0) log.flush([](const DeferredRecord&) {});
+                                   log.info("Chassis pose: {}", poses[i % INPUTS]);
+                               }),
+                     settings.histograms);
+
+    // what the flush task adds, later and on its own task
+    fmt::memory_buffer message;
+    printBenchResult(out, "DeferredLog::info + format",
+                     benchmark(clock, settings,
+                               [&](uint32_t i) {
+                                   log.info("Chassis pose: {}", poses[i % INPUTS]);
+                                   log.flush([&](const DeferredRecord& record) {
+                                       message.clear();
+                                       record.formatTo(message);
+                                   });
+                                   doNotOptimize(message);
+                               }),
+                     settings.histograms);
+
+    // what a message costs once it's formatted. The flush task doesn't run during benchmarks
+    auto buffer = std::make_shared<OutputBuffer>([](std::string_view) {}, settings.batch * RECORD_SPACE);
+    const std::string pose = fmt::format("Chassis pose: {}", poses[0]);
+    printBenchResult(out, "OutputBuffer::push",
+                     benchmark(clock, settings,
+                               [&](uint32_t i) {
+                                   if (i % settings.batch == 0) buffer->flush();
+                                   bool queued = buffer->push(pose);
+                                   doNotOptimize(queued);
+                               }),
+                     settings.histograms);
+
+    BufferedSink bufferedSink(buffer);
+    bufferedSink.setLowestLevel(lemlib::Level::INFO);
+    printBenchResult(out, "BufferedSink::info",
+                     benchmark(clock, settings,
+                               [&](uint32_t i) {
+                                   if (i % settings.batch == 0) buffer->flush();
+                                   bufferedSink.info("Chassis pose: {}", poses[i % INPUTS]);
+                               }),
+                     settings.histograms);
+
+    // the same pose as a binary telemetry frame
+    Telemetry telemetry(buffer, UINT32_MAX);
+    const auto poseChannel = telemetry.addChannel<float, float, float>("pose", {"x", "y", "theta"});
+    printBenchResult(out, "TelemetryChannel::send",
+                     benchmark(clock, settings,
+                               [&](uint32_t i) {
+                                   if (i % settings.batch == 0) buffer->flush();
+                                   const lemlib::Pose& pose = poses[i % INPUTS];
+                                   poseChannel.send(pose.x, pose.y, pose.theta);
+                               }),
+                     settings.histograms);
+
+    if (buffer->getDropped() != 0)
+        std::fprintf(out, "OutputBuffer dropped %lu strings\n", (unsigned long)buffer->getDropped());
+    if (log.getDropped() != 0) std::fprintf(out, "DeferredLog dropped %lu records\n", (unsigned long)log.getDropped());
+}
@@ -0,0 +1,207 @@
+#include <cmath>
+#include <algorithm>
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "tiger/log/level.hpp"
+#include "tiger/chassis/chassis.hpp"
+
+void tiger::Chassis::moveToPose(float x, float y, float theta, int timeout, lemlib::MoveToPoseParams params,
+                                bool async) {
+    // without a profile this is LemLib's motion
+    if (!profileEnabled) {
+        lemlib::Chassis::moveToPose(x, y, theta, timeout, params, async);
+        return;
+    }
+    // take the mutex
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([=, this]() { moveToPose(x, y, theta, timeout, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    // reset PIDs and exit conditions
+    lateralPID.reset();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    angularPID.reset();
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    lateralSettle.reset();
+    angularSettle.reset();
+    settleState = SettleState::MOVING;
+
+    // calculate target pose in standard form
+    lemlib::Pose target(x, y, M_PI_2 - lemlib::degToRad(theta));
+    if (!params.forwards) target.theta = std::fmod(target.theta + M_PI, 2 * M_PI); // backwards movement
+
+    // use global horizontalDrift if the user didn't specify one
+    if (params.horizontalDrift == 0) params.horizontalDrift = drivetrain.horizontalDrift;
+
+    // plan the profile once, along the curve through the first carrot point
+    const lemlib::Pose start = getPose(true, true);
+    const lemlib::Pose firstCarrot =
+        target - lemlib::Pose(std::cos(target.theta), std::sin(target.theta)) * params.lead * start.distance(target);
+    const float direction = params.forwards ? 1 : -1;
+    const float velocityToPower = 127 / getTopSpeed();
+    const float exitVelocity = std::fabs(params.minSpeed) / velocityToPower;
+    const float startVelocity = std::fmax(direction * getLocalSpeed().y, 0);
+    const MotionProfile profile(start.distance(firstCarrot) + firstCarrot.distance(target),
+                                getProfileConstraints(params.maxSpeed), startVelocity, exitVelocity);
+
+    // initialize vars used between iterations
+    lemlib::Pose lastPose = start;
+    distTraveled = 0;
+    lemlib::Timer timer(timeout);
+    const uint32_t startTime = pros::millis();
+    bool close = false;
+    bool lateralSettled = false;
+    bool prevSameSide = false;
+    float prevLateralOut = 0; // previous lateral power
+
+    // main loop
+    while (!timer.isDone() &&
+           ((!lateralSettled || (!angularLargeExit.getExit() && !angularSmallExit.getExit())) || !close) &&
+           this->motionRunning) {
+        // update position
+        const lemlib::Pose pose = getPose(true, true);
+
+        // update distance travelled
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        // calculate distance to the target point
+        const float distTarget = pose.distance(target);
+
+        // check if the robot is close enough to the target to start settling. From here on it's LemLib's settling
+        if (distTarget < 7.5 && close == false) {
+            close = true;
+            params.maxSpeed = std::fmax(std::fabs(prevLateralOut), 60);
+            lateralPID.reset();
+        }
+
+        // check if the lateral controller has settled
+        if (lateralLargeExit.getExit() && lateralSmallExit.getExit()) lateralSettled = true;
+
+        // calculate the carrot point
+        lemlib::Pose carrot =
+            target - lemlib::Pose(std::cos(target.theta), std::sin(target.theta)) * params.lead * distTarget;
+        if (close) carrot = target; // settling behavior
+
+        // calculate if the robot is on the same side as the carrot point
+        const bool robotSide = (pose.y - target.y) * -std::sin(target.theta) <=
+                               (pose.x - target.x) * std::cos(target.theta) + params.earlyExitRange;
+        const bool carrotSide = (carrot.y - target.y) * -std::sin(target.theta) <=
+                                (carrot.x - target.x) * std::cos(target.theta) + params.earlyExitRange;
+        const bool sameSide = robotSide == carrotSide;
+        // exit if close
+        if (!sameSide && prevSameSide && close && params.minSpeed != 0) break;
+        prevSameSide = sameSide;
+
+        // calculate error
+        const float adjustedRobotTheta = params.forwards ? pose.theta : pose.theta + M_PI;
+        const float angularError = close ? lemlib::angleError(adjustedRobotTheta, target.theta)
+                                         : lemlib::angleError(adjustedRobotTheta, pose.angle(carrot));
+        float lateralError = pose.distance(carrot);
+        // only use cos when settling
+        // otherwise just multiply by the sign of cos
+        if (close) lateralError *= std::cos(lemlib::angleError(pose.theta, pose.angle(carrot)));
+        else lateralError *= lemlib::sgn(std::cos(lemlib::angleError(pose.theta, pose.angle(carrot))));
+
+        // update exit conditions
+        lateralSmallExit.update(lateralError);
+        lateralLargeExit.update(lateralError);
+        angularSmallExit.update(lemlib::radToDeg(angularError));
+        angularLargeExit.update(lemlib::radToDeg(angularError));
+
+        // on the way, track the profile with the distance traveled so far. When settling, use the PID as usual
+        float lateralOut = 0;
+        float angularFeedforwardOut = 0;
+        if (!close) {
+            const ProfileState reference = profile.sample((pros::millis() - startTime) / 1000.0f);
+            lateralOut = direction * (getLateralFeedforward(reference) +
+                                      lateralPID.update(reference.position - distTraveled));
+            // turn at the rate the curve to the carrot point needs at the profile's speed
+            const float curvature = lemlib::getCurvature(pose, carrot);
+            angularFeedforwardOut = angularFeedforward.getPower(
+                lemlib::radToDeg(direction * reference.velocity * curvature),
+                lemlib::radToDeg(direction * reference.acceleration * curvature));
+        } else {
+            lateralOut = lateralPID.update(lateralError);
+        }
+        float angularOut = angularFeedforwardOut + angularPID.update(lemlib::radToDeg(angularError));
+
+        // apply restrictions on angular speed
+        angularOut = std::clamp(angularOut, -params.maxSpeed, params.maxSpeed);
+
+        // apply restrictions on lateral speed
+        lateralOut = std::clamp(lateralOut, -params.maxSpeed, params.maxSpeed);
+
+        // constrain lateral output by the max speed it can travel at without slipping
+        const float radius = 1 / std::fabs(lemlib::getCurvature(pose, carrot));
+        const float maxSlipSpeed(std::sqrt(params.horizontalDrift * radius * 9.8));
+        lateralOut = std::clamp(lateralOut, -maxSlipSpeed, maxSlipSpeed);
+        // prioritize angular movement over lateral movement
+        const float overturn = std::fabs(angularOut) + std::fabs(lateralOut) - params.maxSpeed;
+        if (overturn > 0) lateralOut -= lateralOut > 0 ? overturn : -overturn;
+
+        // prevent moving in the wrong direction
+        if (params.forwards && !close) lateralOut = std::fmax(lateralOut, 0);
+        else if (!params.forwards && !close) lateralOut = std::fmin(lateralOut, 0);
+
+        // constrain lateral output by the minimum speed
+        if (params.forwards && lateralOut < std::fabs(params.minSpeed) && lateralOut > 0)
+            lateralOut = std::fabs(params.minSpeed);
+        if (!params.forwards && -lateralOut < std::fabs(params.minSpeed) && lateralOut < 0)
+            lateralOut = -std::fabs(params.minSpeed);
+
+        // update previous output
+        prevLateralOut = lateralOut;
+
+        // done once the robot has stopped at the target pose, or given up if it can't get there
+        if (settleEnabled) {
+            const SettleState lateral = lateralSettle.update(lateralError, getLocalSpeed().y, lateralOut);
+            const SettleState angular =
+                angularSettle.update(lemlib::radToDeg(angularError), getSpeed().theta, angularOut);
+            if (lateral == SettleState::STALLED || angular == SettleState::STALLED) {
+                settleState = SettleState::STALLED;
+                TIGER_WARN(lemlib::infoSink(), "Motion stalled, aborting");
+                break;
+            }
+            if (close && lateral == SettleState::SETTLED && angular == SettleState::SETTLED) {
+                settleState = SettleState::SETTLED;
+                break;
+            }
+        }
+
+        TIGER_DEBUG(lemlib::infoSink(), "Lateral Out: {}, Angular Out: {}", lateralOut, angularOut);
+
+        // ratio the speeds to respect the max speed
+        float leftPower = lateralOut + angularOut;
+        float rightPower = lateralOut - angularOut;
+        const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / params.maxSpeed;
+        if (ratio > 1) {
+            leftPower /= ratio;
+            rightPower /= ratio;
+        }
+
+        // move the drivetrain
+        drivetrain.leftMotors->move(leftPower);
+        drivetrain.rightMotors->move(rightPower);
+
+        // delay to save resources
+        pros::delay(10);
+    }
+
+    // stop the drivetrain
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
@@ -0,0 +1,94 @@
+#include <cmath>
+#include <optional>
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "tiger/log/level.hpp"
+#include "tiger/chassis/chassis.hpp"
+
+void tiger::Chassis::turnToHeading(float theta, int timeout, lemlib::TurnToHeadingParams params, bool async) {
+    // without settling this is LemLib's motion
+    if (!settleEnabled) {
+        lemlib::Chassis::turnToHeading(theta, timeout, params, async);
+        return;
+    }
+    params.minSpeed = std::abs(params.minSpeed);
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([=, this]() { turnToHeading(theta, timeout, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+    float prevMotorPower = 0;
+    const float startTheta = getPose().theta;
+    bool settling = false;
+    std::optional<float> prevRawDeltaTheta = std::nullopt;
+    std::optional<float> prevDeltaTheta = std::nullopt;
+    distTraveled = 0;
+    lemlib::Timer timer(timeout);
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    angularPID.reset();
+    angularSettle.reset();
+    settleState = SettleState::MOVING;
+
+    // main loop
+    while (!timer.isDone() && !angularLargeExit.getExit() && !angularSmallExit.getExit() && this->motionRunning) {
+        // update variables
+        const lemlib::Pose pose = getPose();
+
+        // update completion vars
+        distTraveled = std::fabs(lemlib::angleError(pose.theta, startTheta, false));
+
+        // calculate deltaTheta
+        const float rawDeltaTheta = lemlib::angleError(theta, pose.theta, false);
+        if (prevRawDeltaTheta == std::nullopt) prevRawDeltaTheta = rawDeltaTheta;
+        if (lemlib::sgn(rawDeltaTheta) != lemlib::sgn(prevRawDeltaTheta.value())) settling = true;
+        prevRawDeltaTheta = rawDeltaTheta;
+        const float deltaTheta =
+            settling ? rawDeltaTheta : lemlib::angleError(theta, pose.theta, false, params.direction);
+        if (prevDeltaTheta == std::nullopt) prevDeltaTheta = deltaTheta;
+
+        // motion chaining
+        if (params.minSpeed != 0 && std::fabs(deltaTheta) < params.earlyExitRange) break;
+        if (params.minSpeed != 0 && lemlib::sgn(deltaTheta) != lemlib::sgn(prevDeltaTheta.value())) break;
+        prevDeltaTheta = deltaTheta;
+
+        // calculate the speed
+        float motorPower = angularPID.update(deltaTheta);
+        angularLargeExit.update(deltaTheta);
+        angularSmallExit.update(deltaTheta);
+
+        // cap the speed
+        if (motorPower > params.maxSpeed) motorPower = params.maxSpeed;
+        else if (motorPower < -params.maxSpeed) motorPower = -params.maxSpeed;
+        if (std::fabs(deltaTheta) > 20) motorPower = lemlib::slew(motorPower, prevMotorPower, angularSettings.slew);
+        if (motorPower < 0 && motorPower > -params.minSpeed) motorPower = -params.minSpeed;
+        else if (motorPower > 0 && motorPower < params.minSpeed) motorPower = params.minSpeed;
+        prevMotorPower = motorPower;
+
+        // done once the robot has stopped at the heading, or given up if it can't turn
+        settleState = angularSettle.update(deltaTheta, getSpeed().theta, motorPower);
+        if (settleState == SettleState::STALLED) TIGER_WARN(lemlib::infoSink(), "Turn stalled, aborting");
+        if (settleState != SettleState::MOVING) break;
+
+        TIGER_DEBUG(lemlib::infoSink(), "Turn Motor Power: {} ", motorPower);
+
+        // move the drivetrain
+        drivetrain.leftMotors->move(motorPower);
+        drivetrain.rightMotors->move(-motorPower);
+
+        pros::delay(10);
+    }
+
+    // stop the drivetrain
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
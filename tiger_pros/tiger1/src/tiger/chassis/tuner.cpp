@@ -0,0 +1,257 @@
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "lemlib/logger/logger.hpp"
+#include "tiger/log/level.hpp"
+#include "lemlib/util.hpp"
+#include "tiger/chassis/chassis.hpp"
+
+// the period lemlib::PID is updated at, in seconds
+static constexpr float PID_PERIOD = 0.01;
+// time between samples, in milliseconds
+static constexpr uint32_t SAMPLE_PERIOD = 10;
+// how long the robot gets to stop between tests, in milliseconds
+static constexpr uint32_t REST_TIME = 500;
+// the relay test gives up after this long, in milliseconds
+static constexpr uint32_t RELAY_TIMEOUT = 10000;
+// the pattern search stops once it scales gains by less than this
+static constexpr float MIN_SCALE = 1.05;
+
+/**
+ * @brief Fill in the settings left at 0
+ */
+static tiger::TuneSettings resolve(tiger::TuneSettings settings) {
+    if (settings.step <= 0) settings.step = settings.angular ? 90 : 24;
+    if (settings.tolerance <= 0) settings.tolerance = 1;
+    return settings;
+}
+
+float tiger::getTuneScore(const TuneTrial& trial, const TuneSettings& settings) {
+    return trial.settleTime + settings.overshootWeight * trial.overshoot + settings.chatterWeight * trial.chatter;
+}
+
+lemlib::ControllerSettings tiger::getRelayGains(const RelayResult& relay, lemlib::ControllerSettings base) {
+    if (!relay.isValid()) return base;
+    base.kP = 0.33f * relay.ultimateGain;
+    // kD is per second in the rule, but per update in lemlib::PID
+    base.kD = 0.11f * relay.ultimateGain * relay.ultimatePeriod / PID_PERIOD;
+    return base;
+}
+
+void tiger::Chassis::setLateralSettings(const lemlib::ControllerSettings& settings) {
+    // the PIDs and exit conditions have const gains, so they are rebuilt instead of assigned
+    lateralSettings = settings;
+    std::destroy_at(&lateralPID);
+    std::construct_at(&lateralPID, settings.kP, settings.kI, settings.kD, settings.windupRange, true);
+    std::destroy_at(&lateralLargeExit);
+    std::construct_at(&lateralLargeExit, settings.largeError, settings.largeErrorTimeout);
+    std::destroy_at(&lateralSmallExit);
+    std::construct_at(&lateralSmallExit, settings.smallError, settings.smallErrorTimeout);
+}
+
+void tiger::Chassis::setAngularSettings(const lemlib::ControllerSettings& settings) {
+    angularSettings = settings;
+    std::destroy_at(&angularPID);
+    std::construct_at(&angularPID, settings.kP, settings.kI, settings.kD, settings.windupRange, true);
+    std::destroy_at(&angularLargeExit);
+    std::construct_at(&angularLargeExit, settings.largeError, settings.largeErrorTimeout);
+    std::destroy_at(&angularSmallExit);
+    std::construct_at(&angularSmallExit, settings.smallError, settings.smallErrorTimeout);
+}
+
+tiger::RelayResult tiger::Chassis::runRelayTest(TuneSettings settings) {
+    settings = resolve(settings);
+    // take the mutex, so nothing else drives the robot during the test
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return {};
+    distTraveled = 0;
+    const lemlib::Pose start = getPose();
+    const float startTheta = lemlib::degToRad(start.theta);
+    // switch a little past the target, so noise around it doesn't flip the relay every sample
+    const float hysteresis = settings.tolerance / 2;
+    float power = settings.relayPower;
+    // times the robot crossed the target going forwards or clockwise, and the extremes of each cycle
+    std::vector<float> crossings;
+    std::vector<float> amplitudes;
+    float high = 0;
+    float low = 0;
+    float previous = 0;
+    const uint64_t startTime = pros::micros();
+    uint32_t now = pros::millis();
+
+    while (this->motionRunning && pros::micros() - startTime < RELAY_TIMEOUT * 1000ull &&
+           int(crossings.size()) < settings.relayCycles + 2) {
+        const lemlib::Pose pose = getPose();
+        // how far past where it started the robot is
+        float position;
+        if (settings.angular) position = pose.theta - start.theta;
+        else position = (pose.x - start.x) * std::sin(startTheta) + (pose.y - start.y) * std::cos(startTheta);
+        const float time = (pros::micros() - startTime) / 1e6f;
+
+        if (previous < 0 && position >= 0) {
+            // a cycle ended. The first one starts from rest, so it doesn't count
+            if (!crossings.empty()) amplitudes.push_back((high - low) / 2);
+            crossings.push_back(time);
+            high = 0;
+            low = 0;
+        }
+        high = std::fmax(high, position);
+        low = std::fmin(low, position);
+        previous = position;
+
+        if (position > hysteresis) power = -settings.relayPower;
+        else if (position < -hysteresis) power = settings.relayPower;
+        drivetrain.leftMotors->move(power);
+        drivetrain.rightMotors->move(settings.angular ? -power : power);
+        pros::Task::delay_until(&now, SAMPLE_PERIOD);
+    }
+    const bool cancelled = !this->motionRunning;
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    if (!cancelled) pros::delay(REST_TIME);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+
+    RelayResult result;
+    if (cancelled) return result;
+    if (amplitudes.size() < 2) {
+        TIGER_WARN(lemlib::infoSink(), "Relay test didn't oscillate, try a higher relayPower");
+        return result;
+    }
+    // leave out the first cycle, it starts from rest
+    float amplitude = 0;
+    for (size_t i = 1; i < amplitudes.size(); i++) amplitude += amplitudes[i];
+    amplitude /= amplitudes.size() - 1;
+    result.amplitude = amplitude;
+    result.ultimatePeriod = (crossings.back() - crossings[1]) / (crossings.size() - 2);
+    // the describing function of a relay with hysteresis
+    const float effective = std::sqrt(std::fmax(amplitude * amplitude - hysteresis * hysteresis, 0));
+    if (effective > 0) result.ultimateGain = 4 * settings.relayPower / (M_PI * effective);
+    return result;
+}
+
+tiger::TuneTrial tiger::Chassis::runTuneTrial(TuneSettings settings, float direction) {
+    settings = resolve(settings);
+    const lemlib::Pose start = getPose();
+    const float startTheta = lemlib::degToRad(start.theta);
+    // the step is a motion of its own, which takes the mutex and stops when cancelled. The rest of the trial isn't,
+    // so it watches for cancels itself
+    const uint32_t startCancels = cancels.load();
+    if (settings.angular) {
+        turnToHeading(start.theta + direction * settings.step, settings.trialTime);
+    } else {
+        const float distance = direction * settings.step;
+        moveToPoint(start.x + distance * std::sin(startTheta), start.y + distance * std::cos(startTheta),
+                    settings.trialTime, {.forwards = direction > 0});
+    }
+
+    TuneTrial trial;
+    const uint32_t startTime = pros::millis();
+    uint32_t now = startTime;
+    float lastOutside = 0;
+    float remaining = settings.step;
+    float previousVoltage = 0;
+    // whether the step is over and the trial took the mutex, so nothing else drives while it settles
+    bool holding = false;
+    while (pros::millis() - startTime < settings.trialTime) {
+        if (cancels.load() != startCancels) break;
+        if (!holding && !isInMotion()) {
+            this->requestMotionStart();
+            holding = true;
+        }
+        if (holding && !this->motionRunning) break;
+        const lemlib::Pose pose = getPose();
+        // how far the robot still has to go. Negative once it's past the target
+        float traveled;
+        if (settings.angular) traveled = pose.theta - start.theta;
+        else traveled = (pose.x - start.x) * std::sin(startTheta) + (pose.y - start.y) * std::cos(startTheta);
+        remaining = settings.step - direction * traveled;
+        trial.overshoot = std::fmax(trial.overshoot, -remaining);
+        const float voltage = drivetrain.leftMotors->get_voltage() / 1000.0f;
+        trial.chatter += std::fabs(voltage - previousVoltage);
+        previousVoltage = voltage;
+        if (std::fabs(remaining) > settings.tolerance) lastOutside = (pros::millis() - startTime) / 1000.0f;
+        pros::Task::delay_until(&now, SAMPLE_PERIOD);
+    }
+    trial.cancelled = cancels.load() != startCancels || (holding && !this->motionRunning);
+    // stop the step if it's still going, without counting that as a cancel
+    if (!holding) lemlib::Chassis::cancelMotion();
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    if (!trial.cancelled) pros::delay(REST_TIME);
+    if (holding) {
+        distTraveled = -1;
+        this->endMotion();
+    }
+
+    trial.chatter /= settings.trialTime / 1000.0f;
+    trial.finalError = remaining;
+    trial.settled = std::fabs(remaining) <= settings.tolerance;
+    trial.settleTime = trial.settled ? lastOutside : settings.trialTime / 1000.0f;
+    return trial;
+}
+
+lemlib::ControllerSettings tiger::Chassis::tune(TuneSettings settings) {
+    settings = resolve(settings);
+    const lemlib::ControllerSettings original = settings.angular ? angularSettings : lateralSettings;
+    auto apply = [&](const lemlib::ControllerSettings& gains) {
+        if (settings.angular) setAngularSettings(gains);
+        else setLateralSettings(gains);
+    };
+    // cancelling any motion or test stops tuning, and keeps the gains it started with
+    const uint32_t startCancels = cancels.load();
+    auto cancelled = [&] {
+        if (cancels.load() == startCancels) return false;
+        apply(original);
+        TIGER_WARN(lemlib::infoSink(), "Tuning cancelled, keeping the original gains");
+        return true;
+    };
+    // a step there and back, so the robot ends up where it started
+    int tried = 0;
+    auto evaluate = [&](const lemlib::ControllerSettings& gains) {
+        apply(gains);
+        tried++;
+        const TuneTrial forwards = runTuneTrial(settings, 1);
+        const TuneTrial backwards = forwards.cancelled ? forwards : runTuneTrial(settings, -1);
+        const float score = (getTuneScore(forwards, settings) + getTuneScore(backwards, settings)) / 2;
+        TIGER_INFO(lemlib::infoSink(), "Tuning: kP {}, kD {} scored {}", gains.kP, gains.kD, score);
+        return score;
+    };
+
+    const RelayResult relay = runRelayTest(settings);
+    if (cancelled()) return original;
+    lemlib::ControllerSettings best = getRelayGains(relay, original);
+    // the search scales kD, so it can't start from 0
+    if (best.kD <= 0) best.kD = best.kP;
+    float bestScore = evaluate(best);
+    if (cancelled()) return original;
+
+    // pattern search in log space: try scaling each gain up and down, and shrink the scale once nothing helps
+    float scale = 2;
+    while (scale >= MIN_SCALE && tried < settings.candidates) {
+        bool improved = false;
+        const float factors[4][2] = {{scale, 1}, {1 / scale, 1}, {1, scale}, {1, 1 / scale}};
+        for (const auto& factor : factors) {
+            if (tried >= settings.candidates) break;
+            lemlib::ControllerSettings candidate = best;
+            candidate.kP *= factor[0];
+            candidate.kD *= factor[1];
+            const float score = evaluate(candidate);
+            if (cancelled()) return original;
+            if (score < bestScore) {
+                best = candidate;
+                bestScore = score;
+                improved = true;
+                break;
+            }
+        }
+        if (!improved) scale = std::sqrt(scale);
+    }
+
+    apply(best);
+    TIGER_INFO(lemlib::infoSink(), "Tuned {} gains: kP {}, kI {}, kD {}, scoring {}",
+               settings.angular ? "angular" : "lateral", best.kP, best.kI, best.kD, bestScore);
+    return best;
+}
@@ -0,0 +1,126 @@
+#include "tiger/log/deferred.hpp"
+#include "tiger/log/profiler.hpp"
+
+// records start on multiples of this many bytes, so their headers are aligned
+static constexpr size_t RECORD_ALIGNMENT = 8;
+
+static constexpr size_t align(size_t size) {
+    return (size + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT;
+}
+
+tiger::DeferredLog::DeferredLog(size_t capacity)
+    : ring(new uint8_t[align(capacity)]),
+      capacity(align(capacity)) {}
+
+tiger::DeferredLog::~DeferredLog() {
+    if (flushTask != nullptr) {
+        flushTask->remove();
+        delete flushTask;
+    }
+}
+
+uint8_t* tiger::DeferredLog::reserve(size_t argsSize) {
+    const size_t size = align(sizeof(Header) + argsSize);
+    producerMutex.take();
+    const size_t h = head.load(std::memory_order_relaxed);
+    const size_t t = tail.load(std::memory_order_acquire);
+    // the head may never catch up to the tail, or a full ring would look empty
+    bool fits;
+    size_t start = h;
+    if (h < t) {
+        fits = h + size < t;
+    } else if (h + size < capacity || (h + size == capacity && t != 0)) {
+        fits = true;
+    } else {
+        // doesn't fit before the end of the ring, so it goes at the start
+        start = 0;
+        fits = size < t;
+    }
+    if (!fits) {
+        producerMutex.give();
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    // tell the flushing task to skip the rest of the ring
+    if (start != h) {
+        const uint32_t wrap = 0;
+        std::memcpy(ring.get() + h, &wrap, sizeof(wrap));
+    }
+    pending = start;
+    pendingSize = size;
+    return ring.get() + start + sizeof(Header);
+}
+
+void tiger::DeferredLog::commit(lemlib::Level level, std::string_view format, DeferredFormatter formatter) {
+    const Header header {.size = uint32_t(pendingSize),
+                         .time = pros::millis(),
+                         .level = level,
+                         .format = format,
+                         .formatter = formatter};
+    std::memcpy(ring.get() + pending, &header, sizeof(header));
+    const size_t end = pending + pendingSize;
+    head.store(end == capacity ? 0 : end, std::memory_order_release);
+    producerMutex.give();
+}
+
+size_t tiger::DeferredLog::flush(const std::function<void(const DeferredRecord&)>& handler) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    const size_t h = head.load(std::memory_order_acquire);
+    size_t count = 0;
+    while (t != h) {
+        Header header;
+        std::memcpy(&header, ring.get() + t, sizeof(header));
+        if (header.size == 0) {
+            t = 0;
+            tail.store(t, std::memory_order_release);
+            continue;
+        }
+        handler(DeferredRecord {.level = header.level,
+                                .time = header.time,
+                                .format = header.format,
+                                .args = {ring.get() + t + sizeof(Header), header.size - sizeof(Header)},
+                                .formatter = header.formatter});
+        t += header.size;
+        if (t == capacity) t = 0;
+        // free the record's space right away, so producers don't have to wait for the whole flush
+        tail.store(t, std::memory_order_release);
+        count++;
+    }
+    return count;
+}
+
+void tiger::DeferredLog::startFlushTask(std::shared_ptr<lemlib::BaseSink> sink, uint32_t period, uint32_t priority) {
+    if (flushTask != nullptr) return;
+    flushTask = new pros::Task(
+        [this, sink, period] {
+            // reused between records, so it only allocates for messages longer than any before
+            fmt::memory_buffer message;
+            uint32_t reportedDrops = 0;
+            TaskProfile& profile = profiler().addTask("log flush", period);
+            uint32_t now = pros::millis();
+            while (true) {
+                profile.begin();
+                const uint32_t flushTime = pros::millis();
+                flush([&](const DeferredRecord& record) {
+                    message.clear();
+                    if (flushTime > record.time + period)
+                        fmt::format_to(fmt::appender(message), "[{} ms] ", record.time);
+                    record.formatTo(message);
+                    sink->log(record.level, "{}", std::string_view(message.data(), message.size()));
+                });
+                const uint32_t drops = getDropped();
+                if (drops != reportedDrops) {
+                    sink->warn("Deferred log full, dropped {} records", drops - reportedDrops);
+                    reportedDrops = drops;
+                }
+                profile.end();
+                pros::Task::delay_until(&now, period);
+            }
+        },
+        priority, TASK_STACK_DEPTH_DEFAULT, "deferred log flush");
+}
+
+tiger::DeferredLog& tiger::deferredLog() {
+    static DeferredLog log;
+    return log;
+}
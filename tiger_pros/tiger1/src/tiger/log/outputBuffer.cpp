@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include "tiger/log/outputBuffer.hpp"
+
+// strings start on multiples of this many bytes, so their headers are aligned and always fit before the end
+static constexpr uint32_t RECORD_ALIGNMENT = 8;
+// smallest ring, so the longest string is still a useful length
+static constexpr uint32_t MIN_CAPACITY = 256;
+
+static constexpr uint32_t align(uint32_t size) {
+    return (size + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT;
+}
+
+/**
+ * @brief Access the stamp of a header atomically. It's written last by producers, and read first by everyone else
+ */
+static std::atomic_ref<uint32_t> stamp(uint32_t& value) { return std::atomic_ref<uint32_t>(value); }
+
+tiger::OutputBuffer::OutputBuffer(std::function<void(std::string_view)> write, size_t capacity, FullPolicy policy,
+                                  uint32_t priority)
+    : write(std::move(write)),
+      ring(new uint8_t[std::bit_ceil(std::max<size_t>(capacity, MIN_CAPACITY))]()),
+      scratch(new char[std::bit_ceil(std::max<size_t>(capacity, MIN_CAPACITY)) / 4]),
+      capacity(std::bit_ceil(std::max<size_t>(capacity, MIN_CAPACITY))),
+      policy(policy),
+      task(
+          [this] {
+              while (true) {
+                  flush();
+                  // check again after saying so, or a push between the flush and the wait wouldn't notify
+                  sleeping = true;
+                  const uint32_t t = tail.load();
+                  if (t != head.load() && stamp(header(t)->stamp).load() == t + 1) {
+                      sleeping = false;
+                      continue;
+                  }
+                  pros::Task::notify_take(true, TIMEOUT_MAX);
+              }
+          },
+          priority, TASK_STACK_DEPTH_DEFAULT, "output buffer") {}
+
+tiger::OutputBuffer::~OutputBuffer() { task.remove(); }
+
+tiger::OutputBuffer::Header* tiger::OutputBuffer::header(uint32_t position) const {
+    return reinterpret_cast<Header*>(ring.get() + (position & (capacity - 1)));
+}
+
+bool tiger::OutputBuffer::push(std::string_view string) {
+    const uint32_t length = std::min<size_t>(string.size(), capacity / 4 - sizeof(Header));
+    const uint32_t size = align(sizeof(Header) + length);
+    while (true) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        const uint32_t t = tail.load(std::memory_order_acquire);
+        // a string never wraps around the end of the ring, the space before the end is skipped instead
+        const uint32_t offset = h & (capacity - 1);
+        const uint32_t padding = offset + size > capacity ? capacity - offset : 0;
+        if (h + padding + size - t > capacity) {
+            if (policy == FullPolicy::DROP_OLDEST && dropOldest()) continue;
+            if (policy == FullPolicy::BLOCK) {
+                if (sleeping.exchange(false)) task.notify();
+                pros::delay(1);
+                continue;
+            }
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (!head.compare_exchange_weak(h, h + padding + size, std::memory_order_acq_rel)) continue;
+        if (padding != 0) {
+            Header* skipped = header(h);
+            skipped->length = padding | PADDING;
+            stamp(skipped->stamp).store(h + 1);
+            h += padding;
+        }
+        Header* written = header(h);
+        written->length = length;
+        std::memcpy(written + 1, string.data(), length);
+        stamp(written->stamp).store(h + 1);
+        break;
+    }
+    if (sleeping.exchange(false)) task.notify();
+    return true;
+}
+
+bool tiger::OutputBuffer::dropOldest() {
+    uint32_t t = tail.load(std::memory_order_acquire);
+    if (t == head.load(std::memory_order_acquire)) return false;
+    Header* oldest = header(t);
+    // still being written, so it can't be dropped yet
+    if (stamp(oldest->stamp).load(std::memory_order_acquire) != t + 1) return false;
+    const uint32_t length = oldest->length;
+    const bool padding = length & PADDING;
+    const uint32_t size = padding ? length & ~PADDING : align(sizeof(Header) + length);
+    // if the string was freed and overwritten while this read it, the tail has moved on and this fails
+    if (tail.compare_exchange_strong(t, t + size, std::memory_order_acq_rel) && !padding)
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+size_t tiger::OutputBuffer::flush() {
+    size_t count = 0;
+    while (true) {
+        uint32_t t = tail.load(std::memory_order_acquire);
+        if (t == head.load(std::memory_order_acquire)) break;
+        Header* oldest = header(t);
+        // the oldest string isn't written yet. Its producer notifies once it is
+        if (stamp(oldest->stamp).load() != t + 1) break;
+        const uint32_t length = oldest->length;
+        const bool padding = length & PADDING;
+        uint32_t size = length & ~PADDING;
+        if (!padding) {
+            // a producer dropped and overwrote the string while this read it, so the tail has moved on
+            if (length > capacity / 4) continue;
+            std::memcpy(scratch.get(), oldest + 1, length);
+            size = align(sizeof(Header) + length);
+        }
+        // copied out first, so the space is free while the string is written
+        if (!tail.compare_exchange_strong(t, t + size, std::memory_order_acq_rel)) continue;
+        if (padding) continue;
+        write(std::string_view(scratch.get(), length));
+        count++;
+    }
+    return count;
+}
+
+bool tiger::OutputBuffer::isEmpty() const { return tail.load() == head.load(); }
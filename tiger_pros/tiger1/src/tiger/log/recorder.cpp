@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "lemlib/logger/logger.hpp"
+#include "tiger/log/level.hpp"
+#include "tiger/log/recorder.hpp"
+#include "tiger/log/profiler.hpp"
+
+// the SD card is written a sector at a time, so headers and blocks are padded to whole sectors
+static constexpr size_t SECTOR = 512;
+static constexpr uint16_t VERSION = 1;
+// highest number a recording's file name gets
+static constexpr int MAX_FILES = 1000;
+
+/**
+ * @brief Header at the start of a recording. The column names follow it
+ */
+struct FileHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t columns;
+        uint32_t blockRows;
+        uint32_t period;
+        uint32_t headerSize;
+        uint32_t blockSize;
+};
+
+static constexpr size_t padToSector(size_t size) { return (size + SECTOR - 1) / SECTOR * SECTOR; }
+
+/**
+ * @brief Convert a motor position to rotations of the motor's output, from whatever units the motor is set to
+ */
+static double toRotations(double position, pros::MotorUnits units, pros::MotorGears gears) {
+    switch (units) {
+        case pros::MotorUnits::degrees: return position / 360;
+        case pros::MotorUnits::rotations: return position;
+        case pros::MotorUnits::counts:
+            // encoder counts per rotation of the output, for each cartridge
+            switch (gears) {
+                case pros::MotorGears::red: return position / 1800;
+                case pros::MotorGears::green: return position / 900;
+                case pros::MotorGears::blue: return position / 300;
+                default: return NAN;
+            }
+        default: return NAN;
+    }
+}
+
+tiger::Recorder::Recorder(RecorderSettings settings)
+    : settings(settings) {
+    this->settings.blockRows = std::max<uint32_t>(this->settings.blockRows, 1);
+    this->settings.blockCount = std::max<uint32_t>(this->settings.blockCount, 2);
+}
+
+tiger::Recorder::~Recorder() {
+    if (sampleTask != nullptr) {
+        sampleTask->remove();
+        delete sampleTask;
+    }
+    if (writeTask != nullptr) {
+        writeTask->remove();
+        delete writeTask;
+    }
+    if (file != nullptr) std::fclose(file);
+}
+
+void tiger::Recorder::addColumns(std::vector<std::string> names, std::function<void(float*)> sample) {
+    if (file != nullptr) {
+        TIGER_WARN(lemlib::infoSink(), "Can't add columns to a recording that started, not recording {}", names[0]);
+        return;
+    }
+    sources.push_back({names.size(), std::move(sample)});
+    for (std::string& name : names) this->names.push_back(std::move(name));
+}
+
+void tiger::Recorder::addColumn(const std::string& name, std::function<float()> sample) {
+    addColumns({name}, [sample = std::move(sample)](float* out) { *out = sample(); });
+}
+
+void tiger::Recorder::addMotors(const std::string& name, pros::AbstractMotor* motors) {
+    const size_t count = motors->size();
+    std::vector<std::string> columns;
+    for (const char* quantity : {"velocity", "current", "voltage", "temperature", "position"}) {
+        for (size_t i = 0; i < count; i++) columns.push_back(name + "_" + quantity + std::to_string(i));
+    }
+    addColumns(std::move(columns), [motors, count](float* out) {
+        // a motor that was unplugged reads as NaN
+        auto fill = [&](const auto& values) {
+            for (size_t i = 0; i < count; i++) *out++ = i < values.size() ? float(values[i]) : NAN;
+        };
+        fill(motors->get_actual_velocity_all());
+        fill(motors->get_current_draw_all());
+        fill(motors->get_voltage_all());
+        fill(motors->get_temperature_all());
+        // LemLib switches the drivetrain's motors to rotations, but only the ones it uses as tracking wheels
+        std::vector<double> positions = motors->get_position_all();
+        const std::vector<pros::MotorUnits> units = motors->get_encoder_units_all();
+        const std::vector<pros::MotorGears> gears = motors->get_gearing_all();
+        for (size_t i = 0; i < positions.size(); i++) {
+            positions[i] = i < units.size() && i < gears.size() ? toRotations(positions[i], units[i], gears[i]) : NAN;
+        }
+        fill(positions);
+    });
+}
+
+void tiger::Recorder::addImu(const std::string& name, pros::Imu* imu) {
+    addColumns({name + "_rotation", name + "_rate", name + "_accel_x", name + "_accel_y"}, [imu](float* out) {
+        const pros::imu_gyro_s_t rate = imu->get_gyro_rate();
+        const pros::imu_accel_s_t accel = imu->get_accel();
+        out[0] = imu->get_rotation();
+        out[1] = rate.z;
+        out[2] = accel.x;
+        out[3] = accel.y;
+    });
+}
+
+void tiger::Recorder::addTrackingWheel(const std::string& name, lemlib::TrackingWheel* wheel) {
+    addColumn(name, [wheel] { return wheel->getDistanceTraveled(); });
+}
+
+void tiger::Recorder::addPose(const std::string& name, lemlib::Chassis* chassis) {
+    addColumns({name + "_x", name + "_y", name + "_theta"}, [chassis](float* out) {
+        const lemlib::Pose pose = chassis->getPose();
+        out[0] = pose.x;
+        out[1] = pose.y;
+        out[2] = pose.theta;
+    });
+}
+
+bool tiger::Recorder::start() {
+    if (file != nullptr) return false;
+    // a new file each time, so recordings of earlier matches are kept
+    for (int number = 0; number < MAX_FILES; number++) {
+        char name[8];
+        std::snprintf(name, sizeof(name), "%03d", number);
+        path = settings.prefix + name + ".rec";
+        FILE* existing = std::fopen(path.c_str(), "rb");
+        if (existing == nullptr) break;
+        std::fclose(existing);
+    }
+    file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        TIGER_WARN(lemlib::infoSink(), "Couldn't open {}, not recording", path);
+        path.clear();
+        return false;
+    }
+    // blocks are already as large as a write can be, so stdio's buffer would only add a copy
+    std::setvbuf(file, nullptr, _IONBF, 0);
+
+    std::string columns;
+    for (size_t i = 0; i < names.size(); i++) {
+        if (i != 0) columns += ',';
+        columns += names[i];
+    }
+    const size_t headerSize = padToSector(sizeof(FileHeader) + columns.size() + 1);
+    blockSize = padToSector(sizeof(BlockHeader) + (names.size() + 1) * sizeof(float) * settings.blockRows);
+    const FileHeader header {{'T', 'R', 'E', 'C'}, VERSION, uint16_t(names.size()), settings.blockRows,
+                             settings.period, uint32_t(headerSize), uint32_t(blockSize)};
+    std::vector<uint8_t> headerBytes(headerSize);
+    std::memcpy(headerBytes.data(), &header, sizeof(header));
+    std::memcpy(headerBytes.data() + sizeof(header), columns.c_str(), columns.size() + 1);
+    std::fwrite(headerBytes.data(), 1, headerBytes.size(), file);
+    std::fflush(file);
+
+    blocks.reset(static_cast<uint8_t*>(std::aligned_alloc(SECTOR, blockSize * settings.blockCount)));
+    std::memset(blocks.get(), 0, blockSize * settings.blockCount);
+    row.assign(names.size(), 0);
+    filled = 0;
+    written = 0;
+    rows = 0;
+    dropped = 0;
+    stopping = false;
+    sampling = true;
+    writing = true;
+
+    writeTask = new pros::Task {[this] {
+                                    TaskProfile& profile = profiler().addTask("recorder write", 0);
+                                    while (true) {
+                                        pros::Task::notify_take(true, TIMEOUT_MAX);
+                                        profile.begin();
+                                        writeBlocks();
+                                        profile.end();
+                                        if (!sampling && written == filled) break;
+                                    }
+                                    writing = false;
+                                },
+                                settings.writePriority, TASK_STACK_DEPTH_DEFAULT, "recorder write"};
+    sampleTask = new pros::Task {[this] {
+                                     TaskProfile& profile = profiler().addTask("recorder", settings.period);
+                                     uint32_t now = pros::millis();
+                                     while (!stopping) {
+                                         profile.begin();
+                                         sample();
+                                         profile.end();
+                                         pros::Task::delay_until(&now, settings.period);
+                                     }
+                                     if (rows != 0) finishBlock();
+                                     // once more, for the write task to see that sampling stopped
+                                     sampling = false;
+                                     writeTask->notify();
+                                 },
+                                 settings.samplePriority, TASK_STACK_DEPTH_DEFAULT, "recorder sample"};
+    return true;
+}
+
+void tiger::Recorder::stop() {
+    if (file == nullptr) return;
+    stopping = true;
+    while (writing) pros::delay(settings.period);
+    delete sampleTask;
+    delete writeTask;
+    sampleTask = nullptr;
+    writeTask = nullptr;
+    std::fclose(file);
+    file = nullptr;
+    blocks.reset();
+    path.clear();
+}
+
+uint8_t* tiger::Recorder::block(uint32_t sequence) const {
+    return blocks.get() + sequence % settings.blockCount * blockSize;
+}
+
+void tiger::Recorder::sample() {
+    // the block being filled is free until the write task is every block behind
+    if (rows == 0 &&
+        filled.load(std::memory_order_relaxed) - written.load(std::memory_order_acquire) >= settings.blockCount) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    float* values = row.data();
+    for (Source& source : sources) {
+        source.sample(values);
+        values += source.count;
+    }
+
+    // stored a column at a time, so each column is contiguous in the file
+    uint8_t* current = block(filled.load(std::memory_order_relaxed));
+    uint32_t* times = reinterpret_cast<uint32_t*>(current + sizeof(BlockHeader));
+    float* columns = reinterpret_cast<float*>(times + settings.blockRows);
+    times[rows] = pros::millis();
+    for (size_t column = 0; column < row.size(); column++) columns[column * settings.blockRows + rows] = row[column];
+    if (++rows == settings.blockRows) finishBlock();
+}
+
+void tiger::Recorder::finishBlock() {
+    const uint32_t sequence = filled.load(std::memory_order_relaxed);
+    const BlockHeader header {{'T', 'B', 'L', 'K'}, sequence, rows, dropped.load(std::memory_order_relaxed)};
+    std::memcpy(block(sequence), &header, sizeof(header));
+    filled.store(sequence + 1, std::memory_order_release);
+    rows = 0;
+    writeTask->notify();
+}
+
+void tiger::Recorder::writeBlocks() {
+    uint32_t sequence = written.load(std::memory_order_relaxed);
+    while (sequence != filled.load(std::memory_order_acquire)) {
+        // a block is a whole number of sectors, so the card never has to read a sector back to write part of it
+        if (std::fwrite(block(sequence), 1, blockSize, file) != blockSize)
+            TIGER_WARN(lemlib::infoSink(), "Couldn't write to {}, the recording is missing a block", path);
+        std::fflush(file);
+        written.store(++sequence, std::memory_order_release);
+    }
+}
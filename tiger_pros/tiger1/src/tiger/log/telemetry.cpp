@@ -0,0 +1,139 @@
+#include "lemlib/logger/logger.hpp"
+#include "tiger/log/level.hpp"
+#include "tiger/log/telemetry.hpp"
+
+// packet types
+static constexpr uint8_t SCHEMA = 0;
+static constexpr uint8_t DATA = 1;
+// longest packet, without its CRC. Type, channel, time and the values of a channel
+static constexpr size_t MAX_PACKET = 2 + sizeof(uint32_t) + tiger::Telemetry::MAX_PAYLOAD;
+// longest frame. COBS adds a byte per 254, plus the zero bytes on both ends
+static constexpr size_t MAX_FRAME = MAX_PACKET + 1 + (MAX_PACKET + 1) / 254 + 1 + 2;
+
+// CRC-8 with polynomial 0x07, a byte at a time
+static constexpr std::array<uint8_t, 256> CRC_TABLE = [] {
+    std::array<uint8_t, 256> table {};
+    for (int byte = 0; byte < 256; byte++) {
+        uint8_t crc = byte;
+        for (int bit = 0; bit < 8; bit++) crc = crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1;
+        table[byte] = crc;
+    }
+    return table;
+}();
+
+static uint8_t crc8(const uint8_t* data, size_t size) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < size; i++) crc = CRC_TABLE[crc ^ data[i]];
+    return crc;
+}
+
+/**
+ * @brief COBS encode a packet, with a zero byte before and after it
+ *
+ * @return size_t bytes of frame
+ */
+static size_t encodeFrame(const uint8_t* packet, size_t size, uint8_t* frame) {
+    size_t out = 0;
+    frame[out++] = 0;
+    // every block starts with the distance to the next zero, which the block leaves out
+    size_t codeIndex = out++;
+    uint8_t code = 1;
+    for (size_t i = 0; i < size; i++) {
+        if (packet[i] != 0) {
+            frame[out++] = packet[i];
+            code++;
+        }
+        if (packet[i] == 0 || code == 0xFF) {
+            frame[codeIndex] = code;
+            codeIndex = out++;
+            code = 1;
+        }
+    }
+    frame[codeIndex] = code;
+    frame[out++] = 0;
+    return out;
+}
+
+tiger::Telemetry::Telemetry(std::shared_ptr<OutputBuffer> output, uint32_t schemaPeriod)
+    : schemaPeriod(schemaPeriod) {
+    if (output != nullptr) setOutput(output);
+}
+
+void tiger::Telemetry::setOutput(std::shared_ptr<OutputBuffer> output) {
+    mutex.take();
+    this->output = output.get();
+    if (output != nullptr) outputs.push_back(std::move(output));
+    mutex.give();
+    sendSchemas();
+}
+
+uint8_t tiger::Telemetry::addSchema(const std::string& name, const std::string& format,
+                                    std::vector<const char*> fields) {
+    std::string packet {char(SCHEMA), '\0'};
+    packet += name + '\0' + format + '\0';
+    for (size_t i = 0; i < fields.size(); i++) {
+        if (i != 0) packet += ',';
+        packet += fields[i];
+    }
+    packet += '\0';
+    if (packet.size() > MAX_PACKET) {
+        TIGER_WARN(lemlib::infoSink(), "Telemetry schema of {} is too long, shorten its field names", name);
+        packet.resize(MAX_PACKET);
+    }
+
+    mutex.take();
+    const size_t count = schemas.size();
+    const uint8_t channel = count;
+    packet[1] = channel;
+    schemas.push_back(packet);
+    OutputBuffer* current = output.load();
+    mutex.give();
+    if (count >= 256) TIGER_WARN(lemlib::infoSink(), "More than 256 telemetry channels, {} shares a number", name);
+    // tell the decoder about the channel before its first sample
+    if (current != nullptr) {
+        uint8_t buffer[MAX_PACKET + 1];
+        std::memcpy(buffer, packet.data(), packet.size());
+        sendPacket(current, buffer, packet.size());
+    }
+    return channel;
+}
+
+void tiger::Telemetry::sendSchemas() {
+    OutputBuffer* current = output.load();
+    if (current == nullptr) return;
+    uint8_t buffer[MAX_PACKET + 1];
+    mutex.take();
+    for (const std::string& packet : schemas) {
+        std::memcpy(buffer, packet.data(), packet.size());
+        sendPacket(current, buffer, packet.size());
+    }
+    mutex.give();
+}
+
+void tiger::Telemetry::send(uint8_t channel, const uint8_t* payload, size_t size) {
+    OutputBuffer* current = output.load(std::memory_order_acquire);
+    if (current == nullptr) return;
+    const uint32_t now = pros::millis();
+    // repeat the schemas now and then, for decoders that started listening late
+    uint32_t last = schemaTime.load(std::memory_order_relaxed);
+    if (now - last >= schemaPeriod && schemaTime.compare_exchange_strong(last, now)) sendSchemas();
+
+    uint8_t packet[MAX_PACKET + 1];
+    packet[0] = DATA;
+    packet[1] = channel;
+    std::memcpy(packet + 2, &now, sizeof(now));
+    std::memcpy(packet + 2 + sizeof(now), payload, size);
+    sendPacket(current, packet, 2 + sizeof(now) + size);
+}
+
+void tiger::Telemetry::sendPacket(OutputBuffer* output, uint8_t* packet, size_t size) {
+    packet[size] = crc8(packet, size);
+    uint8_t frame[MAX_FRAME];
+    const size_t frameSize = encodeFrame(packet, size + 1, frame);
+    output->push(std::string_view(reinterpret_cast<const char*>(frame), frameSize));
+}
+
+tiger::Telemetry& tiger::telemetry() {
+    static Telemetry telemetry;
+    return telemetry;
+}
@@ -0,0 +1,64 @@
+#include <cmath>
+#include <utility>
+#include "tiger/motion/feedforward.hpp"
+
+// determinants below this mean two terms can't be told apart
+static constexpr double SINGULAR = 1e-9;
+
+float tiger::Feedforward::getVoltage(float velocity, float acceleration) const {
+    const float direction = velocity != 0 ? velocity : acceleration;
+    const float sign = direction > 0 ? 1 : direction < 0 ? -1 : 0;
+    return kS * sign + kV * velocity + kA * acceleration;
+}
+
+float tiger::Feedforward::getPower(float velocity, float acceleration) const {
+    return getVoltage(velocity, acceleration) * 127 / 12;
+}
+
+void tiger::FeedforwardFit::add(float voltage, float velocity, float acceleration) {
+    const double x[3] = {velocity > 0 ? 1.0 : velocity < 0 ? -1.0 : 0.0, velocity, acceleration};
+    for (int row = 0; row < 3; row++) {
+        for (int column = 0; column < 3; column++) xx[row][column] += x[row] * x[column];
+        xy[row] += x[row] * voltage;
+    }
+    yy += double(voltage) * voltage;
+    y += voltage;
+    count++;
+}
+
+tiger::Feedforward tiger::FeedforwardFit::solve() const {
+    // solve the normal equations with gaussian elimination
+    double a[3][4];
+    for (int row = 0; row < 3; row++) {
+        for (int column = 0; column < 3; column++) a[row][column] = xx[row][column];
+        a[row][3] = xy[row];
+    }
+    for (int pivot = 0; pivot < 3; pivot++) {
+        int best = pivot;
+        for (int row = pivot + 1; row < 3; row++)
+            if (std::fabs(a[row][pivot]) > std::fabs(a[best][pivot])) best = row;
+        if (std::fabs(a[best][pivot]) < SINGULAR * (1 + std::fabs(xx[pivot][pivot]))) return {};
+        std::swap(a[pivot], a[best]);
+        for (int row = 0; row < 3; row++) {
+            if (row == pivot) continue;
+            const double factor = a[row][pivot] / a[pivot][pivot];
+            for (int column = pivot; column < 4; column++) a[row][column] -= factor * a[pivot][column];
+        }
+    }
+    return {float(a[0][3] / a[0][0]), float(a[1][3] / a[1][1]), float(a[2][3] / a[2][2])};
+}
+
+float tiger::FeedforwardFit::getRSquared() const {
+    if (count < 2) return 0;
+    const Feedforward fit = solve();
+    const double beta[3] = {fit.kS, fit.kV, fit.kA};
+    // the residual sum of squares, expanded so it only needs the sums
+    double residual = yy;
+    for (int row = 0; row < 3; row++) {
+        residual -= 2 * beta[row] * xy[row];
+        for (int column = 0; column < 3; column++) residual += beta[row] * xx[row][column] * beta[column];
+    }
+    const double total = yy - y * y / count;
+    if (total <= 0) return 0;
+    return std::fmax(0, 1 - residual / total);
+}
@@ -0,0 +1,114 @@
+#include <cmath>
+#include <algorithm>
+#include "tiger/motion/profile.hpp"
+
+// iterations of the bisection used to find the peak velocity. Enough to get well below a thousandth of a unit
+static constexpr int SEARCH_ITERATIONS = 32;
+
+tiger::MotionProfile::Transition::Transition(float startVelocity, float endVelocity,
+                                             const ProfileConstraints& constraints)
+    : startVelocity(startVelocity),
+      endVelocity(endVelocity) {
+    const float change = std::fabs(endVelocity - startVelocity);
+    const float sign = endVelocity >= startVelocity ? 1 : -1;
+    const float maxAccel = constraints.maxAcceleration;
+    const float maxJerk = constraints.maxJerk;
+    if (change == 0 || maxAccel <= 0) return;
+
+    if (maxJerk <= 0) {
+        // trapezoidal, acceleration changes instantly
+        accelTime = change / maxAccel;
+        acceleration = sign * maxAccel;
+    } else if (change >= maxAccel * maxAccel / maxJerk) {
+        // the acceleration limit is reached, so there's a constant acceleration phase
+        jerkTime = maxAccel / maxJerk;
+        accelTime = change / maxAccel - jerkTime;
+        acceleration = sign * maxAccel;
+    } else {
+        // the change is too small to reach the acceleration limit
+        jerkTime = std::sqrt(change / maxJerk);
+        acceleration = sign * maxJerk * jerkTime;
+    }
+}
+
+tiger::ProfileState tiger::MotionProfile::Transition::sample(float time) const {
+    time = std::clamp(time, 0.0f, duration());
+    const float jerk = jerkTime > 0 ? acceleration / jerkTime : 0;
+
+    // jerk towards the peak acceleration
+    if (time < jerkTime) return {startVelocity * time + jerk * time * time * time / 6,
+                                 startVelocity + jerk * time * time / 2, jerk * time};
+    const float velocity1 = startVelocity + acceleration * jerkTime / 2;
+    const float position1 = startVelocity * jerkTime + acceleration * jerkTime * jerkTime / 6;
+
+    // constant acceleration
+    if (time < jerkTime + accelTime) {
+        const float t = time - jerkTime;
+        return {position1 + velocity1 * t + acceleration * t * t / 2, velocity1 + acceleration * t, acceleration};
+    }
+    const float velocity2 = velocity1 + acceleration * accelTime;
+    const float position2 = position1 + velocity1 * accelTime + acceleration * accelTime * accelTime / 2;
+
+    // jerk back to 0 acceleration
+    const float t = time - jerkTime - accelTime;
+    return {position2 + velocity2 * t + acceleration * t * t / 2 - jerk * t * t * t / 6,
+            velocity2 + acceleration * t - jerk * t * t / 2, acceleration - jerk * t};
+}
+
+tiger::MotionProfile::MotionProfile(float distance, ProfileConstraints constraints, float startVelocity,
+                                    float endVelocity)
+    : distance(distance) {
+    const float maxVelocity = constraints.maxVelocity;
+    if (distance <= 0 || maxVelocity <= 0 || constraints.maxAcceleration <= 0) return;
+    startVelocity = std::clamp(startVelocity, 0.0f, maxVelocity);
+    endVelocity = std::clamp(endVelocity, 0.0f, maxVelocity);
+
+    // the distance is too short to even go from the start velocity to the end velocity, so get as close as we can
+    if (Transition(startVelocity, endVelocity, constraints).distance() > distance) {
+        float reachable = startVelocity;
+        float unreachable = endVelocity;
+        for (int i = 0; i < SEARCH_ITERATIONS; i++) {
+            const float velocity = (reachable + unreachable) / 2;
+            if (Transition(startVelocity, velocity, constraints).distance() <= distance) reachable = velocity;
+            else unreachable = velocity;
+        }
+        accel = Transition(startVelocity, reachable, constraints);
+        decel = Transition(reachable, reachable, constraints);
+        this->distance = accel.distance();
+        return;
+    }
+
+    // find the highest peak velocity that still leaves room to slow down to the end velocity
+    const auto travel = [&](float peak) {
+        return Transition(startVelocity, peak, constraints).distance() +
+               Transition(peak, endVelocity, constraints).distance();
+    };
+    float peak = maxVelocity;
+    if (travel(maxVelocity) > distance) {
+        float reachable = std::max(startVelocity, endVelocity);
+        float unreachable = maxVelocity;
+        for (int i = 0; i < SEARCH_ITERATIONS; i++) {
+            const float velocity = (reachable + unreachable) / 2;
+            if (travel(velocity) <= distance) reachable = velocity;
+            else unreachable = velocity;
+        }
+        peak = reachable;
+    }
+
+    accel = Transition(startVelocity, peak, constraints);
+    decel = Transition(peak, endVelocity, constraints);
+    cruiseVelocity = peak;
+    // whatever distance the transitions don't cover is covered at the peak velocity
+    if (peak > 0) cruiseTime = std::max(0.0f, (distance - accel.distance() - decel.distance()) / peak);
+}
+
+tiger::ProfileState tiger::MotionProfile::sample(float time) const {
+    if (time < accel.duration()) return accel.sample(time);
+    time -= accel.duration();
+    if (time < cruiseTime) return {accel.distance() + cruiseVelocity * time, cruiseVelocity, 0};
+    ProfileState state = decel.sample(time - cruiseTime);
+    state.position += accel.distance() + cruiseVelocity * cruiseTime;
+    return state;
+}
+
+float tiger::MotionProfile::getDuration() const { return accel.duration() + cruiseTime + decel.duration(); }
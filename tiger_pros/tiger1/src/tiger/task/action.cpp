@@ -0,0 +1,90 @@
+#include "pros/rtos.hpp"
+#include "tiger/task/action.hpp"
+
+std::coroutine_handle<> tiger::Action::promise_type::FinalAwaiter::await_suspend(
+    std::coroutine_handle<promise_type> handle) noexcept {
+    promise_type& promise = handle.promise();
+    // only the last of a whenAll() resumes the Action waiting on it
+    if (promise.remaining != nullptr && --*promise.remaining != 0) return std::noop_coroutine();
+    if (promise.continuation) return promise.continuation;
+    return std::noop_coroutine();
+}
+
+tiger::Action::Action(Action&& other) noexcept
+    : handle(std::exchange(other.handle, nullptr)) {}
+
+tiger::Action& tiger::Action::operator=(Action&& other) noexcept {
+    if (this != &other) {
+        if (handle) handle.destroy();
+        handle = std::exchange(other.handle, nullptr);
+    }
+    return *this;
+}
+
+tiger::Action::~Action() {
+    if (handle) handle.destroy();
+}
+
+bool tiger::Action::isDone() const { return !handle || handle.done(); }
+
+std::coroutine_handle<> tiger::Action::await_suspend(std::coroutine_handle<promise_type> awaiter) {
+    handle.promise().runner = awaiter.promise().runner;
+    handle.promise().continuation = awaiter;
+    return handle;
+}
+
+void tiger::Action::start(ActionRunner* runner) {
+    handle.promise().runner = runner;
+    handle.resume();
+}
+
+void tiger::Condition::await_suspend(std::coroutine_handle<Action::promise_type> awaiter) {
+    awaiter.promise().runner->wait(awaiter, std::move(condition));
+}
+
+bool tiger::WhenAll::await_suspend(std::coroutine_handle<Action::promise_type> awaiter) {
+    // one more than there are Actions until they've all started, so one that finishes straight away can't resume the
+    // awaiting Action while it's still suspending
+    remaining = actions.size() + 1;
+    for (Action& action : actions) {
+        if (action.isDone()) {
+            remaining--;
+            continue;
+        }
+        action.handle.promise().continuation = awaiter;
+        action.handle.promise().remaining = &remaining;
+        action.start(awaiter.promise().runner);
+    }
+    // if every Action already finished, carry on without suspending
+    return --remaining != 0;
+}
+
+tiger::ActionRunner::ActionRunner(uint32_t period)
+    : period(period) {}
+
+void tiger::ActionRunner::run(Action action) {
+    if (action.isDone()) return;
+    action.start(this);
+    uint32_t now = pros::millis();
+    while (!action.isDone()) {
+        pros::Task::delay_until(&now, period);
+        // resumed Actions can wait again, and those waits are for the next tick
+        checking.swap(waiters);
+        for (Waiter& waiter : checking) {
+            if (waiter.condition()) waiter.handle.resume();
+            else waiters.push_back(std::move(waiter));
+        }
+        checking.clear();
+    }
+}
+
+void tiger::ActionRunner::wait(std::coroutine_handle<> handle, std::function<bool()> condition) {
+    waiters.push_back({handle, std::move(condition)});
+}
+
+tiger::Condition tiger::waitUntil(std::function<bool()> condition) { return Condition(std::move(condition)); }
+
+tiger::Condition tiger::delayMs(uint32_t time) {
+    const uint32_t end = pros::millis() + time;
+    return Condition([end] { return pros::millis() >= end; });
+}
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <string>
+#include "tiger/task/executor.hpp"
+#include "tiger/log/deferred.hpp"
+
+void tiger::Executor::add(const std::string& name, uint32_t period, uint32_t priority,
+                          std::function<void()> update) {
+    std::unique_ptr<Subsystem> subsystem(
+        new Subsystem {name, period, priority, std::move(update), &profiler().addTask(name, period), pros::millis()});
+
+    mutex.take();
+    subsystems.push_back(subsystem.get());
+    Group* group = nullptr;
+    for (const std::unique_ptr<Group>& existing : groups) {
+        if (existing->priority == priority) group = existing.get();
+    }
+    if (group == nullptr) {
+        group = groups.emplace_back(new Group {priority, {}}).get();
+        // the subsystem goes in before the task starts, so the task never sees an empty group and sleeps forever
+        group->subsystems.push_back(std::move(subsystem));
+        // named by priority, so the profiler can tell the tasks apart
+        const std::string taskName = "executor " + std::to_string(priority);
+        group->task = new pros::Task {[this, group] { run(group); }, priority, TASK_STACK_DEPTH_DEFAULT,
+                                      taskName.c_str()};
+    } else {
+        group->mutex.take();
+        group->subsystems.push_back(std::move(subsystem));
+        group->mutex.give();
+    }
+    mutex.give();
+}
+
+void tiger::Executor::run(Group* group) {
+    // reused every time, so the loop doesn't allocate once it's seen every subsystem
+    std::vector<Subsystem*> due;
+    while (true) {
+        // only add() ever holds this lock too, so no other group can hold this one up
+        group->mutex.take();
+        uint32_t now = pros::millis();
+        uint32_t next = UINT32_MAX;
+        due.clear();
+        for (const std::unique_ptr<Subsystem>& subsystem : group->subsystems) {
+            if (subsystem->due <= now) due.push_back(subsystem.get());
+            else next = std::min(next, subsystem->due);
+        }
+        group->mutex.give();
+
+        // run what's due, then look again, since running it set new deadlines and may have taken a while
+        if (!due.empty()) {
+            for (Subsystem* subsystem : due) runUpdate(subsystem);
+            continue;
+        }
+        pros::Task::delay_until(&now, next - now);
+    }
+}
+
+void tiger::Executor::runUpdate(Subsystem* subsystem) {
+    const uint64_t start = pros::micros();
+    subsystem->profile->begin();
+    subsystem->update();
+    subsystem->profile->end();
+    const uint64_t runTime = pros::micros() - start;
+    const uint64_t due = uint64_t(subsystem->due) * 1000;
+    const uint64_t lateness = start > due ? start - due : 0;
+
+    // finished after the next update was due, so skip it rather than run it late
+    const uint32_t next = subsystem->due + subsystem->period;
+    const bool missed = pros::millis() >= next;
+    subsystem->due = missed ? pros::millis() + subsystem->period : next;
+    Timing& timing = subsystem->timing;
+    timing.runs++;
+    if (missed) timing.misses++;
+    timing.runTime.add(runTime * 1000);
+    timing.lateness.add(lateness * 1000);
+    subsystem->published.store(timing);
+    if (missed) {
+        deferredLog().warn("{} missed its deadline: ran {} us, started {} us late", subsystem->name.c_str(), runTime,
+                           lateness);
+    }
+}
+
+std::vector<tiger::SubsystemStats> tiger::Executor::getStats() {
+    std::vector<SubsystemStats> stats;
+    // the executor's mutex keeps this the only reader of each published copy, and no group ever waits for it
+    mutex.take();
+    for (Subsystem* subsystem : subsystems) {
+        const Timing timing = subsystem->published.load();
+        SubsystemStats& entry = stats.emplace_back();
+        entry.name = subsystem->name;
+        entry.period = subsystem->period;
+        entry.priority = subsystem->priority;
+        entry.runs = timing.runs;
+        entry.misses = timing.misses;
+        entry.runTime = timing.runTime;
+        entry.lateness = timing.lateness;
+    }
+    mutex.give();
+    return stats;
+}
+
+size_t tiger::Executor::getTaskCount() {
+    mutex.take();
+    const size_t count = groups.size();
+    mutex.give();
+    return count;
+}
+
+tiger::Executor& tiger::executor() {
+    static Executor executor;
+    return executor;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include "lemlib/pose.hpp"
+
+namespace tiger {
+/**
+ * @brief A pose and the time it was measured
+ */
+struct PoseSample {
+        /** the pose, theta in radians */
+        lemlib::Pose pose;
+        /** time the pose was measured, in microseconds. Wraps around after ~71 minutes */
+        uint32_t time;
+};
+
+/**
+ * @brief Ring buffer of recent poses with lock-free readers
+ *
+ * Every slot is protected by its own sequence counter (a seqlock). The writer never waits on a reader, and a reader
+ * never takes a mutex, so a display or logging task can't hold up odometry and odometry can't block them. A reader
+ * that races with a write to the slot it is copying simply copies it again.
+ *
+ * There must only be a single writer at a time. Any number of tasks can read.
+ */
+class PoseHistory {
+    public:
+        /** number of poses kept. At a 10ms odometry period this is 640ms of history */
+        static constexpr uint32_t SIZE = 64;
+        /**
+         * @brief Add a new pose. Overwrites the oldest pose when full
+         *
+         * @param pose the pose, theta in radians
+         * @param time time the pose was measured, in microseconds
+         */
+        void push(lemlib::Pose pose, uint32_t time);
+        /**
+         * @brief Forget all poses pushed so far
+         *
+         * Used when the pose is set by hand, so lookups never interpolate across the jump.
+         *
+         * @note like push(), this must not be called concurrently with another writer
+         */
+        void clear();
+        /**
+         * @brief Get the most recent pose
+         *
+         * @return std::optional<PoseSample> nothing if no pose has been pushed yet
+         */
+        std::optional<PoseSample> latest() const;
+        /**
+         * @brief Get the pose at a given time
+         *
+         * Interpolates between the two poses surrounding the requested time. Times older than the history are clamped
+         * to the oldest pose, and times newer than the latest pose are extrapolated from the recent motion.
+         *
+         * @param time the time, in microseconds
+         * @return std::optional<lemlib::Pose> nothing if no pose has been pushed yet
+         */
+        std::optional<lemlib::Pose> at(uint32_t time) const;
+    private:
+        struct Slot {
+                std::atomic<uint32_t> seq {0};
+                std::atomic<uint32_t> index {0};
+                std::atomic<uint32_t> time {0};
+                std::atomic<float> x {0};
+                std::atomic<float> y {0};
+                std::atomic<float> theta {0};
+        };
+
+        /**
+         * @brief Copy the pose with the given index out of the ring
+         *
+         * @param index index of the pose, counting every pose ever pushed
+         * @return std::optional<PoseSample> nothing if the slot has since been overwritten by a newer pose
+         */
+        std::optional<PoseSample> read(uint32_t index) const;
+
+        std::array<Slot, SIZE> slots;
+        /** number of poses ever pushed */
+        std::atomic<uint32_t> count {0};
+        /** index of the oldest pose that is still valid */
+        std::atomic<uint32_t> first {0};
+};
+} // namespace tiger
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+#include "lemlib/logger/message.hpp"
+
+/**
+ * Log levels for TIGER_LOG_LEVEL. Unlike lemlib::Level, these go from least to most severe
+ */
+#define TIGER_LOG_LEVEL_DEBUG 0
+#define TIGER_LOG_LEVEL_INFO 1
+#define TIGER_LOG_LEVEL_WARN 2
+#define TIGER_LOG_LEVEL_ERROR 3
+#define TIGER_LOG_LEVEL_FATAL 4
+
+/**
+ * The least severe level that is compiled in. Set by each project's Makefile from LOG_LEVEL, like
+ * "make LOG_LEVEL=DEBUG". Everything is compiled in when it isn't set, like on the host
+ */
+#ifndef TIGER_LOG_LEVEL
+#define TIGER_LOG_LEVEL TIGER_LOG_LEVEL_DEBUG
+#endif
+
+namespace tiger {
+/**
+ * @brief Get how severe a level is, from TIGER_LOG_LEVEL_DEBUG to TIGER_LOG_LEVEL_FATAL
+ */
+constexpr int getSeverity(lemlib::Level level) {
+    switch (level) {
+        case lemlib::Level::DEBUG: return TIGER_LOG_LEVEL_DEBUG;
+        case lemlib::Level::INFO: return TIGER_LOG_LEVEL_INFO;
+        case lemlib::Level::WARN: return TIGER_LOG_LEVEL_WARN;
+        case lemlib::Level::ERROR: return TIGER_LOG_LEVEL_ERROR;
+        case lemlib::Level::FATAL: return TIGER_LOG_LEVEL_FATAL;
+    }
+    return TIGER_LOG_LEVEL_FATAL;
+}
+
+/**
+ * @brief Check whether messages of a level are compiled in
+ */
+constexpr bool isCompiledIn(lemlib::Level level) { return getSeverity(level) >= TIGER_LOG_LEVEL; }
+
+namespace detail {
+/**
+ * @brief Get the sink a log macro was given, whether it's a reference or a shared pointer like lemlib::infoSink()
+ */
+template <typename S> S& getSink(S& sink) { return sink; }
+
+template <typename S> S& getSink(const std::shared_ptr<S>& sink) { return *sink; }
+} // namespace detail
+} // namespace tiger
+
+/**
+ * @brief Log a message, unless its level is below TIGER_LOG_LEVEL
+ *
+ * Below TIGER_LOG_LEVEL, the call compiles to nothing. The sink and the arguments aren't evaluated, and no formatting
+ * code ends up in the program. The format string is still checked.
+ *
+ * @b Example
+ * @code {.cpp}
+ * // gone from builds with LOG_LEVEL=INFO or above
+ * TIGER_DEBUG(lemlib::infoSink(), "Lateral Out: {}", lateralOut);
+ * TIGER_INFO(tiger::deferredLog(), "Chassis pose: {}", chassis.getPose());
+ * @endcode
+ *
+ * @param sink a lemlib::BaseSink or tiger::DeferredLog, or a shared pointer to one
+ * @param level the lemlib::Level of the message. Has to be a constant
+ * @param ... the format of the message, then its arguments
+ */
+#define TIGER_LOG(sink, level, ...)                                                                                    \
+    do {                                                                                                               \
+        if constexpr (::tiger::isCompiledIn(level)) ::tiger::detail::getSink(sink).log(level, __VA_ARGS__);            \
+    } while (false)
+
+#define TIGER_DEBUG(sink, ...) TIGER_LOG(sink, ::lemlib::Level::DEBUG, __VA_ARGS__)
+#define TIGER_INFO(sink, ...) TIGER_LOG(sink, ::lemlib::Level::INFO, __VA_ARGS__)
+#define TIGER_WARN(sink, ...) TIGER_LOG(sink, ::lemlib::Level::WARN, __VA_ARGS__)
+#define TIGER_ERROR(sink, ...) TIGER_LOG(sink, ::lemlib::Level::ERROR, __VA_ARGS__)
+#define TIGER_FATAL(sink, ...) TIGER_LOG(sink, ::lemlib::Level::FATAL, __VA_ARGS__)
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "lemlib/asset.hpp"
+#include "lemlib/pose.hpp"
+
+namespace tiger {
+/**
+ * @brief A point on a binary path
+ */
+struct PathPoint {
+        /** x position, in inches */
+        float x;
+        /** y position, in inches */
+        float y;
+        /** target speed at this point, out of 127. 0 marks the end of the path */
+        float velocity;
+        /** curvature of the path at this point, in 1/inches. Positive curves to the right */
+        float curvature;
+};
+
+/**
+ * @brief Header at the start of a binary path
+ *
+ * Everything is little endian, which is what the brain uses, so nothing has to be converted when reading.
+ */
+struct PathHeader {
+        /** always PATH_MAGIC */
+        uint32_t magic;
+        /** format version, PATH_VERSION */
+        uint16_t version;
+        /** size of each point in bytes, so points can grow without breaking older readers */
+        uint16_t pointSize;
+        /** number of points */
+        uint32_t count;
+        /** 32 bit FNV-1a hash of the point data */
+        uint32_t checksum;
+};
+
+/**
+ * @brief Optional data stored after each PathPoint
+ */
+struct PathPointExtra {
+        /** distance along the path from the first point to this one, in inches */
+        float arcLength;
+};
+
+/** "TPTH", read as a little endian integer */
+constexpr uint32_t PATH_MAGIC = 0x48545054;
+constexpr uint16_t PATH_VERSION = 1;
+
+/**
+ * @brief A read-only view of a binary path asset
+ *
+ * Binary paths are generated from jerryio paths by tools/path2bin.py and embedded with ASSET() like any other file
+ * in static/. Unlike the text format, nothing is parsed or copied: points are read straight out of the asset, so
+ * opening a path is constant time and uses no heap, however long it is.
+ *
+ * @b Example
+ * @code {.cpp}
+ * // static/skills.path, generated with "make paths"
+ * ASSET(skills_path);
+ *
+ * void initialize() {
+ *     // check the whole path once, instead of at the start of every motion
+ *     if (!tiger::PathView(skills_path).verify()) pros::lcd::print(0, "skills path is corrupt");
+ * }
+ * @endcode
+ */
+class PathView {
+    public:
+        /**
+         * @brief Open a binary path
+         *
+         * Only the header is checked, see verify() for the point data.
+         *
+         * @param path the asset. Must outlive the view
+         */
+        explicit PathView(const asset& path);
+        /**
+         * @brief Whether the asset is a binary path, with a header matching its size
+         *
+         * @return bool
+         */
+        bool isValid() const { return count != 0; }
+        /**
+         * @brief Check the point data against the checksum in the header
+         *
+         * Reads the whole path, so it is best done once in initialize()
+         *
+         * @return true if the path is valid and intact
+         */
+        bool verify() const;
+        /**
+         * @brief Get the number of points
+         *
+         * @return size_t 0 if the path is not valid
+         */
+        size_t size() const { return count; }
+        /**
+         * @brief Get a point
+         *
+         * @param index index of the point. Must be less than size()
+         * @return PathPoint
+         */
+        PathPoint operator[](size_t index) const;
+        /**
+         * @brief Get the position of a point, in the form used by LemLib
+         *
+         * @param index index of the point. Must be less than size()
+         * @return lemlib::Pose x and y of the point, and the velocity as theta, like lemlib::Chassis::follow uses
+         */
+        lemlib::Pose getPose(size_t index) const;
+        /**
+         * @brief Whether the path stores the arc length of each point
+         *
+         * Paths generated by path2bin.py always do, unless it was run with --no-arc-length
+         *
+         * @return bool
+         */
+        bool hasArcLength() const { return stride >= sizeof(PathPoint) + sizeof(PathPointExtra); }
+        /**
+         * @brief Get the distance along the path to a point
+         *
+         * @param index index of the point. Must be less than size(), and the path must have an arc length index
+         * @return float inches
+         */
+        float getArcLength(size_t index) const;
+        /**
+         * @brief Whether an asset is a binary path rather than a text path
+         *
+         * @param path the asset
+         * @return bool
+         */
+        static bool isBinary(const asset& path);
+    private:
+        const uint8_t* points = nullptr;
+        size_t count = 0;
+        size_t stride = 0;
+        uint32_t checksum = 0;
+};
+} // namespace tiger
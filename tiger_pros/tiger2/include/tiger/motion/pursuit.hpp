@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include "lemlib/pose.hpp"
+#include "tiger/motion/path.hpp"
+
+namespace tiger {
+/**
+ * @brief Find the index of the point on the path closest to the robot, by checking every point
+ *
+ * @param pose the robot's pose
+ * @param path the path
+ * @return size_t
+ */
+size_t findClosest(lemlib::Pose pose, const PathView& path);
+
+/**
+ * @brief Find where a circle intersects a line segment
+ *
+ * @param p1 start of the segment
+ * @param p2 end of the segment
+ * @param pose center of the circle
+ * @param lookaheadDist radius of the circle
+ * @return float how far along the segment the intersection is, from 0 to 1. -1 if there is none
+ */
+float circleIntersect(lemlib::Pose p1, lemlib::Pose p2, lemlib::Pose pose, float lookaheadDist);
+
+/**
+ * @brief Find the lookahead point, by checking every segment past the closest point
+ *
+ * @param lastLookahead the previous lookahead point, with the index of its segment as theta
+ * @param pose the robot's pose
+ * @param path the path
+ * @param closest index of the point closest to the robot
+ * @param lookaheadDist the lookahead distance
+ * @return lemlib::Pose the lookahead point, with the index of its segment as theta
+ */
+lemlib::Pose findLookahead(lemlib::Pose lastLookahead, lemlib::Pose pose, const PathView& path, size_t closest,
+                           float lookaheadDist);
+
+/**
+ * @brief Incremental closest point and lookahead search along a path
+ *
+ * findClosest() and findLookahead() scan the rest of the path every cycle, which adds up on long skills paths. The
+ * robot only ever moves forwards along the path, and only a short distance between cycles, so the cursor only
+ * searches a window that starts where it last found the robot and spans a fixed distance along the path. The
+ * window's length comes from the path's arc length index if it has one, otherwise segments are measured as they are
+ * scanned. Either way the cost per cycle depends on the lookahead distance and how dense the path is, not on its
+ * length.
+ *
+ * The first search after construction or reset() checks the whole path, so the robot doesn't have to start on the
+ * first point.
+ *
+ * @b Example
+ * @code {.cpp}
+ * tiger::PathCursor cursor(path, 15);
+ * while (true) {
+ *     const size_t closest = cursor.findClosest(pose);
+ *     const lemlib::Pose lookahead = cursor.findLookahead(pose);
+ *     // ...
+ * }
+ * @endcode
+ */
+class PathCursor {
+    public:
+        /**
+         * @brief Create a new cursor
+         *
+         * @param path the path to search. Must outlive the cursor
+         * @param lookahead the lookahead distance, in inches
+         */
+        PathCursor(const PathView& path, float lookahead);
+        /**
+         * @brief Start searching from the start of the path again
+         */
+        void reset();
+        /**
+         * @brief Find the index of the point closest to the robot
+         *
+         * Never returns an index before the one returned last time.
+         *
+         * @param pose the robot's pose
+         * @return size_t
+         */
+        size_t findClosest(lemlib::Pose pose);
+        /**
+         * @brief Find the lookahead point
+         *
+         * Must be called after findClosest() in the same cycle.
+         *
+         * @param pose the robot's pose
+         * @return lemlib::Pose the lookahead point, with the index of its segment as theta
+         */
+        lemlib::Pose findLookahead(lemlib::Pose pose);
+    private:
+        /**
+         * @brief Get the distance along the path from the closest point to another point
+         *
+         * @param index index of the other point, at or after the closest point
+         * @param previous the distance to the point before it, used when the path has no arc length index
+         * @return float inches
+         */
+        float getTravel(size_t index, float previous) const;
+
+        const PathView& path;
+        float lookahead;
+        /** how far past the closest point the closest point can be next cycle */
+        float closestWindow;
+        /** how far past the closest point the lookahead point can be */
+        float lookaheadWindow;
+        bool started = false;
+        size_t closest = 0;
+        lemlib::Pose lastLookahead = lemlib::Pose(0, 0, 0);
+};
+} // namespace tiger
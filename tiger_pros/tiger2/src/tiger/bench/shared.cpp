@@ -0,0 +1,81 @@
+#include <array>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "lemlib/pose.hpp"
+#include "tiger/bench/bench.hpp"
+#include "tiger/task/shared.hpp"
+
+// inputs are picked from a table of this size, so the compiler can't fold them into constants
+static constexpr uint32_t INPUTS = 64;
+
+namespace {
+/**
+ * @brief A snapshot of the sensors, too big for a SeqLockVar to be the obvious choice
+ */
+struct Snapshot {
+        std::array<float, 16> values;
+};
+} // namespace
+
+void tiger::benchSharedState(BenchClock clock, BenchSettings settings, FILE* out) {
+    std::vector<lemlib::Pose> poses;
+    for (uint32_t i = 0; i < INPUTS; i++) poses.emplace_back(i * 0.75f, 48 - i * 0.5f, i * 5.5f);
+    std::vector<Snapshot> snapshots(INPUTS);
+    for (uint32_t i = 0; i < INPUTS; i++) snapshots[i].values.fill(i * 1.5f);
+
+    printBenchHeader(out);
+
+    // every call takes and gives the mutex, even though nothing else wants it
+    pros::MutexVar<lemlib::Pose> mutexPose(0, 0, 0);
+    printBenchResult(out, "MutexVar<Pose> write",
+                     benchmark(clock, settings, [&](uint32_t i) { *mutexPose.lock() = poses[i % INPUTS]; }),
+                     settings.histograms);
+    printBenchResult(out, "MutexVar<Pose> read", benchmark(clock, settings, [&](uint32_t) {
+                         lemlib::Pose pose = *mutexPose.lock();
+                         doNotOptimize(pose);
+                     }),
+                     settings.histograms);
+
+    SeqLockVar<lemlib::Pose> seqLockPose(0, 0, 0);
+    printBenchResult(out, "SeqLockVar<Pose> store",
+                     benchmark(clock, settings, [&](uint32_t i) { seqLockPose.store(poses[i % INPUTS]); }),
+                     settings.histograms);
+    printBenchResult(out, "SeqLockVar<Pose> load", benchmark(clock, settings, [&](uint32_t) {
+                         lemlib::Pose pose = seqLockPose.load();
+                         doNotOptimize(pose);
+                     }),
+                     settings.histograms);
+
+    LatestVar<lemlib::Pose> latestPose(0, 0, 0);
+    printBenchResult(out, "LatestVar<Pose> store",
+                     benchmark(clock, settings, [&](uint32_t i) { latestPose.store(poses[i % INPUTS]); }),
+                     settings.histograms);
+    printBenchResult(out, "LatestVar<Pose> load", benchmark(clock, settings, [&](uint32_t) {
+                         lemlib::Pose pose = latestPose.load();
+                         doNotOptimize(pose);
+                     }),
+                     settings.histograms);
+
+    // a 64 byte snapshot, where copying starts to cost more than synchronizing
+    pros::MutexVar<Snapshot> mutexSnapshot;
+    printBenchResult(out, "MutexVar<Snapshot> read", benchmark(clock, settings, [&](uint32_t) {
+                         Snapshot snapshot = *mutexSnapshot.lock();
+                         doNotOptimize(snapshot);
+                     }),
+                     settings.histograms);
+    SeqLockVar<Snapshot> seqLockSnapshot;
+    printBenchResult(out, "SeqLockVar<Snapshot> load", benchmark(clock, settings, [&](uint32_t) {
+                         Snapshot snapshot = seqLockSnapshot.load();
+                         doNotOptimize(snapshot);
+                     }),
+                     settings.histograms);
+    LatestVar<Snapshot> latestSnapshot;
+    printBenchResult(out, "LatestVar<Snapshot> store",
+                     benchmark(clock, settings, [&](uint32_t i) { latestSnapshot.store(snapshots[i % INPUTS]); }),
+                     settings.histograms);
+    printBenchResult(out, "LatestVar<Snapshot> load", benchmark(clock, settings, [&](uint32_t) {
+                         Snapshot snapshot = latestSnapshot.load();
+                         doNotOptimize(snapshot);
+                     }),
+                     settings.histograms);
+}
@@ -0,0 +1,95 @@
+#include <cmath>
+#include "lemlib/util.hpp"
+#include "tiger/chassis/odom.hpp"
+
+tiger::OdomIntegrator::OdomIntegrator(OdomGeometry geometry)
+    : geometry(geometry) {}
+
+void tiger::OdomIntegrator::reset() { primed = false; }
+
+float tiger::OdomIntegrator::step(const OdomSample& sample) {
+    // the first sample only gives us something to take deltas from
+    if (!primed) {
+        prev = sample;
+        primed = true;
+        return 0;
+    }
+
+    // calculate the change in sensor values
+    const float deltaVertical1 = sample.vertical1 - prev.vertical1;
+    const float deltaVertical2 = sample.vertical2 - prev.vertical2;
+    const float deltaHorizontal1 = sample.horizontal1 - prev.horizontal1;
+    const float deltaHorizontal2 = sample.horizontal2 - prev.horizontal2;
+    const float deltaImu = sample.imu - prev.imu;
+    const float dt = (sample.time - prev.time) / 1000000.0f;
+    prev = sample;
+
+    // calculate the heading of the robot
+    // Priority:
+    // 1. Horizontal tracking wheels
+    // 2. Vertical tracking wheels
+    // 3. Inertial Sensor
+    // 4. Drivetrain
+    float heading = pose.theta;
+    if (geometry.hasHorizontal1 && geometry.hasHorizontal2)
+        heading -= (deltaHorizontal1 - deltaHorizontal2) / (geometry.horizontal1Offset - geometry.horizontal2Offset);
+    else if (!geometry.vertical1Powered && !geometry.vertical2Powered)
+        heading -= (deltaVertical1 - deltaVertical2) / (geometry.vertical1Offset - geometry.vertical2Offset);
+    else if (geometry.hasImu) heading += deltaImu;
+    else heading -= (deltaVertical1 - deltaVertical2) / (geometry.vertical1Offset - geometry.vertical2Offset);
+    const float deltaHeading = heading - pose.theta;
+    const float avgHeading = pose.theta + deltaHeading / 2;
+
+    // choose tracking wheels to use, prioritizing non-powered tracking wheels
+    float deltaY = deltaVertical1;
+    float verticalOffset = geometry.vertical1Offset;
+    if (geometry.vertical1Powered && !geometry.vertical2Powered) {
+        deltaY = deltaVertical2;
+        verticalOffset = geometry.vertical2Offset;
+    }
+    float deltaX = 0;
+    float horizontalOffset = 0;
+    if (geometry.hasHorizontal1) {
+        deltaX = deltaHorizontal1;
+        horizontalOffset = geometry.horizontal1Offset;
+    } else if (geometry.hasHorizontal2) {
+        deltaX = deltaHorizontal2;
+        horizontalOffset = geometry.horizontal2Offset;
+    }
+
+    // calculate local x and y
+    float localX = deltaX;
+    float localY = deltaY;
+    if (deltaHeading != 0) { // prevent divide by 0
+        localX = 2 * std::sin(deltaHeading / 2) * (deltaX / deltaHeading + horizontalOffset);
+        localY = 2 * std::sin(deltaHeading / 2) * (deltaY / deltaHeading + verticalOffset);
+    }
+
+    // calculate global x and y
+    const lemlib::Pose prevPose = pose;
+    pose.x += localY * std::sin(avgHeading);
+    pose.y += localY * std::cos(avgHeading);
+    pose.x += localX * -std::cos(avgHeading);
+    pose.y += localX * std::sin(avgHeading);
+    pose.theta = heading;
+
+    // calculate speed using the measured period. Two samples with the same timestamp carry no velocity information
+    if (dt > 0) {
+        speed.x = lemlib::ema((pose.x - prevPose.x) / dt, speed.x, 0.95);
+        speed.y = lemlib::ema((pose.y - prevPose.y) / dt, speed.y, 0.95);
+        speed.theta = lemlib::ema(deltaHeading / dt, speed.theta, 0.95);
+        localSpeed.x = lemlib::ema(localX / dt, localSpeed.x, 0.95);
+        localSpeed.y = lemlib::ema(localY / dt, localSpeed.y, 0.95);
+        localSpeed.theta = lemlib::ema(deltaHeading / dt, localSpeed.theta, 0.95);
+    }
+
+    return dt;
+}
+
+void tiger::OdomIntegrator::setPose(lemlib::Pose pose) { this->pose = pose; }
+
+lemlib::Pose tiger::OdomIntegrator::getPose() const { return pose; }
+
+lemlib::Pose tiger::OdomIntegrator::getSpeed() const { return speed; }
+
+lemlib::Pose tiger::OdomIntegrator::getLocalSpeed() const { return localSpeed; }
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include "tiger/chassis/poseHistory.hpp"
+
+// how many poses back the velocity used for extrapolation is measured over
+static constexpr uint32_t EXTRAPOLATION_SPAN = 5;
+// how many times a lookup is restarted if the writer laps it
+static constexpr int MAX_ATTEMPTS = 3;
+
+void tiger::PoseHistory::push(lemlib::Pose pose, uint32_t time) {
+    const uint32_t index = count.load(std::memory_order_relaxed);
+    Slot& slot = slots[index % SIZE];
+
+    // an odd sequence number tells readers the slot is being written
+    const uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.index.store(index, std::memory_order_relaxed);
+    slot.time.store(time, std::memory_order_relaxed);
+    slot.x.store(pose.x, std::memory_order_relaxed);
+    slot.y.store(pose.y, std::memory_order_relaxed);
+    slot.theta.store(pose.theta, std::memory_order_relaxed);
+    slot.seq.store(seq + 2, std::memory_order_release);
+
+    count.store(index + 1, std::memory_order_release);
+}
+
+void tiger::PoseHistory::clear() {
+    first.store(count.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+std::optional<tiger::PoseSample> tiger::PoseHistory::read(uint32_t index) const {
+    const Slot& slot = slots[index % SIZE];
+    const uint32_t seqBefore = slot.seq.load(std::memory_order_acquire);
+    if (seqBefore & 1) return std::nullopt;
+    const PoseSample sample {{slot.x.load(std::memory_order_relaxed), slot.y.load(std::memory_order_relaxed),
+                              slot.theta.load(std::memory_order_relaxed)},
+                             slot.time.load(std::memory_order_relaxed)};
+    const uint32_t slotIndex = slot.index.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != seqBefore || slotIndex != index) return std::nullopt;
+    return sample;
+}
+
+std::optional<tiger::PoseSample> tiger::PoseHistory::latest() const {
+    for (int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+        const uint32_t end = count.load(std::memory_order_acquire);
+        if (end == first.load(std::memory_order_acquire)) return std::nullopt;
+        const std::optional<PoseSample> sample = read(end - 1);
+        if (sample) return sample;
+    }
+    return std::nullopt;
+}
+
+std::optional<lemlib::Pose> tiger::PoseHistory::at(uint32_t time) const {
+    for (int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+        const uint32_t end = count.load(std::memory_order_acquire);
+        const uint32_t begin = std::max(first.load(std::memory_order_acquire), end > SIZE ? end - SIZE : 0);
+        if (end == begin) return std::nullopt;
+
+        std::optional<PoseSample> newer = read(end - 1);
+        if (!newer) continue;
+
+        // the requested time is after the latest pose, so extrapolate from the recent motion
+        if (static_cast<int32_t>(time - newer->time) >= 0) {
+            const uint32_t span = std::min(EXTRAPOLATION_SPAN, end - 1 - begin);
+            if (span == 0) return newer->pose;
+            const std::optional<PoseSample> older = read(end - 1 - span);
+            if (!older) continue;
+            const float dt = static_cast<int32_t>(newer->time - older->time);
+            if (dt <= 0) return newer->pose;
+            const float t = static_cast<int32_t>(time - newer->time) / dt;
+            return lemlib::Pose(newer->pose.x + (newer->pose.x - older->pose.x) * t,
+                                newer->pose.y + (newer->pose.y - older->pose.y) * t,
+                                newer->pose.theta + (newer->pose.theta - older->pose.theta) * t);
+        }
+
+        // walk back until we find the pose just before the requested time
+        bool lapped = false;
+        for (uint32_t i = end - 1; i-- > begin;) {
+            const std::optional<PoseSample> older = read(i);
+            if (!older) {
+                lapped = true;
+                break;
+            }
+            if (static_cast<int32_t>(time - older->time) >= 0) {
+                const float dt = static_cast<int32_t>(newer->time - older->time);
+                const float t = dt > 0 ? static_cast<int32_t>(time - older->time) / dt : 0;
+                return lemlib::Pose(older->pose.x + (newer->pose.x - older->pose.x) * t,
+                                    older->pose.y + (newer->pose.y - older->pose.y) * t,
+                                    older->pose.theta + (newer->pose.theta - older->pose.theta) * t);
+            }
+            newer = older;
+        }
+        if (lapped) continue;
+
+        // the requested time is older than anything we have
+        return newer->pose;
+    }
+    return std::nullopt;
+}
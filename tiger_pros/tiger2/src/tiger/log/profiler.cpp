@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cstdio>
+#include "pros/llemu.h"
+#include "pros/llemu.hpp"
+#include "tiger/log/profiler.hpp"
+
+// FreeRTOS's, which PROS doesn't declare. Weak, so a kernel without it still links and the stack reads as unknown
+extern "C" uint32_t uxTaskGetStackHighWaterMark(pros::task_t task) __attribute__((weak));
+
+// the brain screen has this many lines
+static constexpr int SCREEN_LINES = 8;
+// longest line of the trace
+static constexpr size_t TRACE_LINE = 192;
+
+tiger::TaskProfile::TaskProfile(Profiler* profiler, std::string name, uint32_t period, uint32_t id)
+    : profiler(profiler),
+      name(std::move(name)),
+      period(period * 1000),
+      id(id) {}
+
+void tiger::TaskProfile::begin() {
+    // PROS deletes the competition tasks when the robot is disabled and starts new ones later, so the loop can move to
+    // another task at any time
+    const pros::task_t current = pros::c::task_get_current();
+    if (task.load(std::memory_order_relaxed) != current) {
+        profiler->mutex.take();
+        std::snprintf(taskName, sizeof(taskName), "%s", pros::c::task_get_name(current));
+        task = current;
+        profiler->mutex.give();
+        // the last iteration ran on the old task, so the time since then isn't lateness
+        lastStart = 0;
+    }
+    start = pros::micros();
+    late = 0;
+    if (period != 0 && lastStart != 0 && start > lastStart + period) late = start - (lastStart + period);
+    lastStart = start;
+}
+
+void tiger::TaskProfile::end() {
+    const uint32_t run = pros::micros() - start;
+    // only this task writes the counters, the profiler only reads them and resets the maximums
+    iterations.fetch_add(1, std::memory_order_relaxed);
+    runTime.fetch_add(run, std::memory_order_relaxed);
+    if (run > maxRun.load(std::memory_order_relaxed)) maxRun.store(run, std::memory_order_relaxed);
+    if (late > maxLate.load(std::memory_order_relaxed)) maxLate.store(late, std::memory_order_relaxed);
+    if (period != 0 && (run > period || late >= period)) overruns.fetch_add(1, std::memory_order_relaxed);
+
+    OutputBuffer* output = profiler->trace.load(std::memory_order_acquire);
+    if (output == nullptr) return;
+    char line[TRACE_LINE];
+    const int length = std::snprintf(
+        line, sizeof(line),
+        "@trace {\"name\":\"%s\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%lu,\"pid\":1,\"tid\":%lu,\"args\":{\"late\":%lu}}\n",
+        name.c_str(), (unsigned long long)start, (unsigned long)run, (unsigned long)id, (unsigned long)late);
+    if (length > 0 && size_t(length) < sizeof(line)) output->push(std::string_view(line, length));
+}
+
+void tiger::TaskProfile::detach() {
+    profiler->mutex.take();
+    task = nullptr;
+    profiler->mutex.give();
+}
+
+tiger::TaskProfile& tiger::Profiler::addTask(const std::string& name, uint32_t period) {
+    mutex.take();
+    for (const std::unique_ptr<TaskProfile>& profile : profiles) {
+        if (profile->name == name) {
+            profile->task = nullptr;
+            mutex.give();
+            return *profile;
+        }
+    }
+    TaskProfile& profile = *profiles.emplace_back(new TaskProfile(this, name, period, profiles.size() + 1));
+    OutputBuffer* output = trace.load();
+    mutex.give();
+    if (output != nullptr) traceName(output, profile);
+    return profile;
+}
+
+std::vector<tiger::TaskStats> tiger::Profiler::getStats() {
+    std::vector<TaskStats> stats;
+    mutex.take();
+    const uint64_t now = pros::micros();
+    const float window = now - lastStats;
+    lastStats = now;
+    for (const std::unique_ptr<TaskProfile>& entry : profiles) {
+        TaskProfile& profile = *entry;
+        TaskStats task;
+        task.name = profile.name;
+        const uint32_t iterations = profile.iterations.load(std::memory_order_relaxed);
+        const uint32_t runTime = profile.runTime.load(std::memory_order_relaxed);
+        const uint32_t newIterations = iterations - profile.lastIterations;
+        const uint32_t newRunTime = runTime - profile.lastRunTime;
+        profile.lastIterations = iterations;
+        profile.lastRunTime = runTime;
+        if (window > 0) {
+            task.cpu = newRunTime / window;
+            task.rate = newIterations / window * 1000000;
+        }
+        if (newIterations != 0) task.averageRun = newRunTime / newIterations;
+        task.maxRun = profile.maxRun.exchange(0, std::memory_order_relaxed);
+        task.maxLate = profile.maxLate.exchange(0, std::memory_order_relaxed);
+        task.overruns = profile.overruns.load(std::memory_order_relaxed);
+        // a deleted task's handle points at freed memory, so only read the stack of a task the kernel can still find.
+        // The kernel measures it in words
+        const pros::task_t handle = profile.task.load();
+        if (uxTaskGetStackHighWaterMark != nullptr && handle != nullptr &&
+            pros::c::task_get_by_name(profile.taskName) == handle)
+            task.stackFree = uxTaskGetStackHighWaterMark(handle) * sizeof(uint32_t);
+        stats.push_back(task);
+    }
+    mutex.give();
+    return stats;
+}
+
+void tiger::Profiler::updateScreen(int firstLine) {
+    const std::vector<TaskStats> stats = getStats();
+    const size_t lines = std::min<size_t>(stats.size(), std::max(SCREEN_LINES - firstLine, 0));
+    for (size_t i = 0; i < lines; i++) {
+        const TaskStats& task = stats[i];
+        char line[96];
+        int length = std::snprintf(line, sizeof(line), "%-12.12s %5.1f%% %4.0f/s run %5.2f late %5.2f",
+                                   task.name.c_str(), task.cpu * 100, task.rate, task.maxRun / 1000.0f,
+                                   task.maxLate / 1000.0f);
+        if (task.stackFree >= 0 && length > 0 && size_t(length) < sizeof(line))
+            std::snprintf(line + length, sizeof(line) - length, " stack %ld", (long)task.stackFree);
+        pros::lcd::set_text(firstLine + i, line);
+    }
+}
+
+void tiger::Profiler::startScreenTask(int firstLine, uint32_t period) {
+    if (screenTask != nullptr) return;
+    screenTask = new pros::Task(
+        [this, firstLine, period] {
+            uint32_t now = pros::millis();
+            while (true) {
+                pros::Task::delay_until(&now, period);
+                updateScreen(firstLine);
+            }
+        },
+        TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "profiler screen");
+}
+
+void tiger::Profiler::setTraceOutput(std::shared_ptr<OutputBuffer> output) {
+    mutex.take();
+    trace = output.get();
+    if (output != nullptr) outputs.push_back(output);
+    // a row name for each task, then its events
+    if (output != nullptr) {
+        for (const std::unique_ptr<TaskProfile>& profile : profiles) traceName(output.get(), *profile);
+    }
+    mutex.give();
+}
+
+void tiger::Profiler::traceName(OutputBuffer* output, const TaskProfile& profile) {
+    char line[TRACE_LINE];
+    const int length = std::snprintf(
+        line, sizeof(line),
+        "@trace {\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"%s\"}}\n",
+        (unsigned long)profile.id, profile.name.c_str());
+    if (length > 0 && size_t(length) < sizeof(line)) output->push(std::string_view(line, length));
+}
+
+tiger::Profiler& tiger::profiler() {
+    static Profiler profiler;
+    return profiler;
+}
@@ -0,0 +1,39 @@
+#include "tiger/task/loop.hpp"
+
+tiger::PeriodicLoop::PeriodicLoop(uint32_t period, const std::string& name)
+    : period(period),
+      deadline(pros::millis()),
+      start(pros::micros()) {
+    if (!name.empty()) {
+        profile = &profiler().addTask(name, period);
+        profile->begin();
+    }
+}
+
+tiger::PeriodicLoop::~PeriodicLoop() {
+    if (profile != nullptr) profile->detach();
+}
+
+void tiger::PeriodicLoop::wait() {
+    const uint64_t body = pros::micros() - start;
+    if (profile != nullptr) profile->end();
+
+    // past the next deadline already, so start counting from now instead of running the next iteration right away
+    const bool overrun = pros::millis() - deadline >= period;
+    if (overrun) deadline = pros::millis();
+    pros::Task::delay_until(&deadline, period);
+
+    start = pros::micros();
+    const uint64_t due = uint64_t(deadline) * 1000;
+    if (resetRequested.exchange(false)) stats = LoopStats();
+    stats.iterations++;
+    if (overrun) stats.overruns++;
+    stats.body.add(body * 1000);
+    stats.jitter.add(start > due ? (start - due) * 1000 : 0);
+    published.store(stats);
+    if (profile != nullptr) profile->begin();
+}
+
+tiger::LoopStats tiger::PeriodicLoop::getStats() const { return published.load(); }
+
+void tiger::PeriodicLoop::resetStats() { resetRequested.store(true); }
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "tiger/chassis/chassis.hpp"
+#include "tiger/chassis/odom.hpp" // IWYU pragma: keep
+#include "tiger/chassis/fusion.hpp" // IWYU pragma: keep
+#include "tiger/chassis/poseHistory.hpp" // IWYU pragma: keep
+#include "tiger/motion/profile.hpp" // IWYU pragma: keep
+#include "tiger/motion/path.hpp" // IWYU pragma: keep
+#include "tiger/motion/pursuit.hpp" // IWYU pragma: keep
+#include "tiger/motion/queue.hpp" // IWYU pragma: keep
+#include "tiger/log/level.hpp" // IWYU pragma: keep
+#include "tiger/log/deferred.hpp" // IWYU pragma: keep
+#include "tiger/log/outputBuffer.hpp" // IWYU pragma: keep
+#include "tiger/log/bufferedSink.hpp" // IWYU pragma: keep
+#include "tiger/log/telemetry.hpp" // IWYU pragma: keep
+#include "tiger/log/recorder.hpp" // IWYU pragma: keep
+#include "tiger/log/profiler.hpp" // IWYU pragma: keep
+#include "tiger/task/loop.hpp" // IWYU pragma: keep
+#include "tiger/task/executor.hpp" // IWYU pragma: keep
+#include "tiger/task/action.hpp" // IWYU pragma: keep
+#include "tiger/task/shared.hpp" // IWYU pragma: keep
+#include "tiger/input/controller.hpp" // IWYU pragma: keep
+#include "tiger/bench/bench.hpp" // IWYU pragma: keep
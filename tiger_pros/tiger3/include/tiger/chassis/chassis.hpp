@@ -0,0 +1,615 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include "pros/rtos.hpp"
+#include "pros/gps.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "tiger/chassis/odom.hpp"
+#include "tiger/chassis/fusion.hpp"
+#include "tiger/chassis/poseHistory.hpp"
+#include "tiger/chassis/tuner.hpp"
+#include "tiger/motion/feedforward.hpp"
+#include "tiger/motion/profile.hpp"
+#include "tiger/motion/settle.hpp"
+#include "tiger/task/action.hpp"
+#include "tiger/task/shared.hpp"
+
+namespace tiger {
+class Executor;
+
+/**
+ * @brief Settings for the odometry task
+ */
+struct OdomSettings {
+        /** how often odometry is updated, in milliseconds */
+        uint32_t period = 10;
+        /** priority of the odometry task. Kept above the motion and logging tasks so they can't delay it */
+        uint32_t priority = TASK_PRIORITY_MAX - 2;
+        /** data rate requested from the inertial sensor, in milliseconds. 0 leaves the sensor default */
+        uint32_t imuDataRate = 5;
+        /** run odometry on this executor, at the priority above, instead of on a task of its own */
+        Executor* executor = nullptr;
+};
+
+/**
+ * @brief Timing statistics of the odometry task
+ */
+struct OdomStats {
+        /** number of completed odometry updates */
+        uint32_t cycles = 0;
+        /** number of updates that took longer than the period, or were started late */
+        uint32_t overruns = 0;
+        /** measured time between the last two samples, in microseconds */
+        uint32_t lastPeriod = 0;
+        /** longest measured time between two samples, in microseconds */
+        uint32_t maxPeriod = 0;
+        /** time spent integrating the last sample, in microseconds */
+        uint32_t updateTime = 0;
+        /** longest time spent integrating a sample, in microseconds */
+        uint32_t maxUpdateTime = 0;
+};
+
+/**
+ * @brief Settings for motion profiled movements
+ *
+ * The velocity limit comes from the drivetrain's rpm and wheel diameter, the rest is derived from it unless set.
+ */
+struct ProfileSettings {
+        /** fraction of the drivetrain's theoretical top speed the profile may plan for */
+        float velocityScale = 0.85;
+        /** maximum acceleration, in inches per second squared. 0 means top speed is reached in 0.3 seconds */
+        float maxAcceleration = 0;
+        /** maximum jerk, in inches per second cubed. 0 means peak acceleration is reached in 0.1 seconds */
+        float maxJerk = 0;
+        /** use a trapezoidal profile, ignoring jerk */
+        bool trapezoidal = false;
+};
+
+/**
+ * @brief Settings for drivetrain characterization
+ *
+ * Each test stops at whichever limit comes first, the time or the distance.
+ */
+struct CharacterizeSettings {
+        /** characterize turning in place instead of driving straight */
+        bool angular = false;
+        /** how fast the quasistatic test raises the voltage, in volts per second */
+        float rampRate = 1;
+        /** voltage of the step test */
+        float stepVoltage = 7;
+        /** longest time each test can run, in milliseconds */
+        uint32_t timeout = 4000;
+        /** how far each straight test can drive, in inches */
+        float maxDistance = 48;
+        /** how far each turning test can turn, in degrees */
+        float maxAngle = 720;
+        /** CSV file to write every sample to, like "/usd/characterize.csv". nullptr to not write one */
+        const char* log = nullptr;
+};
+
+/**
+ * @brief LemLib chassis with our own odometry task
+ *
+ * Drop-in replacement for lemlib::Chassis. Motions are still LemLib's, but calibrate() starts a fixed-rate odometry
+ * task scheduled with pros::Task::delay_until instead of LemLib's internal one. Every update integrates with the
+ * measured time since the previous sample, so a cycle delayed by the screen or the logger no longer skews the speed
+ * estimate, and late cycles are counted instead of silently stretching the period.
+ *
+ * Optionally, the pose can come from an extended Kalman filter (see setFusion()) that also uses the drivetrain
+ * encoders, the IMU's accelerometer and gyro, and a GPS sensor.
+ *
+ * Once setProfile() is called, moveToPoint and moveToPose plan a jerk limited motion profile and track it, instead of
+ * letting the PID start at full power. setFeedforward() adds a feedforward model to that tracking, which
+ * characterize() measures. tune() finds PID gains for the lateral and angular controllers. setSettle() ends motions
+ * as soon as the robot has stopped at the target, and aborts them when it's blocked.
+ *
+ * Every update is also recorded in a PoseHistory. getPose() reads the latest entry without taking a mutex, and past
+ * or future poses can be looked up by time.
+ */
+class Chassis : public lemlib::Chassis {
+    public:
+        using lemlib::Chassis::Chassis;
+        /**
+         * @brief Calibrate the chassis sensors and start the odometry task
+         *
+         * @param calibrateIMU whether the IMU should be calibrated. true by default
+         * @param settings settings of the odometry task
+         *
+         * @b Example
+         * @code {.cpp}
+         * void initialize() {
+         *     // run odometry every 5ms instead of the default 10ms
+         *     chassis.calibrate(true, {.period = 5});
+         * }
+         * @endcode
+         */
+        void calibrate(bool calibrateIMU = true, OdomSettings settings = {});
+        /**
+         * @brief Fuse all available sensors with an extended Kalman filter instead of trusting the tracking wheels
+         *
+         * Besides the odometry sensors, this uses the drivetrain encoders, the IMU accelerometer and gyro rate, and
+         * optionally a GPS sensor, weighted by the error it reports. Mostly useful for robots without a horizontal
+         * tracking wheel, where sideways pushes are otherwise invisible to odometry.
+         *
+         * @note must be called before calibrate()
+         *
+         * @param settings noise and IMU mounting parameters
+         * @param gps optional GPS sensor. Its position must already be offset to the tracking center
+         *
+         * @b Example
+         * @code {.cpp}
+         * pros::Gps gps(5);
+         *
+         * void initialize() {
+         *     chassis.setFusion({}, &gps);
+         *     chassis.calibrate();
+         * }
+         * @endcode
+         */
+        void setFusion(FusionSettings settings = {}, pros::Gps* gps = nullptr);
+        /**
+         * @brief Set the pose of the chassis
+         *
+         * @param x new x value
+         * @param y new y value
+         * @param theta new theta value
+         * @param radians true if theta is in radians, false if not. False by default
+         */
+        void setPose(float x, float y, float theta, bool radians = false);
+        /**
+         * @brief Set the pose of the chassis
+         *
+         * @param pose the new pose
+         * @param radians true if theta is in radians, false if in degrees. False by default
+         */
+        void setPose(lemlib::Pose pose, bool radians = false);
+        /**
+         * @brief Get the pose of the chassis
+         *
+         * Reads the latest odometry update without locking, so all three fields always come from the same update.
+         *
+         * @param radians whether theta should be in radians (true) or degrees (false). false by default
+         * @param standardPos whether theta should be in standard position (0 is +x, counter-clockwise positive)
+         * @return lemlib::Pose
+         *
+         * @b Example
+         * @code {.cpp}
+         * // read the pose once instead of once per field
+         * const lemlib::Pose pose = chassis.getPose();
+         * pros::lcd::print(0, "X: %f Y: %f", pose.x, pose.y);
+         * @endcode
+         */
+        lemlib::Pose getPose(bool radians = false, bool standardPos = false);
+        /**
+         * @brief Get the pose of the chassis at a given time
+         *
+         * Interpolates between the odometry updates around that time. Useful to line up a measurement that was taken
+         * a while ago, like a vision target, with where the robot was when it was taken. Times older than the
+         * history return the oldest pose, and times in the future are extrapolated.
+         *
+         * @param time the time, in milliseconds since the program started (see pros::millis())
+         * @param radians whether theta should be in radians (true) or degrees (false). false by default
+         * @param standardPos whether theta should be in standard position (0 is +x, counter-clockwise positive)
+         * @return lemlib::Pose
+         *
+         * @b Example
+         * @code {.cpp}
+         * // where was the robot 100ms ago?
+         * const lemlib::Pose pose = chassis.getPoseAt(pros::millis() - 100);
+         * @endcode
+         */
+        lemlib::Pose getPoseAt(uint32_t time, bool radians = false, bool standardPos = false);
+        /**
+         * @brief Estimate the pose of the robot after a certain amount of time
+         *
+         * Extrapolated from the recorded history rather than from a single smoothed velocity.
+         *
+         * @param time time in seconds
+         * @param radians False for degrees, true for radians. False by default
+         * @return lemlib::Pose
+         */
+        lemlib::Pose estimatePose(float time, bool radians = false);
+        /**
+         * @brief Use motion profiles for moveToPoint and moveToPose
+         *
+         * @param settings the profile limits
+         *
+         * @b Example
+         * @code {.cpp}
+         * void initialize() {
+         *     chassis.calibrate();
+         *     // profile with the default limits derived from the drivetrain
+         *     chassis.setProfile({});
+         * }
+         * @endcode
+         */
+        void setProfile(ProfileSettings settings);
+        /**
+         * @brief Drive profiled motions with a feedforward model
+         *
+         * Without one, profiled motions scale the profile's velocity by the drivetrain's theoretical top speed. With
+         * one, they apply the voltage the model says the profile needs, including what it takes to get moving and to
+         * accelerate, so the PID only corrects the model's error. The angular feedforward turns the robot along
+         * moveToPose's curve. Measure both with characterize().
+         *
+         * @note only affects motions that follow a profile, so call setProfile() too
+         *
+         * @param lateral feedforward of driving straight, in inches per second
+         * @param angular feedforward of turning, in degrees per second
+         *
+         * @b Example
+         * @code {.cpp}
+         * void initialize() {
+         *     chassis.calibrate();
+         *     chassis.setProfile({});
+         *     // from chassis.characterize()
+         *     chassis.setFeedforward({0.9, 0.18, 0.03}, {0.8, 0.025, 0.004});
+         * }
+         * @endcode
+         */
+        void setFeedforward(Feedforward lateral, Feedforward angular = {});
+        /**
+         * @brief End motions once the robot has stopped at the target, and abort them when it's blocked
+         *
+         * Without this, motions only end through the controllers' exit conditions, or when they time out. With it,
+         * moveToPoint, moveToPose and turnToHeading also end once a SettleDetector sees the robot stopped within
+         * tolerance, using the odometry's measured speed. Those motions and follow are aborted with a warning when
+         * the robot is blocked, like when it's pinned against a wall or another robot. getSettleState() tells which
+         * happened.
+         *
+         * @note moveToPoint and moveToPose only settle this way when following a profile, so call setProfile() too
+         *
+         * @param lateral thresholds for driving, in inches
+         * @param angular thresholds for turning, in degrees
+         *
+         * @b Example
+         * @code {.cpp}
+         * void autonomous() {
+         *     chassis.setSettle({.tolerance = 0.5}, {.tolerance = 1, .velocity = 5});
+         *     chassis.moveToPoint(0, 24, 3000);
+         *     chassis.waitUntilDone();
+         *     if (chassis.getSettleState() == tiger::SettleState::STALLED) chassis.moveToPoint(0, 12, 1000);
+         * }
+         * @endcode
+         */
+        void setSettle(SettleSettings lateral = {}, SettleSettings angular = {.velocity = 5});
+        /**
+         * @brief Get how the last motion ended
+         *
+         * @return SettleState SETTLED if it stopped at the target, STALLED if it was aborted because the robot was
+         * blocked, and MOVING otherwise, like when it timed out, was cancelled, exited early for motion chaining,
+         * or reached the end of a path
+         */
+        SettleState getSettleState() const { return settleState; }
+        /**
+         * @brief Measure the drivetrain's feedforward
+         *
+         * Runs four tests: a quasistatic test that slowly raises the voltage, then a step test that applies a fixed
+         * voltage at once, each forwards and then backwards so the robot ends up near where it started. Every 10ms
+         * the motors' voltages and velocities are sampled, and kS, kV and kA are fitted to them with least squares.
+         * The result and how well it fits are logged to the info sink.
+         *
+         * Blocks until the tests are done, which takes about 20 seconds. The robot needs room to drive maxDistance
+         * in both directions, and a charged battery.
+         *
+         * @param settings which tests to run, and how far
+         * @return Feedforward the fitted model. All 0 if the robot didn't move
+         *
+         * @b Example
+         * @code {.cpp}
+         * void autonomous() {
+         *     tiger::Feedforward lateral = chassis.characterize({.log = "/usd/lateral.csv"});
+         *     tiger::Feedforward angular = chassis.characterize({.angular = true});
+         *     chassis.setFeedforward(lateral, angular);
+         * }
+         * @endcode
+         */
+        Feedforward characterize(CharacterizeSettings settings = {});
+        /**
+         * @brief Replace the lateral controller's settings
+         *
+         * @note don't call this while a motion is running
+         */
+        void setLateralSettings(const lemlib::ControllerSettings& settings);
+        /**
+         * @brief Replace the angular controller's settings
+         *
+         * @note don't call this while a motion is running
+         */
+        void setAngularSettings(const lemlib::ControllerSettings& settings);
+        /**
+         * @brief Get the lateral controller's settings
+         */
+        const lemlib::ControllerSettings& getLateralSettings() const { return lateralSettings; }
+        /**
+         * @brief Get the angular controller's settings
+         */
+        const lemlib::ControllerSettings& getAngularSettings() const { return angularSettings; }
+        /**
+         * @brief Tune the gains of the lateral or angular controller
+         *
+         * First a relay test oscillates the robot around where it is, which gives starting gains. Then a pattern
+         * search scales kP and kD up and down, keeping whatever settles fastest without overshooting, until the
+         * steps get small or it has tried settings.candidates gains. Each candidate is scored on a step trial there
+         * and back, with moveToPoint or turnToHeading, so the robot stays where it started. The tuned gains are
+         * applied, logged to the info sink, and returned.
+         *
+         * Blocks until done, which takes about a minute. The robot needs room to drive settings.step both ways.
+         * To sweep many more candidates at once, use the host simulator's tune program ("make tune" in
+         * tiger_pros/host) instead.
+         *
+         * @param settings which controller to tune, and how
+         * @return lemlib::ControllerSettings the tuned settings
+         *
+         * @b Example
+         * @code {.cpp}
+         * void autonomous() {
+         *     chassis.tune({.angular = true});
+         *     chassis.tune({.step = 24});
+         * }
+         * @endcode
+         */
+        lemlib::ControllerSettings tune(TuneSettings settings = {});
+        /**
+         * @brief Run a relay feedback test around the robot's current position or heading
+         *
+         * @param settings which controller, and the power and number of cycles of the relay
+         * @return RelayResult invalid if the robot didn't oscillate in time
+         */
+        RelayResult runRelayTest(TuneSettings settings);
+        /**
+         * @brief Run one step trial with the current gains
+         *
+         * @param settings which controller, and the size and length of the step
+         * @param direction 1 to step forwards or clockwise, -1 to step backwards or counterclockwise
+         * @return TuneTrial
+         */
+        TuneTrial runTuneTrial(TuneSettings settings, float direction);
+        /**
+         * @brief Move the chassis towards the target point
+         *
+         * Same as lemlib::Chassis::moveToPoint. If a profile is set, the motion follows a precomputed profile along the
+         * line to the point, with the lateral PID correcting the difference between the profile and the robot.
+         *
+         * @param x x location
+         * @param y y location
+         * @param timeout longest time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param async whether the function should be run asynchronously. true by default
+         */
+        void moveToPoint(float x, float y, int timeout, lemlib::MoveToPointParams params = {}, bool async = true);
+        /**
+         * @brief Move the chassis towards the target pose
+         *
+         * Same as lemlib::Chassis::moveToPose. If a profile is set, the lateral speed follows a profile planned along
+         * the initial boomerang curve until the robot starts settling.
+         *
+         * @param x x location
+         * @param y y location
+         * @param theta target heading in degrees.
+         * @param timeout longest time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param async whether the function should be run asynchronously. true by default
+         */
+        void moveToPose(float x, float y, float theta, int timeout, lemlib::MoveToPoseParams params = {},
+                        bool async = true);
+        /**
+         * @brief Turn the chassis so it is facing the target heading
+         *
+         * Same as lemlib::Chassis::turnToHeading. If setSettle() was called, the turn also ends once the robot has
+         * stopped at the heading, and is aborted when the robot is blocked.
+         *
+         * @param theta heading location
+         * @param timeout longest time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param async whether the function should be run asynchronously. true by default
+         */
+        void turnToHeading(float theta, int timeout, lemlib::TurnToHeadingParams params = {}, bool async = true);
+        /**
+         * @brief Turn the chassis so it is facing the target heading, but only by moving one half of the drivetrain
+         *
+         * Same as lemlib::Chassis::swingToHeading. If setSettle() was called, the swing also ends once the robot has
+         * stopped at the heading, and is aborted when the robot is blocked.
+         *
+         * @param theta heading location
+         * @param lockedSide side of the drivetrain that is locked
+         * @param timeout longest time the robot can spend moving
+         * @param params struct to simulate named parameters
+         * @param async whether the function should be run asynchronously. true by default
+         */
+        void swingToHeading(float theta, lemlib::DriveSide lockedSide, int timeout,
+                            lemlib::SwingToHeadingParams params = {}, bool async = true);
+        /**
+         * @brief Move the chassis along a path
+         *
+         * Same as lemlib::Chassis::follow, but also accepts binary paths generated by tools/path2bin.py. Those are
+         * read in place, so there is no parsing and no allocation when the motion starts, and the robot slows down
+         * ahead of corners that are too tight for the drivetrain's horizontalDrift. Text paths are passed to LemLib.
+         *
+         * @param path the path asset to follow
+         * @param lookahead the lookahead distance. Units in inches. Larger values will make the robot move
+         * faster but will follow the path less accurately
+         * @param timeout the maximum time the robot can spend moving
+         * @param forwards whether the robot should follow the path going forwards. true by default
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // static/skills.path, generated with "make paths"
+         * ASSET(skills_path);
+         *
+         * void autonomous() {
+         *     chassis.follow(skills_path, 15, 10000);
+         * }
+         * @endcode
+         */
+        void follow(const asset& path, float lookahead, int timeout, bool forwards = true, bool async = true);
+        /**
+         * @brief Get the speed of the robot, measured by the odometry task
+         *
+         * @param radians true for theta in radians, false for degrees. False by default
+         * @return lemlib::Pose inches per second
+         */
+        lemlib::Pose getSpeed(bool radians = false);
+        /**
+         * @brief Get the speed of the robot relative to its own heading, measured by the odometry task
+         *
+         * @param radians true for theta in radians, false for degrees. False by default
+         * @return lemlib::Pose inches per second
+         */
+        lemlib::Pose getLocalSpeed(bool radians = false);
+        /**
+         * @brief Get the timing statistics of the odometry task
+         *
+         * @return OdomStats
+         *
+         * @b Example
+         * @code {.cpp}
+         * pros::lcd::print(3, "odom overruns: %lu", chassis.getOdomStats().overruns);
+         * @endcode
+         */
+        OdomStats getOdomStats();
+        /**
+         * @brief Stop the running motion. Same as lemlib::Chassis::cancelMotion, but also stops tune() between its
+         * trials, when no motion is running
+         */
+        void cancelMotion();
+        /**
+         * @brief Stop the running motion and any queued after it. Same as lemlib::Chassis::cancelAllMotions, but also
+         * stops tune() between its trials
+         */
+        void cancelAllMotions();
+        /**
+         * @brief Wait in an Action until the running motion, and any queued after it, are done
+         *
+         * The Action equivalent of waitUntilDone(), for routines run by an ActionRunner. Start motions with async
+         * set, and wait for one before starting the next, since starting a motion while another runs blocks until
+         * the first is done.
+         *
+         * @b Example
+         * @code {.cpp}
+         * tiger::Action route() {
+         *     chassis.moveToPoint(0, 24, 2000);
+         *     co_await chassis.untilDone();
+         * }
+         * @endcode
+         */
+        Action untilDone();
+        /**
+         * @brief Wait in an Action until the running motion has traveled a distance, or is done
+         *
+         * The Action equivalent of waitUntil()
+         *
+         * @param distance inches for moves and paths, degrees for turns and swings
+         *
+         * @b Example
+         * @code {.cpp}
+         * tiger::Action route() {
+         *     chassis.moveToPoint(0, 48, 3000);
+         *     // raise the arm on the way, without stopping
+         *     co_await chassis.untilTraveled(30);
+         *     arm.move(127);
+         *     co_await chassis.untilDone();
+         * }
+         * @endcode
+         */
+        Action untilTraveled(float distance);
+    protected:
+        /**
+         * @brief Convert a pose from the internal representation to the one requested by the caller
+         *
+         * @param pose pose with theta in radians
+         * @param radians whether theta should be in radians
+         * @param standardPos whether theta should be in standard position
+         * @return lemlib::Pose
+         */
+        static lemlib::Pose convertPose(lemlib::Pose pose, bool radians, bool standardPos);
+        /**
+         * @brief Get the theoretical top speed of the drivetrain
+         *
+         * @return float inches per second
+         */
+        float getTopSpeed() const;
+        /**
+         * @brief Get the profile limits for a motion
+         *
+         * @param maxSpeed the max speed of the motion, out of 127
+         * @return ProfileConstraints
+         */
+        ProfileConstraints getProfileConstraints(float maxSpeed) const;
+        /**
+         * @brief Get the power the lateral feedforward needs to follow a profile
+         *
+         * @param reference where the profile is, in inches
+         * @return float power out of 127
+         */
+        float getLateralFeedforward(const ProfileState& reference) const;
+        /**
+         * @brief Run one characterization test
+         *
+         * @param settings the characterization settings
+         * @param step whether to run the step test instead of the quasistatic test
+         * @param direction 1 for forwards or clockwise, -1 for backwards or counterclockwise
+         * @param fit the fit to add the samples to
+         * @param log where to write the samples to, or nullptr
+         */
+        void runCharacterizationTest(const CharacterizeSettings& settings, bool step, float direction,
+                                     FeedforwardFit& fit, FILE* log);
+        /**
+         * @brief Read all odometry sensors into a sample
+         *
+         * @return OdomSample
+         */
+        OdomSample readSensors();
+        /**
+         * @brief Read the extra sensors used by the fusion filter
+         *
+         * @param sample the odometry sample read in the same cycle, so no sensor is read twice
+         * @return FusionSample
+         */
+        FusionSample readFusionSensors(const OdomSample& sample);
+        /**
+         * @brief Read the sensors and integrate them, once
+         */
+        void updateOdom();
+        /**
+         * @brief The loop run by the odometry task
+         */
+        void odomLoop();
+
+        OdomSettings odomSettings;
+        OdomIntegrator odom;
+        pros::Task* odomTask = nullptr;
+        /** whether odometry was added to an executor, which can't take it back */
+        bool odomScheduled = false;
+        pros::Mutex odomMutex;
+        OdomStats odomStats;
+        /** copies of the odometry task's results, for readers that shouldn't wait for it */
+        SeqLockVar<OdomStats> publishedStats;
+        SeqLockVar<lemlib::Pose> odomSpeed {0, 0, 0};
+        SeqLockVar<lemlib::Pose> odomLocalSpeed {0, 0, 0};
+        PoseHistory poseHistory;
+
+        bool profileEnabled = false;
+        ProfileSettings profileSettings;
+        Feedforward lateralFeedforward;
+        Feedforward angularFeedforward;
+
+        bool settleEnabled = false;
+        SettleDetector lateralSettle;
+        SettleDetector angularSettle;
+        SettleState settleState = SettleState::MOVING;
+
+        /** calls to cancelMotion() and cancelAllMotions(), so tune() can tell it was cancelled between motions */
+        std::atomic<uint32_t> cancels = 0;
+
+        bool fusionEnabled = false;
+        FusionSettings fusionSettings;
+        OdomFusion fusion;
+        pros::Gps* gps = nullptr;
+        lemlib::TrackingWheel* leftDrive = nullptr;
+        lemlib::TrackingWheel* rightDrive = nullptr;
+};
+} // namespace tiger
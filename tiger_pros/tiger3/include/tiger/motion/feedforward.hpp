@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+
+namespace tiger {
+/**
+ * @brief Drivetrain feedforward: the voltage it takes to move at a velocity and acceleration
+ *
+ * Models a DC motor drivetrain as voltage = kS * sign(velocity) + kV * velocity + kA * acceleration. kS overcomes
+ * static friction, kV the motor's back EMF, and kA the robot's inertia. With these, a motion can apply the voltage
+ * its profile needs up front, and the PID only has to correct what the model gets wrong.
+ *
+ * For the lateral controller, velocities are in inches per second. For the angular controller, they are in degrees
+ * per second of the robot turning, and the voltage is what each side gets, positive on the left.
+ *
+ * @b Example
+ * @code {.cpp}
+ * // 0.9V to start moving, 0.18V per in/s and 0.03V per in/s^2
+ * tiger::Feedforward lateral {0.9, 0.18, 0.03};
+ * // power out of 127 to hold 40 in/s
+ * float power = lateral.getPower(40, 0);
+ * @endcode
+ */
+struct Feedforward {
+        /** volts to overcome static friction */
+        float kS = 0;
+        /** volts per unit per second */
+        float kV = 0;
+        /** volts per unit per second squared */
+        float kA = 0;
+
+        /**
+         * @brief Get the voltage needed for a velocity and acceleration
+         *
+         * kS pushes in the direction of the velocity, or of the acceleration when starting from a stop.
+         *
+         * @return float volts
+         */
+        float getVoltage(float velocity, float acceleration) const;
+        /**
+         * @brief Get the power needed for a velocity and acceleration
+         *
+         * @return float power out of 127, like the values passed to pros::Motor::move()
+         */
+        float getPower(float velocity, float acceleration) const;
+        /**
+         * @brief Whether the feedforward has been set
+         */
+        bool isSet() const { return kV != 0; }
+};
+
+/**
+ * @brief Fits a Feedforward to measured voltages, velocities and accelerations
+ *
+ * Ordinary least squares over every sample added. Only sums are kept, so a fit takes constant memory however long the
+ * characterization runs.
+ *
+ * @b Example
+ * @code {.cpp}
+ * tiger::FeedforwardFit fit;
+ * fit.add(volts, velocity, acceleration); // for every sample
+ * tiger::Feedforward feedforward = fit.solve();
+ * @endcode
+ */
+class FeedforwardFit {
+    public:
+        /**
+         * @brief Add a sample
+         *
+         * @param voltage applied volts
+         * @param velocity measured velocity
+         * @param acceleration measured acceleration
+         */
+        void add(float voltage, float velocity, float acceleration);
+        /**
+         * @brief Solve for the feedforward that best explains the samples
+         *
+         * @return Feedforward all 0 if the samples can't tell the terms apart, like when the robot never accelerated
+         */
+        Feedforward solve() const;
+        /**
+         * @brief Get how much of the variation in voltage the fit explains
+         *
+         * @return float from 0 to 1. Above 0.95 is a good fit, lower usually means wheel slip or a dying battery
+         */
+        float getRSquared() const;
+        /**
+         * @brief Get the number of samples added
+         */
+        uint32_t getCount() const { return count; }
+    private:
+        /** sums of the products of the regressors: sign(velocity), velocity and acceleration */
+        double xx[3][3] = {};
+        /** sums of each regressor times the voltage */
+        double xy[3] = {};
+        double yy = 0;
+        double y = 0;
+        uint32_t count = 0;
+};
+} // namespace tiger
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+
+namespace tiger {
+/**
+ * @brief Settings for detecting when a motion is done, or stuck
+ *
+ * Units are inches for the lateral controller and degrees for the angular one.
+ */
+struct SettleSettings {
+        /** how close to the target the robot has to be to count as there */
+        float tolerance = 1;
+        /** below this speed, in units per second, the robot counts as stopped */
+        float velocity = 2;
+        /** how long the robot has to stay stopped at the target, in milliseconds */
+        uint32_t settleTime = 50;
+        /** power out of 127 at which a robot that isn't moving counts as blocked. 0 to never abort */
+        float stallPower = 30;
+        /** how long the robot has to stay blocked before the motion is aborted, in milliseconds */
+        uint32_t stallTime = 300;
+};
+
+/**
+ * @brief What a SettleDetector has seen
+ */
+enum class SettleState {
+    /** still moving, or not at the target yet */
+    MOVING,
+    /** stopped at the target */
+    SETTLED,
+    /** pushing but not moving, away from the target */
+    STALLED
+};
+
+/**
+ * @brief Decides when a motion is done by whether the robot has stopped, instead of waiting out a timer
+ *
+ * lemlib::ExitCondition only knows the error, so it has to wait long enough to be sure the robot won't drift back
+ * out of range. This also checks the measured speed and how fast the error is changing: once the robot is within
+ * tolerance and both are below the velocity threshold for settleTime, it's not going anywhere. Checking both
+ * catches a robot that reads as stopped while its target still moves, like moveToPose's carrot point.
+ *
+ * It also detects a robot that's blocked: the controller is asking for at least stallPower, but the robot has been
+ * stopped short of the target for stallTime.
+ *
+ * @b Example
+ * @code {.cpp}
+ * tiger::SettleDetector settle({.tolerance = 1, .velocity = 5});
+ * while (settle.update(error, chassis.getSpeed().theta, power) == tiger::SettleState::MOVING) {
+ *     // ...
+ *     pros::delay(10);
+ * }
+ * @endcode
+ */
+class SettleDetector {
+    public:
+        /**
+         * @brief Construct a new Settle Detector
+         *
+         * @param settings the thresholds
+         */
+        explicit SettleDetector(SettleSettings settings = {});
+        /**
+         * @brief Update the detector with a new sample
+         *
+         * Returns SETTLED for as long as the robot stays stopped at the target, and STALLED from the moment it's
+         * blocked until reset.
+         *
+         * @param error distance to the target. INFINITY if the motion has no target to settle at, which only
+         * detects stalls
+         * @param velocity measured speed of the robot along the error, in units per second
+         * @param power what the controller is asking the motors for, out of 127
+         * @return SettleState
+         */
+        SettleState update(float error, float velocity, float power);
+        /**
+         * @brief Get the state from the last update
+         */
+        SettleState getState() const { return state; }
+        /**
+         * @brief Start over for a new motion
+         */
+        void reset();
+    private:
+        SettleSettings settings;
+        SettleState state = SettleState::MOVING;
+        float prevError = 0;
+        uint32_t prevTime = 0;
+        bool first = true;
+        /** when the robot stopped at the target or got blocked, or -1 if it isn't */
+        int64_t settledSince = -1;
+        int64_t stalledSince = -1;
+};
+} // namespace tiger
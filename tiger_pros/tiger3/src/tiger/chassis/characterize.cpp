@@ -0,0 +1,156 @@
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include "lemlib/logger/logger.hpp"
+#include "tiger/log/level.hpp"
+#include "lemlib/util.hpp"
+#include "tiger/chassis/chassis.hpp"
+
+// time between samples, in milliseconds
+static constexpr uint32_t SAMPLE_PERIOD = 10;
+// how long the robot gets to stop between tests, in milliseconds
+static constexpr uint32_t REST_TIME = 1000;
+// samples slower than this fraction of the top speed are left out of the fit. Until the robot breaks free of static
+// friction, the voltage says nothing about kV or kA
+static constexpr float STILL = 0.02;
+
+namespace {
+/**
+ * @brief A sample of a characterization test
+ */
+struct CharacterizationSample {
+        /** seconds since the test started */
+        float time;
+        float voltage;
+        float velocity;
+};
+} // namespace
+
+/**
+ * @brief Get the speed of a drivetrain side, measured by its motors
+ *
+ * @param motors the motors of the side
+ * @param wheelDiameter inches
+ * @param rpm rpm of the wheels at the cartridge's free speed
+ * @return float inches per second
+ */
+static float getSideSpeed(pros::MotorGroup* motors, float wheelDiameter, float rpm) {
+    const std::vector<pros::MotorGears> gearsets = motors->get_gearing_all();
+    const std::vector<double> velocities = motors->get_actual_velocity_all();
+    std::vector<float> speeds;
+    for (size_t i = 0; i < velocities.size() && i < gearsets.size(); i++) {
+        float cartridge;
+        switch (gearsets[i]) {
+            case pros::MotorGears::red: cartridge = 100; break;
+            case pros::MotorGears::blue: cartridge = 600; break;
+            default: cartridge = 200; break;
+        }
+        speeds.push_back(velocities[i] * rpm / cartridge / 60 * M_PI * wheelDiameter);
+    }
+    return lemlib::avg(speeds);
+}
+
+/**
+ * @brief Get the voltage applied to a drivetrain side
+ *
+ * @return float volts
+ */
+static float getSideVoltage(pros::MotorGroup* motors) {
+    const std::vector<std::int32_t> voltages = motors->get_voltage_all();
+    std::vector<float> volts;
+    for (std::int32_t voltage : voltages) volts.push_back(voltage / 1000.0f);
+    return lemlib::avg(volts);
+}
+
+tiger::Feedforward tiger::Chassis::characterize(CharacterizeSettings settings) {
+    // take the mutex, so nothing else drives the robot during the tests
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return {};
+    distTraveled = 0;
+
+    FILE* log = nullptr;
+    if (settings.log != nullptr) {
+        log = std::fopen(settings.log, "w");
+        if (log == nullptr) {
+            TIGER_WARN(lemlib::infoSink(), "Couldn't open {}, not logging characterization", settings.log);
+        } else std::fprintf(log, "test,direction,time,voltage,velocity,acceleration\n");
+    }
+
+    // forwards then backwards, so the robot ends up about where it started
+    FeedforwardFit fit;
+    runCharacterizationTest(settings, false, 1, fit, log);
+    runCharacterizationTest(settings, false, -1, fit, log);
+    runCharacterizationTest(settings, true, 1, fit, log);
+    runCharacterizationTest(settings, true, -1, fit, log);
+    if (log != nullptr) std::fclose(log);
+
+    const Feedforward feedforward = fit.solve();
+    TIGER_INFO(lemlib::infoSink(), "{} feedforward: kS {}, kV {}, kA {}, r^2 {} from {} samples",
+               settings.angular ? "Angular" : "Lateral", feedforward.kS, feedforward.kV, feedforward.kA, fit.getRSquared(),
+               fit.getCount());
+    if (!feedforward.isSet()) TIGER_WARN(lemlib::infoSink(), "Characterization failed, the robot didn't move enough");
+
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+    return feedforward;
+}
+
+void tiger::Chassis::runCharacterizationTest(const CharacterizeSettings& settings, bool step, float direction,
+                                             FeedforwardFit& fit, FILE* log) {
+    std::vector<CharacterizationSample> samples;
+    samples.reserve(settings.timeout / SAMPLE_PERIOD + 1);
+    const float maxTravel = settings.angular ? settings.maxAngle : settings.maxDistance;
+    // for turning, the top speed of the sides becomes degrees per second of the robot
+    const float topSpeed =
+        settings.angular ? lemlib::radToDeg(2 * getTopSpeed() / drivetrain.trackWidth) : getTopSpeed();
+    float traveled = 0;
+    const uint64_t start = pros::micros();
+    uint32_t now = pros::millis();
+
+    while (this->motionRunning) {
+        const float time = (pros::micros() - start) / 1e6f;
+        if (time * 1000 >= settings.timeout || traveled >= maxTravel) break;
+
+        // quasistatic tests ramp slowly enough that acceleration barely matters, step tests are mostly acceleration
+        const float volts = direction * std::fmin(step ? settings.stepVoltage : settings.rampRate * time, 12);
+        drivetrain.leftMotors->move_voltage(volts * 1000);
+        drivetrain.rightMotors->move_voltage((settings.angular ? -volts : volts) * 1000);
+        pros::Task::delay_until(&now, SAMPLE_PERIOD);
+
+        // read back what the motors actually applied, and how fast they are going
+        const float leftVoltage = getSideVoltage(drivetrain.leftMotors);
+        const float rightVoltage = getSideVoltage(drivetrain.rightMotors);
+        const float left = getSideSpeed(drivetrain.leftMotors, drivetrain.wheelDiameter, drivetrain.rpm);
+        const float right = getSideSpeed(drivetrain.rightMotors, drivetrain.wheelDiameter, drivetrain.rpm);
+        CharacterizationSample sample;
+        sample.time = (pros::micros() - start) / 1e6f;
+        if (settings.angular) {
+            sample.voltage = (leftVoltage - rightVoltage) / 2;
+            sample.velocity = lemlib::radToDeg((left - right) / drivetrain.trackWidth);
+        } else {
+            sample.voltage = (leftVoltage + rightVoltage) / 2;
+            sample.velocity = (left + right) / 2;
+        }
+        if (!samples.empty()) traveled += std::fabs(sample.velocity) * (sample.time - samples.back().time);
+        samples.push_back(sample);
+    }
+
+    // let the robot stop before the next test
+    drivetrain.leftMotors->move_voltage(0);
+    drivetrain.rightMotors->move_voltage(0);
+    pros::delay(REST_TIME);
+
+    // acceleration from the samples on either side, which is less noisy than from the previous sample alone
+    for (size_t i = 1; i + 1 < samples.size(); i++) {
+        const CharacterizationSample& sample = samples[i];
+        const float acceleration =
+            (samples[i + 1].velocity - samples[i - 1].velocity) / (samples[i + 1].time - samples[i - 1].time);
+        if (log != nullptr)
+            std::fprintf(log, "%s,%d,%.3f,%.3f,%.3f,%.3f\n", step ? "step" : "quasistatic", int(direction),
+                         sample.time, sample.voltage, sample.velocity, acceleration);
+        if (std::fabs(sample.velocity) < STILL * topSpeed) continue;
+        fit.add(sample.voltage, sample.velocity, acceleration);
+    }
+}
@@ -0,0 +1,331 @@
+#include <cmath>
+#include "pros/misc.h"
+#include "lemlib/logger/logger.hpp"
+#include "tiger/log/level.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/util.hpp"
+#include "tiger/chassis/chassis.hpp"
+#include "tiger/log/profiler.hpp"
+#include "tiger/task/executor.hpp"
+
+void tiger::Chassis::calibrate(bool calibrateIMU, OdomSettings settings) {
+    // calibrate the IMU if it exists and the user doesn't specify otherwise
+    if (sensors.imu != nullptr && calibrateIMU) {
+        int attempt = 1;
+        // calibrate inertial, and if calibration fails, then repeat 5 times or until successful
+        while (attempt <= 5) {
+            sensors.imu->reset();
+            // wait until IMU is calibrated
+            do pros::delay(10);
+            while (sensors.imu->get_status() != pros::ImuStatus::error && sensors.imu->is_calibrating());
+            // exit if imu has been calibrated
+            if (!std::isnan(sensors.imu->get_heading()) && !std::isinf(sensors.imu->get_heading())) break;
+            // indicate error
+            pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, "---");
+            TIGER_WARN(lemlib::infoSink(), "IMU failed to calibrate! Attempt #{}", attempt);
+            attempt++;
+        }
+        // check if calibration attempts were successful
+        if (attempt > 5) {
+            sensors.imu = nullptr;
+            TIGER_ERROR(lemlib::infoSink(), "IMU calibration failed, defaulting to tracking wheels / motor encoders");
+        }
+    }
+    if (sensors.imu != nullptr && settings.imuDataRate != 0) sensors.imu->set_data_rate(settings.imuDataRate);
+
+    // substitute missing vertical tracking wheels with the drivetrain, like LemLib does
+    if (sensors.vertical1 == nullptr)
+        sensors.vertical1 = new lemlib::TrackingWheel(drivetrain.leftMotors, drivetrain.wheelDiameter,
+                                                      -(drivetrain.trackWidth / 2), drivetrain.rpm);
+    if (sensors.vertical2 == nullptr)
+        sensors.vertical2 = new lemlib::TrackingWheel(drivetrain.rightMotors, drivetrain.wheelDiameter,
+                                                      drivetrain.trackWidth / 2, drivetrain.rpm);
+    sensors.vertical1->reset();
+    sensors.vertical2->reset();
+    if (sensors.horizontal1 != nullptr) sensors.horizontal1->reset();
+    if (sensors.horizontal2 != nullptr) sensors.horizontal2->reset();
+
+    OdomGeometry geometry;
+    geometry.vertical1Offset = sensors.vertical1->getOffset();
+    geometry.vertical2Offset = sensors.vertical2->getOffset();
+    geometry.vertical1Powered = sensors.vertical1->getType();
+    geometry.vertical2Powered = sensors.vertical2->getType();
+    geometry.hasHorizontal1 = sensors.horizontal1 != nullptr;
+    geometry.hasHorizontal2 = sensors.horizontal2 != nullptr;
+    if (geometry.hasHorizontal1) geometry.horizontal1Offset = sensors.horizontal1->getOffset();
+    if (geometry.hasHorizontal2) geometry.horizontal2Offset = sensors.horizontal2->getOffset();
+    geometry.hasImu = sensors.imu != nullptr;
+
+    // LemLib still gets the sensors so anything reading them through it keeps working, but lemlib::init() is never
+    // called. Running both tracking tasks would integrate every movement twice
+    lemlib::setSensors(sensors, drivetrain);
+
+    // the fusion filter always gets the drivetrain encoders, even if they aren't substituting a tracking wheel
+    FusionGeometry fusionGeometry;
+    if (fusionEnabled) {
+        if (leftDrive == nullptr)
+            leftDrive = new lemlib::TrackingWheel(drivetrain.leftMotors, drivetrain.wheelDiameter,
+                                                  -(drivetrain.trackWidth / 2), drivetrain.rpm);
+        if (rightDrive == nullptr)
+            rightDrive = new lemlib::TrackingWheel(drivetrain.rightMotors, drivetrain.wheelDiameter,
+                                                   drivetrain.trackWidth / 2, drivetrain.rpm);
+        leftDrive->reset();
+        rightDrive->reset();
+        fusionGeometry.trackWidth = drivetrain.trackWidth;
+        if (!geometry.vertical1Powered) fusionGeometry.verticalOffset = geometry.vertical1Offset;
+        else if (!geometry.vertical2Powered) fusionGeometry.verticalOffset = geometry.vertical2Offset;
+        if (geometry.hasHorizontal1) fusionGeometry.horizontalOffset = geometry.horizontal1Offset;
+        else if (geometry.hasHorizontal2) fusionGeometry.horizontalOffset = geometry.horizontal2Offset;
+    }
+
+    odomMutex.take();
+    odom = OdomIntegrator(geometry);
+    fusion = OdomFusion(fusionGeometry, fusionSettings);
+    fusion.setPose(lemlib::getPose(true));
+    odomStats = {};
+    publishedStats.store(odomStats);
+    odomSpeed.store(odom.getSpeed());
+    odomLocalSpeed.store(odom.getLocalSpeed());
+    odomSettings = settings;
+    odomMutex.give();
+    if (odomTask == nullptr && !odomScheduled) {
+        if (settings.executor != nullptr) {
+            settings.executor->add("odom", settings.period, settings.priority, [this] { updateOdom(); });
+            odomScheduled = true;
+        } else {
+            odomTask =
+                new pros::Task {[this] { odomLoop(); }, odomSettings.priority, TASK_STACK_DEPTH_DEFAULT, "odom"};
+        }
+    }
+
+    // rumble to controller to indicate success
+    pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, ".");
+}
+
+tiger::OdomSample tiger::Chassis::readSensors() {
+    OdomSample sample;
+    sample.time = pros::micros();
+    // when the drivetrain motors are the tracking wheels, their positions are as old as the motors' last report,
+    // which they timestamp to the millisecond. Stamping that instead of now keeps the speed estimate free of the
+    // jitter in when this task runs
+    if (sensors.vertical1->getType() && sensors.vertical2->getType()) {
+        uint32_t timestamp = 0;
+        if (drivetrain.leftMotors->get_raw_position(&timestamp) != PROS_ERR && timestamp != 0)
+            sample.time = static_cast<uint64_t>(timestamp) * 1000;
+    }
+    sample.vertical1 = sensors.vertical1->getDistanceTraveled();
+    sample.vertical2 = sensors.vertical2->getDistanceTraveled();
+    if (sensors.horizontal1 != nullptr) sample.horizontal1 = sensors.horizontal1->getDistanceTraveled();
+    if (sensors.horizontal2 != nullptr) sample.horizontal2 = sensors.horizontal2->getDistanceTraveled();
+    if (sensors.imu != nullptr) sample.imu = lemlib::degToRad(sensors.imu->get_rotation());
+    return sample;
+}
+
+void tiger::Chassis::setFusion(FusionSettings settings, pros::Gps* gps) {
+    fusionEnabled = true;
+    fusionSettings = settings;
+    this->gps = gps;
+}
+
+tiger::FusionSample tiger::Chassis::readFusionSensors(const OdomSample& sample) {
+    // inches in a meter
+    constexpr float METER = 39.3701;
+
+    FusionSample fusionSample;
+    fusionSample.time = sample.time;
+    // use a tracking wheel that isn't substituted by the drivetrain, if there is one
+    if (!sensors.vertical1->getType()) {
+        fusionSample.vertical = sample.vertical1;
+        fusionSample.hasVertical = true;
+    } else if (!sensors.vertical2->getType()) {
+        fusionSample.vertical = sample.vertical2;
+        fusionSample.hasVertical = true;
+    }
+    if (sensors.horizontal1 != nullptr) {
+        fusionSample.horizontal = sample.horizontal1;
+        fusionSample.hasHorizontal = true;
+    } else if (sensors.horizontal2 != nullptr) {
+        fusionSample.horizontal = sample.horizontal2;
+        fusionSample.hasHorizontal = true;
+    }
+    fusionSample.leftDrive = leftDrive->getDistanceTraveled();
+    fusionSample.rightDrive = rightDrive->getDistanceTraveled();
+    if (sensors.imu != nullptr) {
+        const pros::imu_accel_s_t accel = sensors.imu->get_accel();
+        fusionSample.setImu(fusionSettings, sample.imu, sensors.imu->get_gyro_rate().z, accel.x, accel.y);
+    }
+    if (gps != nullptr) {
+        const pros::gps_status_s_t status = gps->get_position_and_orientation();
+        fusionSample.gpsX = status.x * METER;
+        fusionSample.gpsY = status.y * METER;
+        fusionSample.gpsHeading = lemlib::degToRad(gps->get_heading());
+        fusionSample.gpsError = gps->get_error() * METER;
+        fusionSample.hasGps = std::isfinite(fusionSample.gpsX) && std::isfinite(fusionSample.gpsError);
+    }
+    return fusionSample;
+}
+
+void tiger::Chassis::updateOdom() {
+    const OdomSample sample = readSensors();
+    const FusionSample fusionSample = fusionEnabled ? readFusionSensors(sample) : FusionSample();
+
+    odomMutex.take();
+    // a setPose() since the sensors were read has pushed a newer pose to the history, which has to stay in time
+    // order. The sample is skipped, and the next one's deltas cover it
+    const std::optional<PoseSample> latest = poseHistory.latest();
+    if (latest && static_cast<int32_t>(static_cast<uint32_t>(sample.time) - latest->time) < 0) {
+        odomMutex.give();
+        return;
+    }
+    const uint32_t start = pros::micros();
+    // integrate on top of LemLib's pose so setPose() calls made in the meantime are respected
+    odom.setPose(lemlib::getPose(true));
+    const float dt = odom.step(sample);
+    // the integrator still runs in fusion mode, it's where the speed estimate comes from
+    if (fusionEnabled) fusion.step(fusionSample);
+    const lemlib::Pose pose = fusionEnabled ? fusion.getPose() : odom.getPose();
+    lemlib::setPose(pose, true);
+    poseHistory.push(pose, sample.time);
+    odomStats.updateTime = pros::micros() - start;
+    if (odomStats.updateTime > odomStats.maxUpdateTime) odomStats.maxUpdateTime = odomStats.updateTime;
+
+    // the measured period includes any time this task spent waiting to be scheduled
+    const uint32_t period = dt * 1000000;
+    if (dt > 0) {
+        odomStats.cycles++;
+        odomStats.lastPeriod = period;
+        if (period > odomStats.maxPeriod) odomStats.maxPeriod = period;
+        if (period >= (odomSettings.period + 1) * 1000) odomStats.overruns++;
+    }
+    // only stored with the mutex held, so there's one writer at a time
+    publishedStats.store(odomStats);
+    odomSpeed.store(odom.getSpeed());
+    odomLocalSpeed.store(odom.getLocalSpeed());
+    odomMutex.give();
+}
+
+void tiger::Chassis::odomLoop() {
+    TaskProfile& profile = profiler().addTask("odom", odomSettings.period);
+    uint32_t now = pros::millis();
+    while (true) {
+        profile.begin();
+        updateOdom();
+        profile.end();
+        odomMutex.take();
+        const uint32_t taskPeriod = odomSettings.period;
+        odomMutex.give();
+
+        // if this cycle ran past its deadline, start counting from now instead of firing the missed cycles
+        // back to back, which would only produce samples a few microseconds apart
+        if (pros::millis() - now >= taskPeriod) now = pros::millis();
+        pros::Task::delay_until(&now, taskPeriod);
+    }
+}
+
+void tiger::Chassis::setPose(float x, float y, float theta, bool radians) {
+    setPose(lemlib::Pose(x, y, theta), radians);
+}
+
+void tiger::Chassis::setPose(lemlib::Pose pose, bool radians) {
+    odomMutex.take();
+    lemlib::Chassis::setPose(pose, radians);
+    fusion.setPose(lemlib::getPose(true));
+    // poses from before the jump must not be blended with poses after it
+    poseHistory.clear();
+    poseHistory.push(lemlib::getPose(true), pros::micros());
+    odomMutex.give();
+}
+
+lemlib::Pose tiger::Chassis::convertPose(lemlib::Pose pose, bool radians, bool standardPos) {
+    if (standardPos) pose.theta = M_PI_2 - pose.theta;
+    if (!radians) pose.theta = lemlib::radToDeg(pose.theta);
+    return pose;
+}
+
+lemlib::Pose tiger::Chassis::getPose(bool radians, bool standardPos) {
+    const std::optional<PoseSample> sample = poseHistory.latest();
+    // nothing has been recorded before the chassis is calibrated
+    if (!sample) return lemlib::Chassis::getPose(radians, standardPos);
+    return convertPose(sample->pose, radians, standardPos);
+}
+
+lemlib::Pose tiger::Chassis::getPoseAt(uint32_t time, bool radians, bool standardPos) {
+    const std::optional<lemlib::Pose> pose = poseHistory.at(time * 1000);
+    if (!pose) return lemlib::Chassis::getPose(radians, standardPos);
+    return convertPose(*pose, radians, standardPos);
+}
+
+lemlib::Pose tiger::Chassis::estimatePose(float time, bool radians) {
+    const std::optional<lemlib::Pose> pose = poseHistory.at(pros::micros() + static_cast<int32_t>(time * 1000000));
+    if (!pose) return lemlib::Chassis::getPose(radians);
+    return convertPose(*pose, radians, false);
+}
+
+void tiger::Chassis::setProfile(ProfileSettings settings) {
+    profileSettings = settings;
+    profileEnabled = true;
+}
+
+void tiger::Chassis::setFeedforward(Feedforward lateral, Feedforward angular) {
+    lateralFeedforward = lateral;
+    angularFeedforward = angular;
+}
+
+void tiger::Chassis::setSettle(SettleSettings lateral, SettleSettings angular) {
+    lateralSettle = SettleDetector(lateral);
+    angularSettle = SettleDetector(angular);
+    settleEnabled = true;
+}
+
+float tiger::Chassis::getLateralFeedforward(const ProfileState& reference) const {
+    if (lateralFeedforward.isSet()) return lateralFeedforward.getPower(reference.velocity, reference.acceleration);
+    return reference.velocity * 127 / getTopSpeed();
+}
+
+float tiger::Chassis::getTopSpeed() const { return drivetrain.rpm / 60 * M_PI * drivetrain.wheelDiameter; }
+
+tiger::ProfileConstraints tiger::Chassis::getProfileConstraints(float maxSpeed) const {
+    ProfileConstraints constraints;
+    constraints.maxVelocity = getTopSpeed() * profileSettings.velocityScale * std::fabs(maxSpeed) / 127;
+    constraints.maxAcceleration = profileSettings.maxAcceleration;
+    if (constraints.maxAcceleration <= 0) constraints.maxAcceleration = getTopSpeed() / 0.3f;
+    constraints.maxJerk = profileSettings.maxJerk;
+    if (constraints.maxJerk <= 0) constraints.maxJerk = constraints.maxAcceleration / 0.1f;
+    if (profileSettings.trapezoidal) constraints.maxJerk = 0;
+    return constraints;
+}
+
+lemlib::Pose tiger::Chassis::getSpeed(bool radians) {
+    lemlib::Pose speed = odomSpeed.load();
+    if (!radians) speed.theta = lemlib::radToDeg(speed.theta);
+    return speed;
+}
+
+lemlib::Pose tiger::Chassis::getLocalSpeed(bool radians) {
+    lemlib::Pose speed = odomLocalSpeed.load();
+    if (!radians) speed.theta = lemlib::radToDeg(speed.theta);
+    return speed;
+}
+
+tiger::OdomStats tiger::Chassis::getOdomStats() { return publishedStats.load(); }
+
+void tiger::Chassis::cancelMotion() {
+    cancels++;
+    lemlib::Chassis::cancelMotion();
+}
+
+void tiger::Chassis::cancelAllMotions() {
+    cancels++;
+    lemlib::Chassis::cancelAllMotions();
+}
+
+tiger::Action tiger::Chassis::untilDone() {
+    // like waitUntilDone(), give an async motion's task time to start first
+    co_await tiger::delayMs(10);
+    co_await tiger::waitUntil([this] { return distTraveled == -1; });
+}
+
+tiger::Action tiger::Chassis::untilTraveled(float distance) {
+    co_await tiger::delayMs(10);
+    co_await tiger::waitUntil([this, distance] { return distTraveled >= distance || distTraveled == -1; });
+}
@@ -0,0 +1,214 @@
+#include <cmath>
+#include <algorithm>
+#include "lemlib/util.hpp"
+#include "tiger/chassis/fusion.hpp"
+
+void tiger::Ekf::reset(lemlib::Pose pose, float variance) {
+    for (int i = 0; i < N; i++) {
+        state[i] = 0;
+        for (int j = 0; j < N; j++) covariance[i][j] = 0;
+    }
+    setPose(pose);
+    covariance[X][X] = variance;
+    covariance[Y][Y] = variance;
+    covariance[THETA][THETA] = 0.0001;
+    covariance[V_FORWARD][V_FORWARD] = 1;
+    covariance[V_LATERAL][V_LATERAL] = 1;
+}
+
+void tiger::Ekf::setPose(lemlib::Pose pose) {
+    state[X] = pose.x;
+    state[Y] = pose.y;
+    state[THETA] = pose.theta;
+}
+
+void tiger::Ekf::predict(float dt, float gyroRate, float accelForward, float accelLateral, float accelVariance,
+                         float gyroVariance) {
+    const float sinTheta = std::sin(state[THETA]);
+    const float cosTheta = std::cos(state[THETA]);
+    const float vForward = state[V_FORWARD];
+    const float vLateral = state[V_LATERAL];
+
+    // jacobian of the motion model. Lateral velocity is positive to the left, like LemLib's local x
+    float f[N][N] = {};
+    for (int i = 0; i < N; i++) f[i][i] = 1;
+    f[X][THETA] = (vForward * cosTheta + vLateral * sinTheta) * dt;
+    f[X][V_FORWARD] = sinTheta * dt;
+    f[X][V_LATERAL] = -cosTheta * dt;
+    f[Y][THETA] = (-vForward * sinTheta + vLateral * cosTheta) * dt;
+    f[Y][V_FORWARD] = cosTheta * dt;
+    f[Y][V_LATERAL] = sinTheta * dt;
+    f[V_FORWARD][V_LATERAL] = -gyroRate * dt;
+    f[V_LATERAL][V_FORWARD] = gyroRate * dt;
+
+    // propagate the state. The velocity terms account for the robot's frame rotating underneath the accelerometer
+    state[X] += (vForward * sinTheta - vLateral * cosTheta) * dt;
+    state[Y] += (vForward * cosTheta + vLateral * sinTheta) * dt;
+    state[THETA] += gyroRate * dt;
+    state[V_FORWARD] += (accelForward - gyroRate * vLateral) * dt;
+    state[V_LATERAL] += (accelLateral + gyroRate * vForward) * dt;
+
+    // propagate the covariance, P = F * P * F^T + Q
+    float fp[N][N];
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            float sum = 0;
+            for (int k = 0; k < N; k++) sum += f[i][k] * covariance[k][j];
+            fp[i][j] = sum;
+        }
+    }
+    for (int i = 0; i < N; i++) {
+        for (int j = i; j < N; j++) {
+            float sum = 0;
+            for (int k = 0; k < N; k++) sum += fp[i][k] * f[j][k];
+            covariance[i][j] = sum;
+            covariance[j][i] = sum;
+        }
+    }
+    const float dt2 = dt * dt;
+    covariance[X][X] += accelVariance * dt2 * dt2 / 4;
+    covariance[Y][Y] += accelVariance * dt2 * dt2 / 4;
+    covariance[THETA][THETA] += gyroVariance * dt2;
+    covariance[V_FORWARD][V_FORWARD] += accelVariance * dt2;
+    covariance[V_LATERAL][V_LATERAL] += accelVariance * dt2;
+}
+
+void tiger::Ekf::update(const float (&h)[N], float innovation, float variance) {
+    // P * h^T
+    float ph[N];
+    for (int i = 0; i < N; i++) {
+        float sum = 0;
+        for (int j = 0; j < N; j++) sum += covariance[i][j] * h[j];
+        ph[i] = sum;
+    }
+    // innovation variance
+    float s = variance;
+    for (int i = 0; i < N; i++) s += h[i] * ph[i];
+    if (s <= 0) return;
+
+    // apply the kalman gain
+    for (int i = 0; i < N; i++) state[i] += ph[i] / s * innovation;
+    for (int i = 0; i < N; i++) {
+        for (int j = i; j < N; j++) {
+            const float value = covariance[i][j] - ph[i] * ph[j] / s;
+            covariance[i][j] = value;
+            covariance[j][i] = value;
+        }
+    }
+}
+
+void tiger::Ekf::updateForwardVelocity(float velocity, float offset, float gyroRate, float variance) {
+    // a point to the right of the tracking center moves backwards when turning clockwise
+    constexpr float h[N] = {0, 0, 0, 1, 0};
+    update(h, velocity - (state[V_FORWARD] - gyroRate * offset), variance);
+}
+
+void tiger::Ekf::updateLateralVelocity(float velocity, float offset, float gyroRate, float variance) {
+    // a point in front of the tracking center moves right when turning clockwise
+    constexpr float h[N] = {0, 0, 0, 0, 1};
+    update(h, velocity - (state[V_LATERAL] - gyroRate * offset), variance);
+}
+
+void tiger::Ekf::updateHeading(float heading, float variance, bool wrap) {
+    constexpr float h[N] = {0, 0, 1, 0, 0};
+    float innovation = heading - state[THETA];
+    if (wrap) innovation = std::remainder(innovation, 2 * M_PI);
+    update(h, innovation, variance);
+}
+
+void tiger::Ekf::updatePosition(float x, float y, float variance) {
+    constexpr float hX[N] = {1, 0, 0, 0, 0};
+    constexpr float hY[N] = {0, 1, 0, 0, 0};
+    update(hX, x - state[X], variance);
+    update(hY, y - state[Y], variance);
+}
+
+lemlib::Pose tiger::Ekf::getPose() const { return lemlib::Pose(state[X], state[Y], state[THETA]); }
+
+/**
+ * @brief Read one IMU axis as mounted on the robot
+ */
+static float imuAxis(float x, float y, tiger::FusionSettings::Axis axis) {
+    switch (axis) {
+        case tiger::FusionSettings::Axis::X: return x;
+        case tiger::FusionSettings::Axis::Y: return y;
+        case tiger::FusionSettings::Axis::NEG_X: return -x;
+        case tiger::FusionSettings::Axis::NEG_Y: return -y;
+    }
+    return 0;
+}
+
+void tiger::FusionSample::setImu(const FusionSettings& settings, float rotation, float gyroRate, float accelX,
+                                 float accelY) {
+    // inches per second squared in one g
+    constexpr float G = 386.09;
+
+    const float rate = lemlib::degToRad(gyroRate);
+    imuRotation = rotation;
+    this->gyroRate = settings.gyroClockwise ? rate : -rate;
+    accelForward = imuAxis(accelX, accelY, settings.imuForward) * G;
+    accelLateral = imuAxis(accelX, accelY, settings.imuLeft) * G;
+    hasImu = std::isfinite(this->gyroRate) && std::isfinite(accelForward);
+}
+
+tiger::OdomFusion::OdomFusion(FusionGeometry geometry, FusionSettings settings)
+    : geometry(geometry),
+      settings(settings) {
+    ekf.reset(lemlib::Pose(0, 0, 0));
+}
+
+float tiger::OdomFusion::step(const FusionSample& sample) {
+    if (!primed) {
+        prev = sample;
+        primed = true;
+        if (sample.hasImu) imuOffset = ekf.get(Ekf::THETA) - sample.imuRotation;
+        return 0;
+    }
+    const float dt = (sample.time - prev.time) / 1000000.0f;
+    if (dt <= 0) return 0;
+
+    // without an IMU, the rate of rotation has to come from the drivetrain
+    float gyroRate = sample.gyroRate;
+    if (!sample.hasImu && geometry.trackWidth != 0)
+        gyroRate = ((sample.leftDrive - prev.leftDrive) - (sample.rightDrive - prev.rightDrive)) / geometry.trackWidth /
+                   dt;
+    const float accelForward = sample.hasImu ? sample.accelForward : 0;
+    const float accelLateral = sample.hasImu ? sample.accelLateral : 0;
+    ekf.predict(dt, gyroRate, accelForward, accelLateral, settings.accelStd * settings.accelStd,
+                settings.gyroStd * settings.gyroStd);
+
+    // forward velocity
+    if (sample.hasVertical)
+        ekf.updateForwardVelocity((sample.vertical - prev.vertical) / dt, geometry.verticalOffset, gyroRate,
+                                  settings.wheelStd * settings.wheelStd);
+    if (geometry.trackWidth != 0)
+        ekf.updateForwardVelocity(((sample.leftDrive - prev.leftDrive) + (sample.rightDrive - prev.rightDrive)) / 2 /
+                                      dt,
+                                  0, gyroRate, settings.driveStd * settings.driveStd);
+
+    // lateral velocity. Without a horizontal wheel, assume the robot doesn't slide and let the accelerometer argue
+    if (sample.hasHorizontal)
+        ekf.updateLateralVelocity((sample.horizontal - prev.horizontal) / dt, geometry.horizontalOffset, gyroRate,
+                                  settings.wheelStd * settings.wheelStd);
+    else ekf.updateLateralVelocity(0, 0, gyroRate, settings.lateralStd * settings.lateralStd);
+
+    // heading
+    if (sample.hasImu)
+        ekf.updateHeading(sample.imuRotation + imuOffset, settings.imuHeadingStd * settings.imuHeadingStd);
+
+    // absolute position
+    if (sample.hasGps && sample.gpsError <= settings.gpsMaxError) {
+        ekf.updatePosition(sample.gpsX, sample.gpsY, std::max(sample.gpsError * sample.gpsError, 0.25f));
+        ekf.updateHeading(sample.gpsHeading, settings.gpsHeadingStd * settings.gpsHeadingStd, true);
+    }
+
+    prev = sample;
+    return dt;
+}
+
+void tiger::OdomFusion::setPose(lemlib::Pose pose) {
+    ekf.setPose(pose);
+    if (primed && prev.hasImu) imuOffset = pose.theta - prev.imuRotation;
+}
+
+lemlib::Pose tiger::OdomFusion::getPose() const { return ekf.getPose(); }
@@ -0,0 +1,132 @@
+#include <cmath>
+#include <algorithm>
+#include <optional>
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "tiger/log/level.hpp"
+#include "tiger/chassis/chassis.hpp"
+
+void tiger::Chassis::moveToPoint(float x, float y, int timeout, lemlib::MoveToPointParams params, bool async) {
+    // without a profile this is LemLib's motion
+    if (!profileEnabled) {
+        lemlib::Chassis::moveToPoint(x, y, timeout, params, async);
+        return;
+    }
+    params.earlyExitRange = std::fabs(params.earlyExitRange);
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([=, this]() { moveToPoint(x, y, timeout, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    // reset PIDs and exit conditions
+    lateralPID.reset();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    angularPID.reset();
+    lateralSettle.reset();
+    settleState = SettleState::MOVING;
+
+    // plan the whole motion once, along the line from where we are to the target
+    const lemlib::Pose start = getPose(true, true);
+    lemlib::Pose target(x, y);
+    target.theta = start.angle(target);
+    const float distance = start.distance(target);
+    const float direction = params.forwards ? 1 : -1;
+    const float velocityToPower = 127 / getTopSpeed();
+    // when chaining, arrive at the speed the next motion starts at instead of stopping
+    const float exitVelocity = std::fabs(params.minSpeed) / velocityToPower;
+    // when chained, start from the speed the previous motion left us at instead of from a stop
+    const float startVelocity = std::fmax(direction * getLocalSpeed().y, 0);
+    const MotionProfile profile(distance, getProfileConstraints(params.maxSpeed), startVelocity, exitVelocity);
+
+    // initialize vars used between iterations
+    lemlib::Pose lastPose = start;
+    distTraveled = 0;
+    lemlib::Timer timer(timeout);
+    const uint32_t startTime = pros::millis();
+    bool close = false;
+    std::optional<bool> prevSide = std::nullopt;
+
+    // main loop
+    while (!timer.isDone() && this->motionRunning) {
+        // update position
+        const lemlib::Pose pose = getPose(true, true);
+
+        // update distance traveled
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        // motion chaining
+        const bool side = (pose.y - target.y) * -std::sin(target.theta) <=
+                          (pose.x - target.x) * std::cos(target.theta) + params.earlyExitRange;
+        if (prevSide == std::nullopt) prevSide = side;
+        if (side != prevSide && params.minSpeed != 0) break;
+        prevSide = side;
+
+        // how far along the line to the target we are, and where the profile says we should be
+        const float progress =
+            (pose.x - start.x) * std::cos(target.theta) + (pose.y - start.y) * std::sin(target.theta);
+        const float elapsed = (pros::millis() - startTime) / 1000.0f;
+        const ProfileState reference = profile.sample(elapsed);
+
+        // only exit once the profile is done, otherwise we could exit while passing through the target zone
+        lateralSmallExit.update(distance - progress);
+        lateralLargeExit.update(distance - progress);
+        if (elapsed >= profile.getDuration() && (lateralSmallExit.getExit() || lateralLargeExit.getExit())) break;
+
+        // follow the profile. The feedforward drives it, the PID corrects the position error
+        float lateralOut = getLateralFeedforward(reference) + lateralPID.update(reference.position - progress);
+        lateralOut = std::clamp(lateralOut, -params.maxSpeed, params.maxSpeed);
+        // constrain lateral output by the minimum speed
+        if (lateralOut > 0 && lateralOut < std::fabs(params.minSpeed)) lateralOut = std::fabs(params.minSpeed);
+
+        // done once the robot has stopped at the target, or given up if it can't get there
+        if (settleEnabled) {
+            settleState = lateralSettle.update(distance - progress, direction * getLocalSpeed().y, lateralOut);
+            if (settleState == SettleState::STALLED) TIGER_WARN(lemlib::infoSink(), "Motion stalled, aborting");
+            if (settleState != SettleState::MOVING) break;
+        }
+        lateralOut *= direction;
+
+        // correct the heading on the way, but not when close since the angle to the target becomes unstable
+        if (pose.distance(target) < 7.5) close = true;
+        const float adjustedRobotTheta = params.forwards ? pose.theta : pose.theta + M_PI;
+        float angularOut = 0;
+        if (!close)
+            angularOut = angularPID.update(lemlib::radToDeg(lemlib::angleError(adjustedRobotTheta, pose.angle(target))));
+        angularOut = std::clamp(angularOut, -params.maxSpeed, params.maxSpeed);
+
+        TIGER_DEBUG(lemlib::infoSink(), "Profile: {}, Lateral Out: {}, Angular Out: {}", reference.position, lateralOut,
+                    angularOut);
+
+        // ratio the speeds to respect the max speed
+        float leftPower = lateralOut + angularOut;
+        float rightPower = lateralOut - angularOut;
+        const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / params.maxSpeed;
+        if (ratio > 1) {
+            leftPower /= ratio;
+            rightPower /= ratio;
+        }
+
+        // move the drivetrain
+        drivetrain.leftMotors->move(leftPower);
+        drivetrain.rightMotors->move(rightPower);
+
+        // delay to save resources
+        pros::delay(10);
+    }
+
+    // stop the drivetrain
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
@@ -0,0 +1,80 @@
+#include "pros/rtos.hpp"
+#include "tiger/input/controller.hpp"
+
+tiger::ControllerInput::ControllerInput(pros::Controller& controller, InputSettings settings)
+    : controller(controller),
+      settings(settings) {}
+
+void tiger::ControllerInput::update() {
+    const uint32_t time = pros::millis();
+    for (size_t i = 0; i < AXES; i++) axes[i] = controller.get_analog(pros::controller_analog_e_t(i));
+
+    for (size_t i = 0; i < BUTTONS; i++) {
+        Button& button = buttons[i];
+        const bool down = controller.get_digital(pros::controller_digital_e_t(pros::E_CONTROLLER_DIGITAL_L1 + i));
+        button.events = 0;
+        if (down && !button.down) {
+            emit(i, ButtonEvent::PRESSED, time);
+            // a third press straight after a double tap starts a new one instead of making another
+            if (button.tapPending && time - button.pressTime <= settings.doubleTapTime) {
+                emit(i, ButtonEvent::DOUBLE_TAPPED, time);
+                button.tapPending = false;
+            } else {
+                button.tapPending = true;
+            }
+            button.pressTime = time;
+            button.heldFired = false;
+        } else if (!down && button.down) {
+            emit(i, ButtonEvent::RELEASED, time);
+        }
+        if (down && !button.heldFired && time - button.pressTime >= settings.holdTime) {
+            emit(i, ButtonEvent::HELD, time);
+            button.heldFired = true;
+            // a hold isn't a tap
+            button.tapPending = false;
+        }
+        button.down = down;
+    }
+
+    // every button is sampled before any callback runs, so callbacks see the whole tick's snapshot
+    for (Binding& binding : bindings) {
+        if (buttons[binding.button].events & (1 << int(binding.event))) binding.callback();
+    }
+}
+
+void tiger::ControllerInput::emit(size_t index, ButtonEvent event, uint32_t time) {
+    buttons[index].events |= 1 << int(event);
+    if (queue == nullptr) return;
+    const InputEvent item {pros::controller_digital_e_t(pros::E_CONTROLLER_DIGITAL_L1 + index), event, time};
+    if (!pros::c::queue_append(queue, &item, 0)) dropped++;
+}
+
+bool tiger::ControllerInput::isDown(pros::controller_digital_e_t button) const {
+    return buttons[button - pros::E_CONTROLLER_DIGITAL_L1].down;
+}
+
+bool tiger::ControllerInput::hasEvent(pros::controller_digital_e_t button, ButtonEvent event) const {
+    return buttons[button - pros::E_CONTROLLER_DIGITAL_L1].events & (1 << int(event));
+}
+
+int32_t tiger::ControllerInput::getAnalog(pros::controller_analog_e_t channel) const { return axes[channel]; }
+
+void tiger::ControllerInput::on(pros::controller_digital_e_t button, ButtonEvent event,
+                                std::function<void()> callback) {
+    bindings.push_back({size_t(button - pros::E_CONTROLLER_DIGITAL_L1), event, std::move(callback)});
+}
+
+void tiger::ControllerInput::toggle(pros::controller_digital_e_t button, pros::adi::DigitalOut& piston, bool state) {
+    // each toggle keeps its own state, so flipping one piston never changes what the next press of another does
+    on(button, ButtonEvent::PRESSED, [&piston, state]() mutable {
+        state = !state;
+        piston.set_value(state);
+    });
+}
+
+pros::c::queue_t tiger::ControllerInput::createQueue(uint32_t length) {
+    if (queue == nullptr) queue = pros::c::queue_create(length, sizeof(InputEvent));
+    return queue;
+}
+
+uint32_t tiger::ControllerInput::getDropped() const { return dropped; }
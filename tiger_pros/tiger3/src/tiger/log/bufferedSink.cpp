@@ -0,0 +1,22 @@
+#include <cstdio>
+#include "tiger/log/bufferedSink.hpp"
+
+// bytes of output bufferedStdout() holds before it drops messages
+static constexpr size_t STDOUT_CAPACITY = 8192;
+
+tiger::BufferedSink::BufferedSink(std::shared_ptr<OutputBuffer> buffer, const std::string& format)
+    : buffer(std::move(buffer)) {
+    setFormat(format);
+}
+
+void tiger::BufferedSink::sendMessage(const lemlib::Message& message) { buffer->push(message.message); }
+
+std::shared_ptr<tiger::OutputBuffer> tiger::bufferedStdout() {
+    static std::shared_ptr<OutputBuffer> buffer = std::make_shared<OutputBuffer>(
+        [](std::string_view string) {
+            std::fwrite(string.data(), 1, string.size(), stdout);
+            std::fflush(stdout);
+        },
+        STDOUT_CAPACITY, FullPolicy::DROP_OLDEST);
+    return buffer;
+}
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <cstdint>
+#include "lemlib/pose.hpp"
+
+namespace tiger {
+/**
+ * @brief Extended Kalman filter for a differential drive robot
+ *
+ * The state is [x, y, theta, forward velocity, lateral velocity], in inches, radians and inches per second. Like
+ * LemLib, theta is 0 towards +y and positive clockwise, and lateral velocity is positive to the left.
+ *
+ * The lateral velocity is what lets the filter notice a push: the accelerometer drives it away from zero while the
+ * tracking wheels keep reporting that the robot is driving straight.
+ *
+ * Everything is a fixed size float array and every measurement is a scalar update, so there is no heap allocation
+ * and no matrix inversion. An update is a few hundred multiply-adds.
+ */
+class Ekf {
+    public:
+        /** number of states */
+        static constexpr int N = 5;
+        /** indices into the state */
+        enum Index { X = 0, Y, THETA, V_FORWARD, V_LATERAL };
+        /**
+         * @brief Reset the filter to a known pose, at rest
+         *
+         * @param pose the pose, theta in radians
+         * @param variance initial variance of the position, in square inches
+         */
+        void reset(lemlib::Pose pose, float variance = 0.01);
+        /**
+         * @brief Set the pose without touching the velocity estimate
+         *
+         * @param pose the pose, theta in radians
+         */
+        void setPose(lemlib::Pose pose);
+        /**
+         * @brief Propagate the state forwards in time
+         *
+         * @param dt time step, in seconds
+         * @param gyroRate rate of rotation, in radians per second, clockwise positive
+         * @param accelForward acceleration along the robot's forward axis, in inches per second squared
+         * @param accelLateral acceleration along the robot's left axis, in inches per second squared
+         * @param accelVariance variance of the acceleration, in (inches per second squared) squared
+         * @param gyroVariance variance of the gyro rate, in (radians per second) squared
+         */
+        void predict(float dt, float gyroRate, float accelForward, float accelLateral, float accelVariance,
+                     float gyroVariance);
+        /**
+         * @brief Fuse a measurement of the forward velocity of a point on the robot
+         *
+         * Used for vertical tracking wheels and drivetrain encoders.
+         *
+         * @param velocity the measured velocity, in inches per second
+         * @param offset lateral offset of the sensor from the tracking center, in inches, right positive
+         * @param gyroRate rate of rotation, in radians per second, clockwise positive
+         * @param variance variance of the measurement
+         */
+        void updateForwardVelocity(float velocity, float offset, float gyroRate, float variance);
+        /**
+         * @brief Fuse a measurement of the lateral velocity of a point on the robot
+         *
+         * Used for horizontal tracking wheels, and with a velocity of 0 as the "wheels don't slide sideways" prior.
+         *
+         * @param velocity the measured velocity, in inches per second, left positive
+         * @param offset forward offset of the sensor from the tracking center, in inches
+         * @param gyroRate rate of rotation, in radians per second, clockwise positive
+         * @param variance variance of the measurement
+         */
+        void updateLateralVelocity(float velocity, float offset, float gyroRate, float variance);
+        /**
+         * @brief Fuse a heading measurement
+         *
+         * @param heading the measured heading, in radians
+         * @param variance variance of the measurement
+         * @param wrap true if the measurement is only known modulo 2pi, like a GPS heading
+         */
+        void updateHeading(float heading, float variance, bool wrap = false);
+        /**
+         * @brief Fuse an absolute position measurement
+         *
+         * @param x measured x position, in inches
+         * @param y measured y position, in inches
+         * @param variance variance of the measurement in each axis, in square inches
+         */
+        void updatePosition(float x, float y, float variance);
+        /**
+         * @brief Get the estimated pose
+         *
+         * @return lemlib::Pose theta in radians
+         */
+        lemlib::Pose getPose() const;
+        /**
+         * @brief Get a single state
+         *
+         * @param index which state
+         * @return float
+         */
+        float get(Index index) const { return state[index]; }
+        /**
+         * @brief Get the variance of a single state
+         *
+         * @param index which state
+         * @return float
+         */
+        float getVariance(Index index) const { return covariance[index][index]; }
+    private:
+        /**
+         * @brief Fuse a scalar measurement z = h . state + noise
+         *
+         * @param h the measurement row
+         * @param innovation measured value minus predicted value
+         * @param variance variance of the measurement
+         */
+        void update(const float (&h)[N], float innovation, float variance);
+
+        float state[N] = {};
+        float covariance[N][N] = {};
+};
+
+/**
+ * @brief Noise and mounting parameters for sensor fusion
+ *
+ * Standard deviations are in inches, radians and seconds. Larger values mean the sensor is trusted less.
+ */
+struct FusionSettings {
+        /** which IMU axis points towards the front of the robot */
+        enum class Axis { X, Y, NEG_X, NEG_Y };
+        /** IMU axis pointing forward */
+        Axis imuForward = Axis::Y;
+        /** IMU axis pointing left */
+        Axis imuLeft = Axis::NEG_X;
+        /** true if the IMU z gyro rate is positive clockwise */
+        bool gyroClockwise = false;
+        /** accelerometer noise, in inches per second squared */
+        float accelStd = 40;
+        /** gyro noise, in radians per second */
+        float gyroStd = 0.02;
+        /** tracking wheel velocity noise, in inches per second */
+        float wheelStd = 1.5;
+        /** drivetrain encoder velocity noise, in inches per second. High, since drive wheels slip when pushing */
+        float driveStd = 10;
+        /** how strongly the robot is assumed not to slide sideways, in inches per second */
+        float lateralStd = 3;
+        /** IMU heading noise, in radians */
+        float imuHeadingStd = 0.004;
+        /** GPS heading noise, in radians */
+        float gpsHeadingStd = 0.05;
+        /** GPS fixes reporting an error larger than this, in inches, are ignored */
+        float gpsMaxError = 4;
+};
+
+/**
+ * @brief One set of readings for the fusion filter. Device free, so recorded samples can be replayed on a host
+ */
+struct FusionSample {
+        /** time the sample was taken, in microseconds */
+        uint64_t time = 0;
+        /** distance traveled by the vertical tracking wheel, in inches */
+        float vertical = 0;
+        /** distance traveled by the horizontal tracking wheel, in inches */
+        float horizontal = 0;
+        /** distance traveled by the left side of the drivetrain, in inches */
+        float leftDrive = 0;
+        /** distance traveled by the right side of the drivetrain, in inches */
+        float rightDrive = 0;
+        /** IMU rotation, in radians, clockwise positive */
+        float imuRotation = 0;
+        /** IMU gyro rate, in radians per second, clockwise positive */
+        float gyroRate = 0;
+        /** acceleration along the robot's forward axis, in inches per second squared */
+        float accelForward = 0;
+        /** acceleration along the robot's left axis, in inches per second squared */
+        float accelLateral = 0;
+        /** GPS position, in inches */
+        float gpsX = 0;
+        /** GPS position, in inches */
+        float gpsY = 0;
+        /** GPS heading, in radians, clockwise positive */
+        float gpsHeading = 0;
+        /** error reported by the GPS, in inches */
+        float gpsError = 0;
+        /** whether the vertical tracking wheel reading is valid */
+        bool hasVertical = false;
+        /** whether the horizontal tracking wheel reading is valid */
+        bool hasHorizontal = false;
+        /** whether the IMU readings are valid */
+        bool hasImu = false;
+        /** whether there is a GPS fix in this sample */
+        bool hasGps = false;
+
+        /**
+         * @brief Fill in the IMU readings from what the IMU reports, turned to match how it's mounted
+         *
+         * @param settings which way the IMU is mounted
+         * @param rotation IMU rotation, in radians, clockwise positive
+         * @param gyroRate the IMU's z gyro rate, in degrees per second
+         * @param accelX acceleration along the IMU's x axis, in g
+         * @param accelY acceleration along the IMU's y axis, in g
+         */
+        void setImu(const FusionSettings& settings, float rotation, float gyroRate, float accelX, float accelY);
+};
+
+/**
+ * @brief Geometry needed to interpret a FusionSample
+ */
+struct FusionGeometry {
+        /** lateral offset of the vertical tracking wheel, in inches, right positive */
+        float verticalOffset = 0;
+        /** forward offset of the horizontal tracking wheel, in inches */
+        float horizontalOffset = 0;
+        /** distance between the left and right drive wheels, in inches */
+        float trackWidth = 0;
+};
+
+/**
+ * @brief Runs an Ekf on FusionSamples
+ *
+ * Turns the raw distances into velocities, fuses everything available in a sample, and keeps the IMU heading aligned
+ * with the pose set by the user.
+ */
+class OdomFusion {
+    public:
+        /**
+         * @brief Construct a new Odom Fusion
+         *
+         * @param geometry where the sensors are mounted
+         * @param settings noise parameters
+         */
+        OdomFusion(FusionGeometry geometry = {}, FusionSettings settings = {});
+        /**
+         * @brief Integrate a new sample
+         *
+         * @param sample the new readings
+         * @return float time since the previous sample in seconds, or 0 if this was the first sample
+         */
+        float step(const FusionSample& sample);
+        /**
+         * @brief Set the pose. Velocities are kept
+         *
+         * @param pose the new pose, theta in radians
+         */
+        void setPose(lemlib::Pose pose);
+        /**
+         * @brief Get the fused pose
+         *
+         * @return lemlib::Pose theta in radians
+         */
+        lemlib::Pose getPose() const;
+        /**
+         * @brief Get the filter, e.g. to look at the velocity estimate or its uncertainty
+         *
+         * @return const Ekf&
+         */
+        const Ekf& getFilter() const { return ekf; }
+    private:
+        FusionGeometry geometry;
+        FusionSettings settings;
+        Ekf ekf;
+        FusionSample prev;
+        bool primed = false;
+        /** difference between the filter heading and the IMU rotation */
+        float imuOffset = 0;
+};
+} // namespace tiger
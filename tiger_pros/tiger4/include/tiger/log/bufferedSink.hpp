@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lemlib/logger/baseSink.hpp"
+#include "tiger/log/outputBuffer.hpp"
+
+namespace tiger {
+/**
+ * @brief A LemLib sink that pushes its messages to an OutputBuffer
+ *
+ * Works like lemlib::InfoSink and lemlib::TelemetrySink, but its memory is bounded and logging never waits for
+ * another task that's logging.
+ *
+ * @b Example
+ * @code {.cpp}
+ * auto sink = std::make_shared<tiger::BufferedSink>(tiger::bufferedStdout(), "[{level}] {time}: {message}\n");
+ * sink->info("Chassis pose: {}", chassis.getPose());
+ * // or, without formatting on the control task
+ * tiger::deferredLog().startFlushTask(sink);
+ * @endcode
+ */
+class BufferedSink : public lemlib::BaseSink {
+    public:
+        /**
+         * @brief Construct a new Buffered Sink
+         *
+         * @param buffer where messages go
+         * @param format the format of messages, like lemlib::BaseSink::setFormat's. Ends with a newline, the
+         * buffer doesn't add one
+         */
+        explicit BufferedSink(std::shared_ptr<OutputBuffer> buffer, const std::string& format = "{message}\n");
+    protected:
+        void sendMessage(const lemlib::Message& message) override;
+    private:
+        std::shared_ptr<OutputBuffer> buffer;
+};
+
+/**
+ * @brief A buffer that writes to stdout, which is the serial port on the brain
+ *
+ * @return std::shared_ptr<OutputBuffer> the same buffer every time. Full buffers drop the oldest messages
+ */
+std::shared_ptr<OutputBuffer> bufferedStdout();
+} // namespace tiger
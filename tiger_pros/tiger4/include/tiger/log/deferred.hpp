@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include "pros/rtos.hpp"
+#include "lemlib/logger/baseSink.hpp"
+#include "tiger/log/level.hpp"
+#include "fmt/format.h"
+
+namespace tiger {
+/**
+ * @brief How an argument of a deferred log record is stored
+ *
+ * Anything trivially copyable with a fmt formatter, like numbers, enums and lemlib::Pose, is copied as raw bytes.
+ * Other types have to be converted before they are logged.
+ */
+template <typename T, typename = void> struct DeferredArg {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "deferred log arguments must be trivially copyable or strings, format anything else first");
+        using Stored = T;
+
+        static size_t size(const T&) { return sizeof(T); }
+
+        static void write(uint8_t*& out, const T& value) {
+            std::memcpy(out, &value, sizeof(T));
+            out += sizeof(T);
+        }
+
+        static T read(const uint8_t*& in) {
+            std::array<std::byte, sizeof(T)> bytes;
+            std::memcpy(bytes.data(), in, sizeof(T));
+            in += sizeof(T);
+            return std::bit_cast<T>(bytes);
+        }
+};
+
+/**
+ * @brief Strings are copied into the record, since whatever they point to may be gone by the time it's formatted
+ *
+ * Longer strings are cut to MAX_LENGTH characters.
+ */
+template <typename T>
+struct DeferredArg<T, std::enable_if_t<std::is_same_v<T, const char*> || std::is_same_v<T, char*> ||
+                                       std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>>> {
+        using Stored = std::string_view;
+        static constexpr size_t MAX_LENGTH = 255;
+
+        static std::string_view view(const T& value) {
+            if constexpr (std::is_pointer_v<T>) return value == nullptr ? "(null)" : std::string_view(value);
+            else return std::string_view(value);
+        }
+
+        static size_t size(const T& value) { return 1 + std::min(view(value).size(), MAX_LENGTH); }
+
+        static void write(uint8_t*& out, const T& value) {
+            const std::string_view string = view(value).substr(0, MAX_LENGTH);
+            *out++ = string.size();
+            std::memcpy(out, string.data(), string.size());
+            out += string.size();
+        }
+
+        static std::string_view read(const uint8_t*& in) {
+            const size_t length = *in++;
+            const std::string_view string(reinterpret_cast<const char*>(in), length);
+            in += length;
+            return string;
+        }
+};
+
+/**
+ * @brief A format string known at compile time, checked against the argument types T
+ *
+ * A record only keeps a view of its format until it's flushed, so unlike fmt::format_string this can't be made from
+ * fmt::runtime() or any other string built while the program runs. Whatever a constant expression points to lives
+ * as long as the program does.
+ */
+template <typename... T> class BasicDeferredFormat {
+    public:
+        template <typename S, typename = std::enable_if_t<std::is_convertible_v<const S&, std::string_view>>>
+        consteval BasicDeferredFormat(const S& string)
+            : format(string) {
+            // checks the placeholders against the arguments, like fmt::format does
+            [[maybe_unused]] const fmt::format_string<T...> checked(string);
+        }
+
+        std::string_view get() const { return format; }
+    private:
+        std::string_view format;
+};
+
+/**
+ * @brief The format string of a record logged with the arguments T. T is never deduced from it
+ */
+template <typename... T> using DeferredFormat = BasicDeferredFormat<std::type_identity_t<T>...>;
+
+/**
+ * @brief Formats the arguments of a record, for the argument types the record was logged with
+ */
+using DeferredFormatter = void (*)(fmt::memory_buffer& out, std::string_view format, const uint8_t* args);
+
+/**
+ * @brief A record waiting in a DeferredLog
+ */
+struct DeferredRecord {
+        lemlib::Level level;
+        /** milliseconds since the program started, when the record was logged */
+        uint32_t time;
+        /** the format string, not always null terminated. Points into the program, so it's always valid */
+        std::string_view format;
+        /** the arguments, as stored by DeferredArg. May be followed by a few bytes of padding */
+        std::span<const uint8_t> args;
+        DeferredFormatter formatter;
+
+        /**
+         * @brief Format the record's message
+         *
+         * @param out the buffer to append the message to
+         */
+        void formatTo(fmt::memory_buffer& out) const { formatter(out, format, args.data()); }
+};
+
+/**
+ * @brief A log that records now and formats later
+ *
+ * lemlib::BaseSink::log formats the message, builds a dynamic argument store, formats it again with the sink's
+ * format, and moves the result into a Message, all on the heap and all on the task that logged it. This copies the
+ * format string's pointer and the raw arguments into a ring buffer that's allocated once, which takes a fraction of
+ * the time and never touches the heap. Formatting happens later, on whichever task calls flush(), like the one
+ * startFlushTask() starts. Records that are shipped as binary never have to be formatted at all.
+ *
+ * Any number of tasks can log at once, but only one may flush. When the ring is full, new records are dropped and
+ * counted instead of waiting for room.
+ *
+ * @b Example
+ * @code {.cpp}
+ * void initialize() {
+ *     // format everything on a low priority task, into a bounded buffer that the serial port drains
+ *     tiger::deferredLog().startFlushTask(std::make_shared<tiger::BufferedSink>(tiger::bufferedStdout()));
+ * }
+ *
+ * void autonomous() {
+ *     // no formatting or allocation on this task
+ *     tiger::deferredLog().info("Chassis pose: {}", chassis.getPose());
+ * }
+ * @endcode
+ */
+class DeferredLog {
+    public:
+        /**
+         * @brief Construct a new Deferred Log
+         *
+         * @param capacity size of the ring buffer, in bytes. Allocated here, once
+         */
+        explicit DeferredLog(size_t capacity = 8192);
+        DeferredLog(const DeferredLog&) = delete;
+        DeferredLog& operator=(const DeferredLog&) = delete;
+        ~DeferredLog();
+
+        /**
+         * @brief Record a message at the given level
+         *
+         * The format string is checked at compile time, like fmt::format's, and has to be known then.
+         *
+         * @param level the level of the message
+         * @param format the format of the message. Use "{}" as placeholders
+         * @param args the values substituted into the placeholders once the record is formatted
+         */
+        template <typename... T> void log(lemlib::Level level, DeferredFormat<T...> format, T&&... args) {
+            if (level < lowestLevel) return;
+            const size_t argsSize = (size_t(0) + ... + DeferredArg<std::decay_t<T>>::size(args));
+            uint8_t* out = reserve(argsSize);
+            if (out == nullptr) return;
+            (DeferredArg<std::decay_t<T>>::write(out, args), ...);
+            commit(level, format.get(), &formatArgs<std::decay_t<T>...>);
+        }
+
+        template <typename... T> void debug(DeferredFormat<T...> format, T&&... args) {
+            if constexpr (isCompiledIn(lemlib::Level::DEBUG))
+                log(lemlib::Level::DEBUG, format, std::forward<T>(args)...);
+        }
+
+        template <typename... T> void info(DeferredFormat<T...> format, T&&... args) {
+            if constexpr (isCompiledIn(lemlib::Level::INFO))
+                log(lemlib::Level::INFO, format, std::forward<T>(args)...);
+        }
+
+        template <typename... T> void warn(DeferredFormat<T...> format, T&&... args) {
+            if constexpr (isCompiledIn(lemlib::Level::WARN))
+                log(lemlib::Level::WARN, format, std::forward<T>(args)...);
+        }
+
+        template <typename... T> void error(DeferredFormat<T...> format, T&&... args) {
+            if constexpr (isCompiledIn(lemlib::Level::ERROR))
+                log(lemlib::Level::ERROR, format, std::forward<T>(args)...);
+        }
+
+        template <typename... T> void fatal(DeferredFormat<T...> format, T&&... args) {
+            if constexpr (isCompiledIn(lemlib::Level::FATAL))
+                log(lemlib::Level::FATAL, format, std::forward<T>(args)...);
+        }
+
+        /**
+         * @brief Ignore messages below a level. Ignored messages cost a comparison
+         *
+         * @param level the lowest level that is recorded. INFO, the lowest, by default
+         */
+        void setLowestLevel(lemlib::Level level) { lowestLevel = level; }
+        /**
+         * @brief Hand every waiting record to a function, oldest first, and free its space
+         *
+         * @note only one task may flush
+         *
+         * @param handler called with each record. The record's arguments are only valid during the call
+         * @return size_t how many records were handled
+         */
+        size_t flush(const std::function<void(const DeferredRecord&)>& handler);
+        /**
+         * @brief Start a task that formats every waiting record and logs it to a LemLib sink
+         *
+         * The sink's {time} is when the record was flushed. The time it was logged is prepended to the message when
+         * the flush task falls more than a period behind.
+         *
+         * @param sink the sink to log to
+         * @param period milliseconds between flushes
+         * @param priority priority of the flush task. Low, so it only runs when the control tasks are idle
+         */
+        void startFlushTask(std::shared_ptr<lemlib::BaseSink> sink, uint32_t period = 50,
+                            uint32_t priority = TASK_PRIORITY_MIN + 1);
+        /**
+         * @brief Get how many records were dropped because the ring was full
+         */
+        uint32_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+    private:
+        /**
+         * @brief Header of a record in the ring. The arguments follow it
+         */
+        struct Header {
+                /** bytes from this header to the next one. 0 means the next record is at the start of the ring */
+                uint32_t size;
+                uint32_t time;
+                lemlib::Level level;
+                std::string_view format;
+                DeferredFormatter formatter;
+        };
+
+        /**
+         * @brief Format the arguments of a record logged with the argument types T
+         */
+        template <typename... T> static void formatArgs(fmt::memory_buffer& out, std::string_view format,
+                                                        const uint8_t* args) {
+            // a braced list is evaluated in order, so the arguments are read in the order they were written
+            std::tuple<typename DeferredArg<T>::Stored...> values {DeferredArg<T>::read(args)...};
+            std::apply([&](const auto&... value) { fmt::vformat_to(fmt::appender(out), format,
+                                                                   fmt::make_format_args(value...)); },
+                       values);
+        }
+
+        /**
+         * @brief Take the producer lock and make room for a record
+         *
+         * @param argsSize bytes of arguments
+         * @return uint8_t* where the arguments go, or nullptr if the record doesn't fit. On success, the lock is held
+         * until commit()
+         */
+        uint8_t* reserve(size_t argsSize);
+        /**
+         * @brief Fill in the record reserve() made room for, publish it, and release the producer lock
+         */
+        void commit(lemlib::Level level, std::string_view format, DeferredFormatter formatter);
+
+        std::unique_ptr<uint8_t[]> ring;
+        size_t capacity;
+        /** where the next record goes, only moved by producers */
+        std::atomic<size_t> head = 0;
+        /** where the oldest record is, only moved by the flushing task */
+        std::atomic<size_t> tail = 0;
+        /** where the record being written starts, and its size including the header */
+        size_t pending = 0;
+        size_t pendingSize = 0;
+        pros::Mutex producerMutex;
+        std::atomic<uint32_t> dropped = 0;
+        lemlib::Level lowestLevel = lemlib::Level::INFO;
+        pros::Task* flushTask = nullptr;
+};
+
+/**
+ * @brief The deferred log shared by the whole program
+ */
+DeferredLog& deferredLog();
+} // namespace tiger
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "tiger/log/outputBuffer.hpp"
+
+namespace tiger {
+class Profiler;
+
+/**
+ * @brief The profile of one task's loop. Get one from Profiler::addTask
+ *
+ * The task calls begin() when it wakes up and end() before it sleeps again. Both only touch this task's counters, so
+ * they cost a couple of reads of the clock, plus a formatted line when tracing.
+ */
+class TaskProfile {
+    public:
+        /**
+         * @brief Mark the start of an iteration, right after the task wakes up
+         */
+        void begin();
+        /**
+         * @brief Mark the end of an iteration, right before the task sleeps
+         */
+        void end();
+        /**
+         * @brief Forget the task running the loop, like when the loop is about to end. The next begin() picks up
+         * whichever task calls it
+         */
+        void detach();
+    private:
+        friend class Profiler;
+
+        TaskProfile(Profiler* profiler, std::string name, uint32_t period, uint32_t id);
+
+        Profiler* profiler;
+        std::string name;
+        /** microseconds between iterations, or 0 for a task that waits for something instead */
+        uint32_t period;
+        /** thread id in the trace */
+        uint32_t id;
+        /** the task running the loop, set by the first begin() it calls. Written under the profiler's mutex */
+        std::atomic<pros::task_t> task = nullptr;
+        /** its name, to check it's still alive before reading its stack */
+        char taskName[32] = "";
+        /** when the current iteration started, and when the one before it did */
+        uint64_t start = 0;
+        uint64_t lastStart = 0;
+        /** how late the current iteration started, in microseconds */
+        uint32_t late = 0;
+        std::atomic<uint32_t> iterations = 0;
+        /** microseconds, wrapping around every 71 minutes */
+        std::atomic<uint32_t> runTime = 0;
+        std::atomic<uint32_t> maxRun = 0;
+        std::atomic<uint32_t> maxLate = 0;
+        /** iterations that ran longer than the period, or started a period late */
+        std::atomic<uint32_t> overruns = 0;
+        /** counters at the last Profiler::getStats() */
+        uint32_t lastIterations = 0;
+        uint32_t lastRunTime = 0;
+};
+
+/**
+ * @brief What a task did since the previous Profiler::getStats()
+ */
+struct TaskStats {
+        std::string name;
+        /** fraction of the time the task was running, from 0 to 1. Includes time it was preempted */
+        float cpu = 0;
+        /** iterations per second, each a wake up and a switch back out */
+        float rate = 0;
+        /** average and longest iteration, in microseconds */
+        uint32_t averageRun = 0;
+        uint32_t maxRun = 0;
+        /** latest start of an iteration after its period, in microseconds */
+        uint32_t maxLate = 0;
+        /** iterations that ran longer than the period or started a period late, since the task was added */
+        uint32_t overruns = 0;
+        /**
+         * bytes of stack that have never been used, or -1 when the kernel doesn't say, the task is gone, or another
+         * task with the same name was started first
+         */
+        int32_t stackFree = -1;
+};
+
+/**
+ * @brief Measures how long each task's loop runs, how late it wakes up, and how much of its stack it has used
+ *
+ * The PROS API has no per-task run time counters or scheduler hooks, so loops report their own iterations instead:
+ * every instrumented loop brackets its work with TaskProfile::begin() and end(). Each task's CPU share, iteration
+ * rate, longest iteration and worst lateness come from that. A loop that overruns its period, or a task that keeps
+ * others from waking up on time, shows up as lateness. Free stack comes from FreeRTOS's high water mark, where the
+ * kernel provides it.
+ *
+ * The stats can be shown on the brain screen, and every iteration can be traced to an OutputBuffer in Chrome's trace
+ * event format, one event per line starting with "@trace ". tools/trace2json.py turns a recording of the serial port
+ * into a file chrome://tracing and ui.perfetto.dev open, with a row per task.
+ *
+ * @b Example
+ * @code {.cpp}
+ * void opcontrol() {
+ *     tiger::TaskProfile& profile = tiger::profiler().addTask("opcontrol", 10);
+ *     uint32_t now = pros::millis();
+ *     while (true) {
+ *         profile.begin();
+ *         chassis.arcade(leftY, rightX);
+ *         profile.end();
+ *         pros::Task::delay_until(&now, 10);
+ *     }
+ * }
+ * @endcode
+ */
+class Profiler {
+    public:
+        /**
+         * @brief Add a task's loop
+         *
+         * Adding a name that's already there returns its profile, so a task that's started again keeps its row. The
+         * profile forgets the old task, and picks up the new one at its first begin().
+         *
+         * @param name name of the loop, shown on the screen and in the trace
+         * @param period milliseconds between iterations, or 0 if the task waits for something instead
+         * @return TaskProfile& its profile, valid as long as the profiler
+         */
+        TaskProfile& addTask(const std::string& name, uint32_t period);
+        /**
+         * @brief Get what each task did since the last call. Call it from one task only
+         */
+        std::vector<TaskStats> getStats();
+        /**
+         * @brief Show the stats since the last call on the brain screen, a line per task
+         *
+         * @param firstLine the first line of the screen to use
+         */
+        void updateScreen(int firstLine = 3);
+        /**
+         * @brief Start a task that calls updateScreen() every period
+         *
+         * @param firstLine the first line of the screen to use
+         * @param period milliseconds between updates
+         */
+        void startScreenTask(int firstLine = 3, uint32_t period = 1000);
+        /**
+         * @brief Trace every iteration to an output
+         *
+         * @param output where to send the trace, or nullptr to stop tracing
+         */
+        void setTraceOutput(std::shared_ptr<OutputBuffer> output);
+    private:
+        friend class TaskProfile;
+
+        /**
+         * @brief Send the name of a task's row to the trace
+         */
+        void traceName(OutputBuffer* output, const TaskProfile& profile);
+
+        std::vector<std::unique_ptr<TaskProfile>> profiles;
+        uint64_t lastStats = 0;
+        std::atomic<OutputBuffer*> trace = nullptr;
+        /** every output it has had, kept alive because an iteration may still be using an old one */
+        std::vector<std::shared_ptr<OutputBuffer>> outputs;
+        pros::Task* screenTask = nullptr;
+        pros::Mutex mutex;
+};
+
+/**
+ * @brief The profiler shared by the whole program
+ */
+Profiler& profiler();
+} // namespace tiger
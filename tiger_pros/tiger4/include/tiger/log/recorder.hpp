@@ -0,0 +1,216 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "pros/abstract_motor.hpp"
+#include "pros/imu.hpp"
+#include "pros/rtos.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+
+namespace tiger {
+/**
+ * @brief Settings of a Recorder
+ */
+struct RecorderSettings {
+        /** start of the recording's file name. The first free number and ".rec" are appended */
+        std::string prefix = "/usd/rec";
+        /** milliseconds between samples. 10, 100 Hz, is as fast as motors report */
+        uint32_t period = 10;
+        /** samples per block. A block is written and flushed at once, so a power cut loses at most this many */
+        uint32_t blockRows = 100;
+        /** blocks that can wait for the SD card before samples are dropped */
+        uint32_t blockCount = 4;
+        /** priority of the task that samples */
+        uint32_t samplePriority = TASK_PRIORITY_DEFAULT;
+        /** priority of the task that writes. Below every control task, so they never wait for the SD card */
+        uint32_t writePriority = TASK_PRIORITY_MIN + 1;
+};
+
+/**
+ * @brief Records motors, sensors and the pose to the SD card, for looking at after a match
+ *
+ * A sample task reads every source at a fixed rate and fills a block, column by column: the time of each sample, then
+ * each column's values. Full blocks go to a write task below the control tasks, which writes each one with a single
+ * fwrite and flushes it, so nothing that drives the robot ever waits for the SD card. When the card falls behind
+ * and every block is waiting, samples are dropped and counted instead.
+ *
+ * Every value is a float, and every block has room for the same number of samples, so a recording is a header and
+ * blocks of a fixed size. The header, padded to a multiple of 512 bytes, is:
+ * - "TREC", uint16 version, uint16 columns, uint32 rows per block, uint32 period in milliseconds, uint32 size of the
+ *   header, uint32 size of a block
+ * - the column names, separated by commas and ending with a zero byte
+ *
+ * and a block, padded to a multiple of 512 bytes, is:
+ * - "TBLK", uint32 sequence number, uint32 rows, uint32 samples dropped since recording started
+ * - uint32 milliseconds since the program started, for each row
+ * - float values of each column, for each row
+ *
+ * All little endian. tools/recording2csv.py turns a recording into a CSV file.
+ *
+ * @b Example
+ * @code {.cpp}
+ * tiger::Recorder recorder;
+ *
+ * void initialize() {
+ *     chassis.calibrate();
+ *     recorder.addMotors("left", &leftMotors);
+ *     recorder.addMotors("right", &rightMotors);
+ *     recorder.addImu("imu", &imu);
+ *     recorder.addPose("pose", &chassis);
+ *     // keeps recording until the robot is turned off
+ *     recorder.start();
+ * }
+ * @endcode
+ */
+class Recorder {
+    public:
+        /**
+         * @brief Construct a new Recorder. Nothing is recorded until it's started
+         *
+         * @param settings the settings
+         */
+        explicit Recorder(RecorderSettings settings = {});
+        Recorder(const Recorder&) = delete;
+        Recorder& operator=(const Recorder&) = delete;
+        ~Recorder();
+
+        /**
+         * @brief Record columns of values
+         *
+         * @param names name of each column
+         * @param sample called from the sample task with an array of a value per column to fill. Keep it quick
+         */
+        void addColumns(std::vector<std::string> names, std::function<void(float*)> sample);
+        /**
+         * @brief Record a value
+         *
+         * @param name name of the column
+         * @param sample called from the sample task for the value
+         */
+        void addColumn(const std::string& name, std::function<float()> sample);
+        /**
+         * @brief Record the velocity (rpm), current (mA), voltage (mV), temperature (degrees Celsius) and position
+         * (rotations of the cartridge's output) of each motor in a group
+         *
+         * Columns are named like name_velocity0. Read with the group's get_*_all functions, so each is one call.
+         *
+         * @param name start of the column names
+         * @param motors the motor group, or a single motor
+         */
+        void addMotors(const std::string& name, pros::AbstractMotor* motors);
+        /**
+         * @brief Record the rotation (degrees), turn rate (degrees per second) and acceleration (g) of an IMU
+         *
+         * @param name start of the column names
+         * @param imu the IMU
+         */
+        void addImu(const std::string& name, pros::Imu* imu);
+        /**
+         * @brief Record the distance a tracking wheel has traveled, in inches
+         *
+         * @param name name of the column
+         * @param wheel the tracking wheel
+         */
+        void addTrackingWheel(const std::string& name, lemlib::TrackingWheel* wheel);
+        /**
+         * @brief Record the pose of a chassis: x and y in inches, theta in degrees
+         *
+         * @param name start of the column names
+         * @param chassis the chassis
+         */
+        void addPose(const std::string& name, lemlib::Chassis* chassis);
+        /**
+         * @brief Open a new file and start recording. Columns can't be added after this
+         *
+         * @return true if it started, false if it's already recording or the file couldn't be opened, like when
+         * there's no SD card
+         */
+        bool start();
+        /**
+         * @brief Write what's been sampled so far, and close the file
+         *
+         * Waits for the write task, so don't call it from a control task. Turning the robot off without stopping
+         * loses the samples that weren't written yet.
+         */
+        void stop();
+        /**
+         * @brief Check whether it's recording
+         */
+        bool isRecording() const { return file != nullptr; }
+        /**
+         * @brief Get the name of the file it's recording to, or an empty string
+         */
+        const std::string& getPath() const { return path; }
+        /**
+         * @brief Get how many samples were dropped because the SD card fell behind
+         */
+        uint32_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+    private:
+        /**
+         * @brief Header of a block. The times and columns follow it
+         */
+        struct BlockHeader {
+                char magic[4];
+                uint32_t sequence;
+                uint32_t rows;
+                uint32_t dropped;
+        };
+
+        /**
+         * @brief Something the sample task reads
+         */
+        struct Source {
+                /** number of columns */
+                size_t count;
+                std::function<void(float*)> sample;
+        };
+
+        /**
+         * @brief Take a sample into the block being filled
+         */
+        void sample();
+        /**
+         * @brief Hand the block being filled to the write task
+         */
+        void finishBlock();
+        /**
+         * @brief Write the blocks that are waiting, on the calling task
+         */
+        void writeBlocks();
+        /**
+         * @brief Get a block by its sequence number
+         */
+        uint8_t* block(uint32_t sequence) const;
+
+        RecorderSettings settings;
+        std::vector<std::string> names;
+        std::vector<Source> sources;
+        /** a value of each column, for the sources to fill */
+        std::vector<float> row;
+        /** bytes per block, padded for the SD card */
+        size_t blockSize = 0;
+        /** every block, allocated when recording starts. Aligned for the SD card */
+        std::unique_ptr<uint8_t, decltype(&std::free)> blocks {nullptr, &std::free};
+        /** blocks handed to the write task, and blocks written. The one being filled is the filled'th */
+        std::atomic<uint32_t> filled = 0;
+        std::atomic<uint32_t> written = 0;
+        /** rows in the block being filled */
+        uint32_t rows = 0;
+        std::atomic<uint32_t> dropped = 0;
+        std::atomic<bool> stopping = false;
+        /** whether the sample task and the write task are running */
+        std::atomic<bool> sampling = false;
+        std::atomic<bool> writing = false;
+        std::string path;
+        FILE* file = nullptr;
+        pros::Task* sampleTask = nullptr;
+        pros::Task* writeTask = nullptr;
+};
+} // namespace tiger
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+#include "pros/motor_group.hpp"
+#include "pros/rtos.hpp"
+#include "tiger/log/outputBuffer.hpp"
+
+namespace tiger {
+/**
+ * @brief How a value is packed into a telemetry frame, as a Python struct code
+ */
+template <typename T> struct TelemetryType;
+
+template <> struct TelemetryType<float> {
+        static constexpr char code = 'f';
+        static constexpr size_t count = 1;
+};
+
+template <> struct TelemetryType<int32_t> {
+        static constexpr char code = 'i';
+        static constexpr size_t count = 1;
+};
+
+template <> struct TelemetryType<uint32_t> {
+        static constexpr char code = 'I';
+        static constexpr size_t count = 1;
+};
+
+template <> struct TelemetryType<int16_t> {
+        static constexpr char code = 'h';
+        static constexpr size_t count = 1;
+};
+
+template <> struct TelemetryType<uint16_t> {
+        static constexpr char code = 'H';
+        static constexpr size_t count = 1;
+};
+
+template <> struct TelemetryType<int8_t> {
+        static constexpr char code = 'b';
+        static constexpr size_t count = 1;
+};
+
+template <> struct TelemetryType<uint8_t> {
+        static constexpr char code = 'B';
+        static constexpr size_t count = 1;
+};
+
+template <> struct TelemetryType<bool> {
+        static constexpr char code = '?';
+        static constexpr size_t count = 1;
+};
+
+/**
+ * @brief Arrays are sent as one field per element, named like the array with the index appended
+ */
+template <typename T, size_t N> struct TelemetryType<std::array<T, N>> {
+        static constexpr char code = TelemetryType<T>::code;
+        static constexpr size_t count = N;
+};
+
+template <typename... T> class TelemetryChannel;
+
+/**
+ * @brief Binary telemetry
+ *
+ * lemlib::TelemetrySink prints text, so a pose takes about 60 bytes and a format on the brain. This sends values as
+ * they are in memory, in frames of about 10 bytes plus the values, so a pose takes 22 bytes and packing it is a
+ * couple of copies. Each signal gets a channel with a schema, the name and type of each of its fields, which is sent
+ * along with the data every now and then, so a decoder can start listening at any time.
+ *
+ * A frame is a packet, COBS encoded and surrounded by zero bytes, so text on the same port can't be mistaken for one.
+ * A packet is:
+ * - uint8 type: 0 for a schema, 1 for data
+ * - uint8 channel
+ * - schema: the channel's name, the Python struct format of its values, and its comma separated field names, each
+ *   ending with a zero byte
+ * - data: uint32 milliseconds since the program started, then the values, little endian
+ * - uint8 CRC-8 of everything before it
+ *
+ * tools/telemetry2csv.py turns a recording into a CSV file per channel.
+ *
+ * @b Example
+ * @code {.cpp}
+ * void initialize() {
+ *     // the serial port. The PROS terminal shows frames as noise, read the port with tools/telemetry2csv.py instead
+ *     tiger::telemetry().setOutput(tiger::bufferedStdout());
+ * }
+ *
+ * void opcontrol() {
+ *     auto pose = tiger::telemetry().addChannel<float, float, float>("pose", {"x", "y", "theta"});
+ *     while (true) {
+ *         const lemlib::Pose current = chassis.getPose();
+ *         pose.send(current.x, current.y, current.theta);
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+class Telemetry {
+    public:
+        /** most bytes of values a channel can send at once */
+        static constexpr size_t MAX_PAYLOAD = 240;
+
+        /**
+         * @brief Construct a new Telemetry
+         *
+         * @param output where frames go. nullptr turns telemetry off, so sending costs a check
+         * @param schemaPeriod milliseconds between repeats of the schemas
+         */
+        explicit Telemetry(std::shared_ptr<OutputBuffer> output = nullptr, uint32_t schemaPeriod = 1000);
+        /**
+         * @brief Set where frames go, and send the schemas there
+         *
+         * @param output the buffer, or nullptr to turn telemetry off
+         */
+        void setOutput(std::shared_ptr<OutputBuffer> output);
+        /**
+         * @brief Add a channel
+         *
+         * The values a channel sends have the types it was added with, in the same order. Arrays of them are fine too.
+         *
+         * @param name name of the channel. Also names the decoder's CSV file
+         * @param fields name of each value
+         * @return TelemetryChannel<T...> the channel. Cheap to copy
+         */
+        template <typename... T>
+        TelemetryChannel<T...> addChannel(const std::string& name, std::array<const char*, sizeof...(T)> fields) {
+            static_assert((size_t(0) + ... + sizeof(T)) <= MAX_PAYLOAD, "too many values for one channel");
+            const std::string format = ((std::to_string(TelemetryType<T>::count) + TelemetryType<T>::code) + ...);
+            return TelemetryChannel<T...>(this, addSchema(name, format, {fields.begin(), fields.end()}));
+        }
+        /**
+         * @brief Send the schema of every channel now
+         */
+        void sendSchemas();
+        /**
+         * @brief Send the values of a channel. Use TelemetryChannel::send instead
+         *
+         * @param channel the channel
+         * @param payload the packed values
+         * @param size bytes of values, at most MAX_PAYLOAD
+         */
+        void send(uint8_t channel, const uint8_t* payload, size_t size);
+    private:
+        /**
+         * @brief Register a channel
+         *
+         * @return uint8_t the channel's number
+         */
+        uint8_t addSchema(const std::string& name, const std::string& format, std::vector<const char*> fields);
+        /**
+         * @brief Frame a packet and push it to the output
+         */
+        void sendPacket(OutputBuffer* output, uint8_t* packet, size_t size);
+
+        std::atomic<OutputBuffer*> output = nullptr;
+        /** every output it has had, kept alive because a send may still be using an old one */
+        std::vector<std::shared_ptr<OutputBuffer>> outputs;
+        uint32_t schemaPeriod;
+        std::atomic<uint32_t> schemaTime = 0;
+        /** packets of the schemas, without their CRC */
+        std::vector<std::string> schemas;
+        pros::Mutex mutex;
+};
+
+/**
+ * @brief A channel of a Telemetry
+ */
+template <typename... T> class TelemetryChannel {
+    public:
+        /**
+         * @brief Send one sample of the channel's values
+         *
+         * Doesn't allocate or format, and costs a check when telemetry is off.
+         */
+        void send(const T&... values) const {
+            std::array<uint8_t, (size_t(0) + ... + sizeof(T))> payload;
+            uint8_t* out = payload.data();
+            ((std::memcpy(out, &values, sizeof(T)), out += sizeof(T)), ...);
+            telemetry->send(id, payload.data(), payload.size());
+        }
+    private:
+        friend class Telemetry;
+
+        TelemetryChannel(Telemetry* telemetry, uint8_t id)
+            : telemetry(telemetry),
+              id(id) {}
+
+        Telemetry* telemetry;
+        uint8_t id;
+};
+
+/**
+ * @brief The telemetry shared by the whole program. Off until it's given an output
+ */
+Telemetry& telemetry();
+
+/**
+ * @brief Sends the velocity, current and temperature of up to N motors
+ *
+ * @b Example
+ * @code {.cpp}
+ * tiger::MotorTelemetry<8> drive("drive", {&leftMotors, &rightMotors});
+ * // velocity0 to velocity3 are the left motors, velocity4 to velocity7 the right ones
+ * drive.send();
+ * @endcode
+ */
+template <size_t N> class MotorTelemetry {
+    public:
+        /**
+         * @brief Construct a new Motor Telemetry, and add its channel
+         *
+         * @param name name of the channel
+         * @param groups the motors, in order. Motors past the first N aren't sent
+         * @param telemetry the telemetry to send to
+         */
+        MotorTelemetry(const std::string& name, std::initializer_list<pros::MotorGroup*> groups,
+                       Telemetry& telemetry = tiger::telemetry())
+            : groups(groups),
+              channel(telemetry.addChannel<std::array<float, N>, std::array<int16_t, N>, std::array<int8_t, N>>(
+                  name, {"velocity", "current", "temperature"})) {}
+
+        /**
+         * @brief Read the motors and send them. Velocities in rpm, currents in mA, temperatures in degrees Celsius
+         */
+        void send() {
+            std::array<float, N> velocity {};
+            std::array<int16_t, N> current {};
+            std::array<int8_t, N> temperature {};
+            size_t i = 0;
+            for (pros::MotorGroup* group : groups) {
+                for (int motor = 0; motor < group->size() && i < N; motor++, i++) {
+                    // errors read as the largest values
+                    velocity[i] = group->get_actual_velocity(motor);
+                    current[i] = std::clamp<int32_t>(group->get_current_draw(motor), INT16_MIN, INT16_MAX);
+                    temperature[i] = std::clamp<double>(group->get_temperature(motor), INT8_MIN, INT8_MAX);
+                }
+            }
+            channel.send(velocity, current, temperature);
+        }
+    private:
+        std::vector<pros::MotorGroup*> groups;
+        TelemetryChannel<std::array<float, N>, std::array<int16_t, N>, std::array<int8_t, N>> channel;
+};
+} // namespace tiger
@@ -1,5 +1,6 @@
 #include "main.h"
 #include "lemlib/api.hpp"
+#include "tiger/api.hpp"
 #include "lemlib/chassis/trackingWheel.hpp"
 #include "pros/adi.hpp"
 #include "pros/motor_group.hpp"
@@ -132,26 +133,59 @@ lemlib::ExpoDriveCurve steerCurve(3, // joystick deadband out of 127
 );
 
 // create the chassis
-lemlib::Chassis chassis(drivetrain, linearController, angularController, sensors, &throttleCurve, &steerCurve);
+tiger::Chassis chassis(drivetrain, linearController, angularController, sensors, &throttleCurve, &steerCurve);
+
+// records the drivetrain, the aux motors and the sensors to the SD card, for after the match
+tiger::Recorder recorder;
 
 
 void initialize() {
     pros::lcd::initialize(); // initialize brain screen
-    chassis.calibrate();     // calibrate sensorss
-
-    pros::Task screenTask([&]()
-                          {
-        while (true) {
-            // print robot location to the brain screen
-            pros::lcd::print(0, "X: %f", chassis.getPose().x); // x
-            pros::lcd::print(1, "Y: %f", chassis.getPose().y); // y
-            pros::lcd::print(2, "Theta: %f", chassis.getPose().theta); // heading
-            // log position telemetry
-            lemlib::telemetrySink()->info("Chassis pose: {}", chassis.getPose());
-            // delay to save resources
-            pros::delay(50);
-        } });
-
+    chassis.calibrate(true, {.executor = &tiger::executor()}); // calibrate sensors, then run odometry on the executor
+    chassis.setProfile({}); // accelerate and decelerate smoothly in moveToPoint and moveToPose
+    chassis.setSettle(); // end motions once the robot stops at the target, abort them when it is blocked
+    // format log messages off the control tasks, into a bounded buffer that the serial port drains
+    auto logSink = std::make_shared<tiger::BufferedSink>(tiger::bufferedStdout(), "[{level}] {time}: {message}\n");
+    tiger::deferredLog().startFlushTask(logSink);
+    recorder.addMotors("left", &leftMotorsGroup);
+    recorder.addMotors("right", &rightMotorsGroup);
+    recorder.addMotors("roller1", &roller1Motor);
+    recorder.addMotors("intakeFront", &intakeMotorFront);
+    recorder.addMotors("bazooka", &bazookaMotor);
+    recorder.addMotors("roller2", &roller2Motor);
+    recorder.addMotors("upperBackFlexWheel", &upperBackFlexWheelMotor);
+    recorder.addImu("imu", &imu);
+    recorder.addTrackingWheel("vertical", &vertical);
+    recorder.addPose("pose", &chassis);
+    recorder.start(); // a new file on the SD card every time the program starts, if there is a card
+
+    // binary telemetry, sent nowhere until tiger::telemetry() is given an output
+    static const auto poseTelemetry = tiger::telemetry().addChannel<float, float, float>("pose", {"x", "y", "theta"});
+    static tiger::MotorTelemetry<8> driveTelemetry("drive", {&leftMotorsGroup, &rightMotorsGroup});
+    // the screen and telemetry share one low priority task, instead of a task each
+    tiger::executor().add("screen", 50, TASK_PRIORITY_MIN + 1, [] {
+        // read the pose once so all fields come from the same odometry update
+        const lemlib::Pose pose = chassis.getPose();
+        // print robot location to the brain screen
+        pros::lcd::print(0, "X: %f", pose.x); // x
+        pros::lcd::print(1, "Y: %f", pose.y); // y
+        pros::lcd::print(2, "Theta: %f", pose.theta); // heading
+        // log position telemetry
+        tiger::deferredLog().info("Chassis pose: {}", pose);
+        poseTelemetry.send(pose.x, pose.y, pose.theta);
+        driveTelemetry.send();
+    });
+    tiger::executor().add("profiler", 1000, TASK_PRIORITY_MIN + 1, [] {
+        tiger::profiler().updateScreen(3); // how busy and how late each task is, under the pose
+    });
+
+#if TIGER_BENCH
+    // built with "make BENCH=1": time the control loop, logging and shared state on this brain, with the tasks above
+    // running, and print the results to the terminal
+    tiger::benchControlLoop(tiger::microsClock);
+    tiger::benchLogging(tiger::microsClock);
+    tiger::benchSharedState(tiger::microsClock);
+#endif
 }
 
 void disabled() {}
@@ -163,39 +197,47 @@ void competition_initialize() {
 
 ASSET(example_txt);
 
-void autonomous() { 
+// the route, as actions the runner in autonomous() can overlap with each other
+tiger::Action route() {
     chassis.setPose(0, 0, 0);
     chassis.moveToPoint(0, 10, 999999);
+    co_await chassis.untilDone();
+}
+
+void autonomous() { 
+    tiger::ActionRunner().run(route()); // runs on this task until every action in the route is done
 }
 
 
 void opcontrol() {
-    // Piston state tracking
-    bool piston_state = false;
-    bool last_d_pressed = false;
-    bool last_x_pressed = false;
+    tiger::ControllerInput input(controller);
+    // each piston flips on its own button, with a state of its own
+    input.toggle(loaderPistonMechButton, pistonLoaderMech);
+    input.toggle(bazookaPistonMechButton, pistonBazookaMech);
 
+    tiger::PeriodicLoop loop(10, "opcontrol"); // starts an iteration every 10ms, however long the last one took
     while (true) {
+        input.update(); // sample the controller once for this iteration
 
-        int leftY = controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y);   
-        int rightX = controller.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X); 
+        int leftY = input.getAnalog(pros::E_CONTROLLER_ANALOG_LEFT_Y);   
+        int rightX = input.getAnalog(pros::E_CONTROLLER_ANALOG_RIGHT_X); 
 
         chassis.arcade(rightX, leftY);  
 
-        if (controller.get_digital(intakeToBackRollerButton)) {
+        if (input.isDown(intakeToBackRollerButton)) {
             roller1Motor.move_velocity(aux_speed);
             intakeMotorFront.move_velocity(-aux_speed);
             bazookaMotor.move_velocity(-aux_speed);
             roller2Motor.move_velocity(aux_speed);
             upperBackFlexWheelMotor.move_velocity(aux_speed);
         } 
-        else if (controller.get_digital(intakeToBazookaRollerButton)) {
+        else if (input.isDown(intakeToBazookaRollerButton)) {
             roller1Motor.move_velocity(aux_speed);
             intakeMotorFront.move_velocity(-aux_speed);
             bazookaMotor.move_velocity(-aux_speed);
             roller2Motor.move_velocity(-aux_speed);
         } 
-		else if (controller.get_digital(ejectButton)) {
+		else if (input.isDown(ejectButton)) {
             roller1Motor.move_velocity(-aux_speed);
             intakeMotorFront.move_velocity(aux_speed);
             bazookaMotor.move_velocity(aux_speed);
@@ -209,27 +251,7 @@ void opcontrol() {
             upperBackFlexWheelMotor.move_velocity(0);
         }
         
-        if (controller.get_digital(loaderPistonMechButton)) {
-            if (!last_d_pressed) {
-                piston_state = !piston_state;
-                pistonLoaderMech.set_value(piston_state);
-                last_d_pressed = true;
-            }
-        } else {
-            last_d_pressed = false;
-        }
-        
-        if (controller.get_digital(bazookaPistonMechButton)) {
-            if (!last_x_pressed) {
-                piston_state = !piston_state;
-                pistonBazookaMech.set_value(piston_state);
-                last_x_pressed = true;
-            }
-        } else {
-            last_x_pressed = false;
-        }
-        
-        // delay to save resources
-        pros::delay(10);
+        // sleep until the next iteration is due
+        loop.wait();
     }
 }
\ No newline at end of file
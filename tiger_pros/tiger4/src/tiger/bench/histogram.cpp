@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <cmath>
+#include "pros/rtos.hpp"
+#include "tiger/bench/bench.hpp"
+
+// width of the longest bar print() draws
+static constexpr int BAR_WIDTH = 40;
+
+uint64_t tiger::microsClock() { return pros::micros() * 1000; }
+
+int tiger::TimingHistogram::getBucket(uint64_t duration) {
+    if (duration < SUB_BUCKETS) return duration;
+    // the power of two, then the next 2 bits pick the bucket within it
+    const int exponent = 63 - __builtin_clzll(duration);
+    const int sub = (duration >> (exponent - 2)) & (SUB_BUCKETS - 1);
+    return (exponent - 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t tiger::TimingHistogram::getBucketStart(int bucket) {
+    if (bucket < SUB_BUCKETS) return bucket;
+    const int exponent = bucket / SUB_BUCKETS + 1;
+    return uint64_t(SUB_BUCKETS + bucket % SUB_BUCKETS) << (exponent - 2);
+}
+
+void tiger::TimingHistogram::add(uint64_t duration) {
+    buckets[getBucket(duration)]++;
+    count++;
+    total += duration;
+    if (duration < min) min = duration;
+    if (duration > max) max = duration;
+}
+
+void tiger::TimingHistogram::reset() { *this = TimingHistogram(); }
+
+uint64_t tiger::TimingHistogram::getPercentile(float fraction) const {
+    if (count == 0) return 0;
+    const uint32_t target = std::fmax(std::ceil(fraction * count), 1);
+    uint32_t seen = 0;
+    for (int bucket = 0; bucket < BUCKETS - 1; bucket++) {
+        seen += buckets[bucket];
+        if (seen >= target) return std::min(getBucketStart(bucket + 1) - 1, max);
+    }
+    return max;
+}
+
+void tiger::TimingHistogram::print(FILE* out) const {
+    if (count == 0) return;
+    const int first = getBucket(getMin());
+    const int last = getBucket(max);
+    uint32_t tallest = 0;
+    for (int bucket = first; bucket <= last; bucket++) tallest = std::max(tallest, buckets[bucket]);
+    for (int bucket = first; bucket <= last; bucket++) {
+        // a long tail is mostly empty buckets, so only show where a gap starts
+        if (buckets[bucket] == 0) {
+            if (buckets[bucket - 1] != 0) std::fprintf(out, "  %10s    |\n", "...");
+            continue;
+        }
+        const int width = (uint64_t(buckets[bucket]) * BAR_WIDTH + tallest - 1) / tallest;
+        std::fprintf(out, "  %10llu ns |%-*.*s %lu\n", (unsigned long long)getBucketStart(bucket), BAR_WIDTH, width,
+                     "########################################", (unsigned long)buckets[bucket]);
+    }
+}
+
+void tiger::printBenchHeader(FILE* out) {
+    std::fprintf(out, "%-24s %8s %8s %8s %8s %8s %10s\n", "ns per call", "min", "p50", "p90", "p99", "max", "mean");
+}
+
+void tiger::printBenchResult(FILE* out, const char* name, const TimingHistogram& histogram, bool printHistogram) {
+    std::fprintf(out, "%-24s %8llu %8llu %8llu %8llu %8llu %10.1f\n", name, (unsigned long long)histogram.getMin(),
+                 (unsigned long long)histogram.getPercentile(0.5), (unsigned long long)histogram.getPercentile(0.9),
+                 (unsigned long long)histogram.getPercentile(0.99), (unsigned long long)histogram.getMax(),
+                 histogram.getMean());
+    if (printHistogram) histogram.print(out);
+}
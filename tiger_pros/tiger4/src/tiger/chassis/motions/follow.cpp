@@ -0,0 +1,108 @@
+#include <cmath>
+#include <algorithm>
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "tiger/log/level.hpp"
+#include "tiger/chassis/chassis.hpp"
+#include "tiger/motion/path.hpp"
+#include "tiger/motion/pursuit.hpp"
+
+void tiger::Chassis::follow(const asset& path, float lookahead, int timeout, bool forwards, bool async) {
+    // text paths are parsed by LemLib
+    if (!PathView::isBinary(path)) {
+        lemlib::Chassis::follow(path, lookahead, timeout, forwards, async);
+        return;
+    }
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([=, this, &path]() { follow(path, lookahead, timeout, forwards, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    const PathView pathPoints(path);
+    if (!pathPoints.isValid()) {
+        TIGER_WARN(lemlib::infoSink(), "Binary path is corrupt, not following it");
+        this->endMotion();
+        return;
+    }
+
+    // searches the path incrementally instead of from the start every cycle
+    PathCursor cursor(pathPoints, lookahead);
+    lemlib::Pose pose = getPose(true, true);
+    lemlib::Pose lastPose = pose;
+    distTraveled = 0;
+    lemlib::Timer timer(timeout);
+    lateralSettle.reset();
+    settleState = SettleState::MOVING;
+    // loop until the robot is within the end tolerance
+    while (!timer.isDone() && this->motionRunning) {
+        // get the current position
+        pose = getPose(true, true);
+        if (!forwards) pose.theta -= M_PI;
+
+        // update completion vars
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        // find the closest point on the path to the robot
+        const size_t closestPoint = cursor.findClosest(pose);
+        const PathPoint closest = pathPoints[closestPoint];
+        // if the robot is at the end of the path, then stop
+        if (closest.velocity == 0) break;
+
+        // find the lookahead point
+        const lemlib::Pose lookaheadPose = cursor.findLookahead(pose);
+
+        // get the curvature of the arc between the robot and the lookahead point
+        const float curvature = lemlib::getCurvature(pose, lookaheadPose);
+
+        // get the target velocity of the robot. The curvature of the path is known ahead of time, so slow down
+        // for tight corners before the robot slips
+        float targetVel = closest.velocity;
+        if (drivetrain.horizontalDrift != 0 && closest.curvature != 0)
+            targetVel = std::fmin(targetVel, std::sqrt(drivetrain.horizontalDrift / std::fabs(closest.curvature) * 9.8));
+
+        // calculate target left and right velocities
+        float targetLeftVel = targetVel * (2 + curvature * drivetrain.trackWidth) / 2;
+        float targetRightVel = targetVel * (2 - curvature * drivetrain.trackWidth) / 2;
+
+        // ratio the speeds to respect the max speed
+        const float ratio = std::max(std::fabs(targetLeftVel), std::fabs(targetRightVel)) / 127;
+        if (ratio > 1) {
+            targetLeftVel /= ratio;
+            targetRightVel /= ratio;
+        }
+
+        // the path ends where it ends, but give up if the robot can't get there
+        if (settleEnabled && lateralSettle.update(INFINITY, getLocalSpeed().y, targetVel) == SettleState::STALLED) {
+            settleState = SettleState::STALLED;
+            TIGER_WARN(lemlib::infoSink(), "Path following stalled, aborting");
+            break;
+        }
+
+        // move the drivetrain
+        if (forwards) {
+            drivetrain.leftMotors->move(targetLeftVel);
+            drivetrain.rightMotors->move(targetRightVel);
+        } else {
+            drivetrain.leftMotors->move(-targetRightVel);
+            drivetrain.rightMotors->move(-targetLeftVel);
+        }
+
+        // delay to save resources
+        pros::delay(10);
+    }
+
+    // stop the robot
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    this->endMotion();
+}
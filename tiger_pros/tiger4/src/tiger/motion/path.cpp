@@ -0,0 +1,54 @@
+#include <cstring>
+#include "tiger/motion/path.hpp"
+
+// the FNV-1a parameters for 32 bit hashes
+static constexpr uint32_t FNV_OFFSET = 2166136261u;
+static constexpr uint32_t FNV_PRIME = 16777619u;
+
+tiger::PathView::PathView(const asset& path) {
+    if (!isBinary(path)) return;
+    // the asset isn't guaranteed to be aligned, so copy the header out instead of casting the buffer
+    PathHeader header;
+    std::memcpy(&header, path.buf, sizeof(PathHeader));
+    if (header.pointSize < sizeof(PathPoint)) return;
+    if (header.count == 0 || (path.size - sizeof(PathHeader)) / header.pointSize < header.count) return;
+    points = path.buf + sizeof(PathHeader);
+    count = header.count;
+    stride = header.pointSize;
+    checksum = header.checksum;
+}
+
+bool tiger::PathView::verify() const {
+    if (!isValid()) return false;
+    uint32_t hash = FNV_OFFSET;
+    for (size_t i = 0; i < count * stride; i++) {
+        hash ^= points[i];
+        hash *= FNV_PRIME;
+    }
+    return hash == checksum;
+}
+
+tiger::PathPoint tiger::PathView::operator[](size_t index) const {
+    // copying is what makes unaligned reads safe, and compiles down to plain loads
+    PathPoint point;
+    std::memcpy(&point, points + index * stride, sizeof(PathPoint));
+    return point;
+}
+
+lemlib::Pose tiger::PathView::getPose(size_t index) const {
+    const PathPoint point = (*this)[index];
+    return lemlib::Pose(point.x, point.y, point.velocity);
+}
+
+float tiger::PathView::getArcLength(size_t index) const {
+    PathPointExtra extra;
+    std::memcpy(&extra, points + index * stride + sizeof(PathPoint), sizeof(PathPointExtra));
+    return extra.arcLength;
+}
+
+bool tiger::PathView::isBinary(const asset& path) {
+    if (path.buf == nullptr || path.size < sizeof(PathHeader)) return false;
+    PathHeader header;
+    std::memcpy(&header, path.buf, sizeof(PathHeader));
+    return header.magic == PATH_MAGIC && header.version == PATH_VERSION;
+}
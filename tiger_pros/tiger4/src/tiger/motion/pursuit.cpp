@@ -0,0 +1,125 @@
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include "tiger/motion/pursuit.hpp"
+
+size_t tiger::findClosest(lemlib::Pose pose, const PathView& path) {
+    size_t closestPoint = 0;
+    float closestDist = std::numeric_limits<float>::infinity();
+    // loop through all path points
+    for (size_t i = 0; i < path.size(); i++) {
+        const float dist = pose.distance(path.getPose(i));
+        if (dist < closestDist) { // new closest point
+            closestDist = dist;
+            closestPoint = i;
+        }
+    }
+    return closestPoint;
+}
+
+float tiger::circleIntersect(lemlib::Pose p1, lemlib::Pose p2, lemlib::Pose pose, float lookaheadDist) {
+    const lemlib::Pose d = p2 - p1;
+    const lemlib::Pose f = p1 - pose;
+    const float a = d * d;
+    const float b = 2 * (f * d);
+    const float c = (f * f) - lookaheadDist * lookaheadDist;
+    float discriminant = b * b - 4 * a * c;
+    // if a possible intersection was found
+    if (discriminant >= 0 && a != 0) {
+        discriminant = std::sqrt(discriminant);
+        const float t1 = (-b - discriminant) / (2 * a);
+        const float t2 = (-b + discriminant) / (2 * a);
+        // prioritize further down the path
+        if (t2 >= 0 && t2 <= 1) return t2;
+        else if (t1 >= 0 && t1 <= 1) return t1;
+    }
+    // no intersection found
+    return -1;
+}
+
+lemlib::Pose tiger::findLookahead(lemlib::Pose lastLookahead, lemlib::Pose pose, const PathView& path,
+                                  size_t closest, float lookaheadDist) {
+    // only consider intersections past the closest point and the last lookahead point
+    const size_t start = std::max(closest, size_t(lastLookahead.theta));
+    for (size_t i = start; i + 1 < path.size(); i++) {
+        const lemlib::Pose lastPathPose = path.getPose(i);
+        const lemlib::Pose currentPathPose = path.getPose(i + 1);
+        const float t = circleIntersect(lastPathPose, currentPathPose, pose, lookaheadDist);
+        if (t != -1) {
+            lemlib::Pose lookahead = lastPathPose.lerp(currentPathPose, t);
+            lookahead.theta = i;
+            return lookahead;
+        }
+    }
+    // robot deviated from path, use last lookahead point
+    return lastLookahead;
+}
+
+tiger::PathCursor::PathCursor(const PathView& path, float lookahead)
+    : path(path),
+      lookahead(lookahead),
+      // the robot moves well under a lookahead distance per cycle
+      closestWindow(lookahead),
+      // the lookahead point is a lookahead distance from the robot, which is close to the closest point
+      lookaheadWindow(2 * lookahead) {}
+
+void tiger::PathCursor::reset() {
+    started = false;
+    closest = 0;
+}
+
+float tiger::PathCursor::getTravel(size_t index, float previous) const {
+    if (index == closest) return 0;
+    if (path.hasArcLength()) return path.getArcLength(index) - path.getArcLength(closest);
+    return previous + path.getPose(index - 1).distance(path.getPose(index));
+}
+
+size_t tiger::PathCursor::findClosest(lemlib::Pose pose) {
+    // the robot could start anywhere, so the first search has to check the whole path
+    if (!started) {
+        started = true;
+        closest = tiger::findClosest(pose, path);
+        lastLookahead = path.getPose(0);
+        lastLookahead.theta = 0;
+        return closest;
+    }
+
+    // only search forwards, and only as far as the robot could have gone since the last cycle
+    size_t closestPoint = closest;
+    float closestDist = pose.distance(path.getPose(closest));
+    float travel = 0;
+    for (size_t i = closest + 1; i < path.size(); i++) {
+        travel = getTravel(i, travel);
+        // always check the next point, in case points are further apart than the window
+        if (travel > closestWindow && i > closest + 1) break;
+        const float dist = pose.distance(path.getPose(i));
+        if (dist < closestDist) { // new closest point
+            closestDist = dist;
+            closestPoint = i;
+        }
+    }
+    closest = closestPoint;
+    return closest;
+}
+
+lemlib::Pose tiger::PathCursor::findLookahead(lemlib::Pose pose) {
+    // only consider intersections past the closest point and the last lookahead point
+    const size_t start = std::max(closest, size_t(lastLookahead.theta));
+    float travel = 0;
+    for (size_t i = closest + 1; i <= start; i++) travel = getTravel(i, travel);
+    for (size_t i = start; i + 1 < path.size(); i++) {
+        if (i > start) travel = getTravel(i, travel);
+        // an intersection further along the path than this means the path loops back towards the robot
+        if (travel > lookaheadWindow) break;
+        const lemlib::Pose lastPathPose = path.getPose(i);
+        const lemlib::Pose currentPathPose = path.getPose(i + 1);
+        const float t = circleIntersect(lastPathPose, currentPathPose, pose, lookahead);
+        if (t != -1) {
+            lastLookahead = lastPathPose.lerp(currentPathPose, t);
+            lastLookahead.theta = i;
+            return lastLookahead;
+        }
+    }
+    // robot deviated from path, use last lookahead point
+    return lastLookahead;
+}
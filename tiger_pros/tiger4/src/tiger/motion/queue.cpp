@@ -0,0 +1,219 @@
+#include <cmath>
+#include "lemlib/util.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "tiger/log/level.hpp"
+#include "tiger/motion/queue.hpp"
+#include "tiger/motion/path.hpp"
+#include "tiger/chassis/chassis.hpp"
+
+tiger::MotionQueue::MotionQueue(Chassis& chassis, QueueSettings settings)
+    : chassis(chassis),
+      settings(settings) {}
+
+bool tiger::MotionQueue::moveToPoint(float x, float y, int timeout, lemlib::MoveToPointParams params) {
+    return push(MoveToPoint {x, y, timeout, params});
+}
+
+bool tiger::MotionQueue::moveToPose(float x, float y, float theta, int timeout, lemlib::MoveToPoseParams params) {
+    return push(MoveToPose {x, y, theta, timeout, params});
+}
+
+bool tiger::MotionQueue::turnToHeading(float theta, int timeout, lemlib::TurnToHeadingParams params) {
+    return push(TurnToHeading {theta, timeout, params});
+}
+
+bool tiger::MotionQueue::turnToPoint(float x, float y, int timeout, lemlib::TurnToPointParams params) {
+    return push(TurnToPoint {x, y, timeout, params});
+}
+
+bool tiger::MotionQueue::follow(const asset& path, float lookahead, int timeout, bool forwards) {
+    return push(Follow {&path, lookahead, timeout, forwards});
+}
+
+bool tiger::MotionQueue::push(const Motion& motion) {
+    mutex.take();
+    if (count == CAPACITY) {
+        mutex.give();
+        TIGER_WARN(lemlib::infoSink(), "Motion queue is full, dropping motion");
+        return false;
+    }
+    motions[(head + count) % CAPACITY] = motion;
+    count++;
+    if (task == nullptr) task = new pros::Task([this] { loop(); }, settings.priority, TASK_STACK_DEPTH_DEFAULT,
+                                               "motion queue");
+    mutex.give();
+    task->notify();
+    return true;
+}
+
+void tiger::MotionQueue::clear() {
+    mutex.take();
+    count = 0;
+    generation++;
+    mutex.give();
+    // the queue task may have taken a motion off the queue without having started it, and cancelling before it starts
+    // does nothing. So keep cancelling until the task is idle or running a motion queued after this
+    while (true) {
+        chassis.cancelMotion();
+        mutex.take();
+        const bool done = !running || runningGeneration == generation;
+        mutex.give();
+        if (done) break;
+    }
+}
+
+void tiger::MotionQueue::waitUntilDone() {
+    // delay to save resources
+    while (isBusy()) pros::delay(10);
+}
+
+bool tiger::MotionQueue::isBusy() {
+    mutex.take();
+    const bool busy = running || count > 0;
+    mutex.give();
+    return busy;
+}
+
+size_t tiger::MotionQueue::size() {
+    mutex.take();
+    const size_t size = count;
+    mutex.give();
+    return size;
+}
+
+void tiger::MotionQueue::loop() {
+    while (true) {
+        mutex.take();
+        if (count == 0) {
+            running = false;
+            mutex.give();
+            // sleep until something is queued
+            pros::Task::notify_take(true, TIMEOUT_MAX);
+            continue;
+        }
+        Motion motion = motions[head];
+        head = (head + 1) % CAPACITY;
+        count--;
+        running = true;
+        runningGeneration = generation;
+        if (count > 0) blend(motion, motions[head], chassis.getPose(true, true));
+        mutex.give();
+        run(motion);
+    }
+}
+
+void tiger::MotionQueue::blend(Motion& motion, const Motion& next, lemlib::Pose pose) const {
+    // a motion that drives forwards can't carry its speed into one that drives backwards
+    if (getDirection(motion) * getDirection(next) < 0) return;
+    // and a move can't hand over to a turn in place, which would start with the robot still driving
+    if (getDirection(motion) != 0 && getDirection(next) == 0) return;
+    const std::optional<lemlib::Pose> end = getEnd(motion, pose);
+    if (!end) return;
+    // and a turn still spinning one way can't hand over to a turn that has to rotate back the other way
+    if (getDirection(motion) == 0 && getDirection(next) == 0) {
+        const std::optional<float> rotation = getRotation(motion, pose);
+        const std::optional<float> nextRotation = getRotation(next, *end);
+        if (!rotation || !nextRotation || *rotation * *nextRotation <= 0) return;
+    }
+    const std::optional<float> nextHeading = getStartHeading(next, *end);
+    if (!nextHeading) return;
+    // the sharper the corner, the slower it's taken
+    const float corner = std::fabs(lemlib::angleError(*nextHeading, end->theta));
+    if (corner > lemlib::degToRad(settings.maxBlendAngle)) return;
+    const float scale = std::cos(corner);
+
+    if (auto* move = std::get_if<MoveToPoint>(&motion)) {
+        if (move->params.minSpeed != 0 || move->params.earlyExitRange != 0) return;
+        move->params.minSpeed = settings.moveSpeed * scale;
+        move->params.earlyExitRange = settings.moveRange;
+    } else if (auto* move = std::get_if<MoveToPose>(&motion)) {
+        if (move->params.minSpeed != 0 || move->params.earlyExitRange != 0) return;
+        move->params.minSpeed = settings.moveSpeed * scale;
+        move->params.earlyExitRange = settings.moveRange;
+    } else if (auto* turn = std::get_if<TurnToHeading>(&motion)) {
+        if (turn->params.minSpeed != 0 || turn->params.earlyExitRange != 0) return;
+        turn->params.minSpeed = settings.turnSpeed * scale;
+        turn->params.earlyExitRange = settings.turnRange;
+    } else if (auto* turn = std::get_if<TurnToPoint>(&motion)) {
+        if (turn->params.minSpeed != 0 || turn->params.earlyExitRange != 0) return;
+        turn->params.minSpeed = settings.turnSpeed * scale;
+        turn->params.earlyExitRange = settings.turnRange;
+    }
+}
+
+std::optional<lemlib::Pose> tiger::MotionQueue::getEnd(const Motion& motion, lemlib::Pose start) {
+    if (auto* move = std::get_if<MoveToPoint>(&motion)) {
+        const lemlib::Pose target(move->x, move->y);
+        const float heading = start.angle(target);
+        return lemlib::Pose(move->x, move->y, move->params.forwards ? heading : heading + M_PI);
+    } else if (auto* move = std::get_if<MoveToPose>(&motion)) {
+        return lemlib::Pose(move->x, move->y, M_PI_2 - lemlib::degToRad(move->theta));
+    } else if (auto* turn = std::get_if<TurnToHeading>(&motion)) {
+        return lemlib::Pose(start.x, start.y, M_PI_2 - lemlib::degToRad(turn->theta));
+    } else if (auto* turn = std::get_if<TurnToPoint>(&motion)) {
+        const float heading = start.angle(lemlib::Pose(turn->x, turn->y));
+        return lemlib::Pose(start.x, start.y, turn->params.forwards ? heading : heading + M_PI);
+    } else if (auto* path = std::get_if<Follow>(&motion)) {
+        // where a text path ends is only known once LemLib has parsed it, binary paths can be read directly
+        const PathView points(*path->path);
+        if (points.size() < 2) return std::nullopt;
+        const lemlib::Pose last = points.getPose(points.size() - 1);
+        const float heading = points.getPose(points.size() - 2).angle(last);
+        return lemlib::Pose(last.x, last.y, path->forwards ? heading : heading + M_PI);
+    }
+    return std::nullopt;
+}
+
+std::optional<float> tiger::MotionQueue::getStartHeading(const Motion& motion, lemlib::Pose start) {
+    if (auto* move = std::get_if<MoveToPoint>(&motion)) {
+        const float heading = start.angle(lemlib::Pose(move->x, move->y));
+        return move->params.forwards ? heading : heading + M_PI;
+    } else if (auto* move = std::get_if<MoveToPose>(&motion)) {
+        // the robot first drives towards the carrot point
+        lemlib::Pose target(move->x, move->y, M_PI_2 - lemlib::degToRad(move->theta));
+        if (!move->params.forwards) target.theta += M_PI;
+        const lemlib::Pose carrot = target - lemlib::Pose(std::cos(target.theta), std::sin(target.theta)) *
+                                                 move->params.lead * start.distance(target);
+        const float heading = start.angle(carrot);
+        return move->params.forwards ? heading : heading + M_PI;
+    } else if (auto* path = std::get_if<Follow>(&motion)) {
+        const PathView points(*path->path);
+        if (points.size() < 2) return std::nullopt;
+        const float heading = points.getPose(0).angle(points.getPose(1));
+        return path->forwards ? heading : heading + M_PI;
+    }
+    // a turn starts towards where it ends
+    return getEnd(motion, start)->theta;
+}
+
+std::optional<float> tiger::MotionQueue::getRotation(const Motion& motion, lemlib::Pose start) {
+    // LemLib turns in compass headings, which are clockwise positive
+    const float heading = M_PI_2 - start.theta;
+    if (auto* turn = std::get_if<TurnToHeading>(&motion)) {
+        return lemlib::angleError(lemlib::degToRad(turn->theta), heading, true, turn->params.direction);
+    } else if (auto* turn = std::get_if<TurnToPoint>(&motion)) {
+        return lemlib::angleError(M_PI_2 - getEnd(motion, start)->theta, heading, true, turn->params.direction);
+    }
+    return std::nullopt;
+}
+
+int tiger::MotionQueue::getDirection(const Motion& motion) {
+    if (auto* move = std::get_if<MoveToPoint>(&motion)) return move->params.forwards ? 1 : -1;
+    if (auto* move = std::get_if<MoveToPose>(&motion)) return move->params.forwards ? 1 : -1;
+    if (auto* path = std::get_if<Follow>(&motion)) return path->forwards ? 1 : -1;
+    return 0;
+}
+
+void tiger::MotionQueue::run(const Motion& motion) {
+    if (auto* move = std::get_if<MoveToPoint>(&motion)) {
+        chassis.moveToPoint(move->x, move->y, move->timeout, move->params, false);
+    } else if (auto* move = std::get_if<MoveToPose>(&motion)) {
+        chassis.moveToPose(move->x, move->y, move->theta, move->timeout, move->params, false);
+    } else if (auto* turn = std::get_if<TurnToHeading>(&motion)) {
+        chassis.turnToHeading(turn->theta, turn->timeout, turn->params, false);
+    } else if (auto* turn = std::get_if<TurnToPoint>(&motion)) {
+        chassis.turnToPoint(turn->x, turn->y, turn->timeout, turn->params, false);
+    } else if (auto* path = std::get_if<Follow>(&motion)) {
+        chassis.follow(*path->path, path->lookahead, path->timeout, path->forwards, false);
+    }
+}
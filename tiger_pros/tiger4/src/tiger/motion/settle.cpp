@@ -0,0 +1,43 @@
+#include <cmath>
+#include "pros/rtos.hpp"
+#include "tiger/motion/settle.hpp"
+
+tiger::SettleDetector::SettleDetector(SettleSettings settings)
+    : settings(settings) {}
+
+tiger::SettleState tiger::SettleDetector::update(float error, float velocity, float power) {
+    if (state == SettleState::STALLED) return state;
+    const uint32_t now = pros::millis();
+    // how fast the error changes. Before there are two samples, or without a target, only the speed counts
+    float errorRate = 0;
+    if (!first && now > prevTime && std::isfinite(error)) errorRate = (error - prevError) * 1000 / (now - prevTime);
+    first = false;
+    prevError = error;
+    prevTime = now;
+
+    const bool stopped = std::fabs(velocity) <= settings.velocity;
+    const bool close = std::fabs(error) <= settings.tolerance;
+
+    if (close && stopped && std::fabs(errorRate) <= settings.velocity) {
+        if (settledSince < 0) settledSince = now;
+        if (now - settledSince >= settings.settleTime) state = SettleState::SETTLED;
+    } else {
+        settledSince = -1;
+        state = SettleState::MOVING;
+    }
+
+    if (!close && stopped && settings.stallPower > 0 && std::fabs(power) >= settings.stallPower) {
+        if (stalledSince < 0) stalledSince = now;
+        if (now - stalledSince >= settings.stallTime) state = SettleState::STALLED;
+    } else {
+        stalledSince = -1;
+    }
+    return state;
+}
+
+void tiger::SettleDetector::reset() {
+    state = SettleState::MOVING;
+    first = true;
+    settledSince = -1;
+    stalledSince = -1;
+}
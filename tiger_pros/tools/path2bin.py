@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""Convert a jerryio path (LemLib text format) into a binary path for tiger::PathView.
+
+usage: path2bin.py [--no-arc-length] input.txt output.path
+
+The output goes in a project's static/ folder, where it is embedded like any other asset:
+static/skills.path becomes ASSET(skills_path). Each project's "make paths" target runs this
+for every file in paths/.
+
+Format, little endian:
+    header: uint32 magic "TPTH", uint16 version, uint16 point size, uint32 count, uint32 FNV-1a of the points
+    points: float x, float y, float velocity, float curvature, float arc length
+The arc length lets tiger::PathCursor bound its searches without measuring segments; leave it out with
+--no-arc-length to save 4 bytes per point.
+"""
+
+import math
+import struct
+import sys
+
+MAGIC = 0x48545054
+VERSION = 1
+HEADER = struct.Struct("<IHHII")
+POINT = struct.Struct("<ffff")
+ARC_LENGTH = struct.Struct("<f")
+
+
+def read_points(text):
+    """Read the x, y, speed lines that come before endData."""
+    points = []
+    for line in text.splitlines():
+        line = line.strip()
+        if line == "endData":
+            break
+        if not line:
+            continue
+        x, y, velocity = (float(value) for value in line.split(",")[:3])
+        points.append((x, y, velocity))
+    return points
+
+
+def curvature(a, b, c):
+    """Curvature of the circle through three points. Positive curves to the right, like LemLib."""
+    cross = (b[0] - a[0]) * (c[1] - b[1]) - (b[1] - a[1]) * (c[0] - b[0])
+    lengths = math.dist(a[:2], b[:2]) * math.dist(b[:2], c[:2]) * math.dist(a[:2], c[:2])
+    if lengths == 0:
+        return 0.0
+    return -2 * cross / lengths
+
+
+def fnv1a(data):
+    value = 2166136261
+    for byte in data:
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def convert(points, arc_length=True):
+    data = bytearray()
+    distance = 0.0
+    for i, (x, y, velocity) in enumerate(points):
+        k = 0.0
+        if 0 < i < len(points) - 1:
+            k = curvature(points[i - 1], points[i], points[i + 1])
+        if i > 0:
+            distance += math.dist(points[i - 1][:2], (x, y))
+        data += POINT.pack(x, y, velocity, k)
+        if arc_length:
+            data += ARC_LENGTH.pack(distance)
+    point_size = POINT.size + (ARC_LENGTH.size if arc_length else 0)
+    return HEADER.pack(MAGIC, VERSION, point_size, len(points), fnv1a(data)) + data
+
+
+def main():
+    args = sys.argv[1:]
+    arc_length = "--no-arc-length" not in args
+    args = [arg for arg in args if arg != "--no-arc-length"]
+    if len(args) != 2:
+        sys.exit(__doc__)
+    with open(args[0]) as file:
+        points = read_points(file.read())
+    if not points:
+        sys.exit(f"{args[0]}: no points found")
+    with open(args[1], "wb") as file:
+        file.write(convert(points, arc_length))
+    print(f"{args[0]} -> {args[1]}: {len(points)} points")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""Convert a tiger::Recorder recording from the brain's SD card to a CSV file.
+
+usage: recording2csv.py input.rec [output.csv]
+
+The CSV file has a time_ms column followed by one column per recorded value, a row per sample. It goes next to the
+recording, with .csv instead of .rec, unless output.csv is given. A block cut short by the robot turning off is
+skipped, and so is the rest of the file after it. Samples the brain dropped are reported, not filled in.
+
+Recording, all little endian:
+    header, padded to header_size bytes:
+        "TREC", uint16 version, uint16 columns, uint32 rows per block, uint32 period in milliseconds,
+        uint32 header_size, uint32 block_size, then the comma separated column names ending with a zero byte
+    blocks, block_size bytes each:
+        "TBLK", uint32 sequence number, uint32 rows, uint32 samples dropped since recording started,
+        uint32 milliseconds for each row, then float values of each column for each row
+"""
+
+import csv
+import struct
+import sys
+
+HEADER = struct.Struct("<4sHHIIII")
+BLOCK = struct.Struct("<4sIII")
+
+
+def convert(source, destination):
+    with open(source, "rb") as recording:
+        data = recording.read()
+    if len(data) < HEADER.size:
+        sys.exit(f"{source} is too short to be a recording")
+    magic, version, columns, block_rows, period, header_size, block_size = HEADER.unpack_from(data)
+    if magic != b"TREC" or version != 1:
+        sys.exit(f"{source} isn't a recording this tool can read")
+    names = data[HEADER.size : header_size].split(b"\0")[0].decode(errors="replace").split(",")
+    if names == [""]:
+        names = []
+    times = struct.Struct(f"<{block_rows}I")
+    values = struct.Struct(f"<{block_rows * columns}f")
+
+    rows = 0
+    blocks = 0
+    dropped = 0
+    with open(destination, "w", newline="") as output:
+        writer = csv.writer(output)
+        writer.writerow(["time_ms"] + names)
+        for offset in range(header_size, len(data) - block_size + 1, block_size):
+            magic, sequence, count, dropped_so_far = BLOCK.unpack_from(data, offset)
+            if magic != b"TBLK" or sequence != blocks or count > block_rows:
+                print(f"block {blocks} is corrupt, stopping there")
+                break
+            time = times.unpack_from(data, offset + BLOCK.size)
+            value = values.unpack_from(data, offset + BLOCK.size + times.size)
+            # stored a column at a time
+            for row in range(count):
+                writer.writerow([time[row]] + [f"{value[column * block_rows + row]:.6g}" for column in range(columns)])
+            rows += count
+            blocks += 1
+            dropped = dropped_so_far
+    print(f"{destination}: {rows} rows of {columns} columns, every {period} ms")
+    if dropped:
+        print(f"the brain dropped {dropped} samples, the SD card fell behind")
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        sys.exit(__doc__)
+    source = sys.argv[1]
+    destination = sys.argv[2] if len(sys.argv) == 3 else source.rsplit(".", 1)[0] + ".csv"
+    convert(source, destination)
+
+
+if __name__ == "__main__":
+    main()
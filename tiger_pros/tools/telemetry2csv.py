@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""Decode tiger::Telemetry frames into a CSV file per channel.
+
+usage: telemetry2csv.py input output_prefix
+
+input is a recording of the serial port, a serial device like /dev/ttyACM1 in raw mode (stty -F /dev/ttyACM1 raw),
+which is read until Ctrl-C, or - for stdin.
+Channel "pose" goes to output_prefix_pose.csv, with a time_ms column followed by one column per field. Array fields
+are numbered: velocity0, velocity1, ...
+
+Frames are COBS encoded packets between zero bytes. Anything else on the port, like text from printf, is skipped,
+and so are packets whose CRC-8 doesn't match. Data for a channel whose schema hasn't been seen yet is skipped too;
+the brain repeats the schemas every second.
+
+Packet:
+    uint8 type (0 schema, 1 data), uint8 channel
+    schema: name, Python struct format, comma separated field names, each ending with a zero byte
+    data: uint32 milliseconds since the program started, then the values, little endian
+    uint8 CRC-8 (polynomial 0x07) of everything before it
+"""
+
+import csv
+import re
+import struct
+import sys
+
+SCHEMA = 0
+DATA = 1
+TIME = struct.Struct("<I")
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def cobs_decode(frame):
+    """Decode a COBS frame without its zero bytes. None if it's malformed."""
+    packet = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame):
+            return None
+        packet += frame[i + 1 : i + code]
+        i += code
+        if code != 0xFF and i < len(frame):
+            packet.append(0)
+    return bytes(packet)
+
+
+def frames(stream):
+    """Yield the bytes between zero bytes."""
+    pending = bytearray()
+    while True:
+        chunk = stream.read1(4096) if hasattr(stream, "read1") else stream.read(4096)
+        if not chunk:
+            break
+        pending += chunk
+        *complete, rest = pending.split(b"\0")
+        pending = bytearray(rest)
+        for frame in complete:
+            if frame:
+                yield bytes(frame)
+
+
+class Channel:
+    def __init__(self, name, fmt, fields):
+        self.name = name
+        self.struct = struct.Struct("<" + fmt)
+        self.columns = []
+        tokens = re.findall(r"(\d*)(\D)", fmt)
+        for i, (count, _) in enumerate(tokens):
+            field = fields[i] if i < len(fields) else f"field{i}"
+            count = int(count or 1)
+            self.columns += [field] if count == 1 else [f"{field}{j}" for j in range(count)]
+        self.writer = None
+        self.file = None
+        self.rows = 0
+
+
+def decode(stream, prefix):
+    channels = {}
+    bad = 0
+    try:
+        bad = read_frames(stream, prefix, channels)
+    except KeyboardInterrupt:
+        pass
+    for channel in channels.values():
+        channel.file.close()
+        print(f"{prefix}_{channel.name}.csv: {channel.rows} rows")
+    if bad:
+        print(f"skipped {bad} frames that weren't telemetry")
+
+
+def read_frames(stream, prefix, channels):
+    """Write every data frame to its channel's CSV file. Returns how many frames were skipped."""
+    bad = 0
+    for frame in frames(stream):
+        packet = cobs_decode(frame)
+        if packet is None or len(packet) < 3 or crc8(packet[:-1]) != packet[-1]:
+            bad += 1
+            continue
+        kind, number, body = packet[0], packet[1], packet[2:-1]
+        if kind == SCHEMA:
+            parts = body.split(b"\0")
+            if len(parts) < 3:
+                bad += 1
+                continue
+            name, fmt, fields = (part.decode(errors="replace") for part in parts[:3])
+            old = channels.get(number)
+            if old is not None and (old.name, old.struct.format) == (name, "<" + fmt):
+                continue
+            channel = Channel(name, fmt, fields.split(",") if fields else [])
+            channel.file = open(f"{prefix}_{name}.csv", "w", newline="")
+            channel.writer = csv.writer(channel.file)
+            channel.writer.writerow(["time_ms"] + channel.columns)
+            channels[number] = channel
+        elif kind == DATA:
+            channel = channels.get(number)
+            if channel is None or len(body) != TIME.size + channel.struct.size:
+                continue
+            (time,) = TIME.unpack_from(body)
+            values = channel.struct.unpack_from(body, TIME.size)
+            channel.writer.writerow([time] + [f"{value:.6g}" if isinstance(value, float) else int(value)
+                                              for value in values])
+            channel.rows += 1
+    return bad
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    source, prefix = sys.argv[1:]
+    stream = sys.stdin.buffer if source == "-" else open(source, "rb", buffering=0)
+    decode(stream, prefix)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""Turn the trace tiger::Profiler prints into a file chrome://tracing and ui.perfetto.dev open.
+
+usage: trace2json.py input output.json
+
+input is a recording of the serial port, a serial device like /dev/ttyACM1 in raw mode (stty -F /dev/ttyACM1 raw),
+which is read until Ctrl-C, or - for stdin. The simulator's --profile file works too.
+
+Each event is a line starting with "@trace " followed by a Chrome trace event in JSON: an "X" event per iteration of
+a task's loop, with its start and duration in microseconds, and an "M" event naming each task's row. Anything else on
+the port, like log messages and telemetry, is skipped, and so are lines cut short or mangled on the way.
+"""
+
+import json
+import sys
+
+PREFIX = b"@trace "
+
+
+def lines(stream):
+    """Yield each line, without its newline."""
+    pending = bytearray()
+    while True:
+        chunk = stream.read1(4096) if hasattr(stream, "read1") else stream.read(4096)
+        if not chunk:
+            break
+        pending += chunk
+        *complete, rest = pending.split(b"\n")
+        pending = bytearray(rest)
+        yield from complete
+
+
+def read_events(stream, events):
+    """Add every event in the stream to events. Returns how many trace lines were skipped."""
+    bad = 0
+    for line in lines(stream):
+        start = line.find(PREFIX)
+        if start < 0:
+            continue
+        try:
+            events.append(json.loads(line[start + len(PREFIX) :].decode()))
+        except (UnicodeDecodeError, json.JSONDecodeError):
+            bad += 1
+    return bad
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    source, output = sys.argv[1:]
+    stream = sys.stdin.buffer if source == "-" else open(source, "rb", buffering=0)
+    events = []
+    bad = 0
+    try:
+        bad = read_events(stream, events)
+    except KeyboardInterrupt:
+        pass
+    with open(output, "w") as file:
+        json.dump({"traceEvents": events, "displayTimeUnit": "ms"}, file)
+    print(f"{output}: {len(events)} events")
+    if bad:
+        print(f"skipped {bad} trace lines that didn't decode")
+
+
+if __name__ == "__main__":
+    main()